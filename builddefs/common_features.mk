@@ -319,6 +319,7 @@ ifeq ($(strip $(RGBLIGHT_ENABLE)), yes)
     endif
 
     ifeq ($(strip $(RGBLIGHT_DRIVER)), WS2812)
+        OPT_DEFS += -DRGBLIGHT_WS2812
         WS2812_DRIVER_REQUIRED := yes
     endif
 
@@ -691,6 +692,7 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
         else
             QUANTUM_LIB_SRC += serial_protocol.c
             QUANTUM_LIB_SRC += serial_$(strip $(SERIAL_DRIVER)).c
+            QUANTUM_LIB_SRC += split_delta.c
         endif
     endif
     COMMON_VPATH += $(QUANTUM_PATH)/split_common
@@ -19,6 +19,150 @@
 
 #include "eeprom_driver.h"
 
+#ifdef EEPROM_WRITE_CACHE
+#    include <stdbool.h>
+#    include "timer.h"
+
+// Provide the public block accessors, backed by the driver's renamed ones.
+#    undef eeprom_read_block
+#    undef eeprom_write_block
+
+#    ifndef EEPROM_WRITE_CACHE_LINES
+#        define EEPROM_WRITE_CACHE_LINES 4
+#    endif
+#    ifndef EEPROM_WRITE_CACHE_LINE_SIZE
+#        define EEPROM_WRITE_CACHE_LINE_SIZE 16
+#    endif
+#    ifndef EEPROM_WRITE_CACHE_TIMEOUT
+#        define EEPROM_WRITE_CACHE_TIMEOUT 1000
+#    endif
+
+_Static_assert(EEPROM_WRITE_CACHE_LINE_SIZE <= 255, "EEPROM_WRITE_CACHE_LINE_SIZE must fit in a byte");
+
+/* Each line holds one contiguous dirty range. Writes overlapping or
+ * adjacent to a line are merged into it as long as the result fits, so
+ * bursts of small writes to neighbouring bytes (config structs, keymap
+ * entries) reach the driver as a single block write. All lines are
+ * written back once the oldest change is EEPROM_WRITE_CACHE_TIMEOUT ms
+ * old, or when eeprom_flush() is called.
+ */
+typedef struct {
+    uintptr_t addr;
+    uint8_t   len; // 0 when the line is unused
+    uint8_t   data[EEPROM_WRITE_CACHE_LINE_SIZE];
+} eeprom_cache_line_t;
+
+static eeprom_cache_line_t cache_lines[EEPROM_WRITE_CACHE_LINES];
+static uint8_t             cache_victim;
+static bool                cache_dirty;
+static uint16_t            cache_dirty_since;
+
+static void cache_write_back(eeprom_cache_line_t *line) {
+    if (line->len) {
+        eeprom_driver_write_block(line->data, (void *)line->addr, line->len);
+        line->len = 0;
+    }
+}
+
+void eeprom_flush(void) {
+    for (uint8_t i = 0; i < EEPROM_WRITE_CACHE_LINES; i++) {
+        cache_write_back(&cache_lines[i]);
+    }
+    cache_dirty = false;
+}
+
+void eeprom_cache_discard(void) {
+    for (uint8_t i = 0; i < EEPROM_WRITE_CACHE_LINES; i++) {
+        cache_lines[i].len = 0;
+    }
+    cache_dirty = false;
+}
+
+void eeprom_cache_task(void) {
+    if (cache_dirty && timer_elapsed(cache_dirty_since) >= EEPROM_WRITE_CACHE_TIMEOUT) {
+        eeprom_flush();
+    }
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    uintptr_t start = (uintptr_t)addr;
+    uintptr_t end   = start + len;
+
+    eeprom_driver_read_block(buf, addr, len);
+    for (uint8_t i = 0; i < EEPROM_WRITE_CACHE_LINES; i++) {
+        eeprom_cache_line_t *line = &cache_lines[i];
+        uintptr_t            from = line->addr > start ? line->addr : start;
+        uintptr_t            to   = line->addr + line->len < end ? line->addr + line->len : end;
+        if (line->len && from < to) {
+            memcpy((uint8_t *)buf + (from - start), &line->data[from - line->addr], to - from);
+        }
+    }
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    const uint8_t *src   = (const uint8_t *)buf;
+    uintptr_t      start = (uintptr_t)addr;
+    uintptr_t      end   = start + len;
+
+    if (len == 0) return;
+
+    // Keep every line overlapping the range coherent with the new data
+    bool merged = false;
+    for (uint8_t i = 0; i < EEPROM_WRITE_CACHE_LINES; i++) {
+        eeprom_cache_line_t *line = &cache_lines[i];
+        if (!line->len) continue;
+
+        uintptr_t line_end = line->addr + line->len;
+        uintptr_t from     = line->addr > start ? line->addr : start;
+        uintptr_t to       = line_end < end ? line_end : end;
+        if (from < to) {
+            memcpy(&line->data[from - line->addr], src + (from - start), to - from);
+        }
+
+        // Then grow the first line the range touches, if the union fits
+        uintptr_t lo = line->addr < start ? line->addr : start;
+        uintptr_t hi = line_end > end ? line_end : end;
+        if (!merged && start <= line_end && line->addr <= end && hi - lo <= EEPROM_WRITE_CACHE_LINE_SIZE) {
+            if (lo < line->addr) {
+                memmove(&line->data[line->addr - lo], line->data, line->len);
+                line->addr = lo;
+            }
+            memcpy(&line->data[start - lo], src, len);
+            line->len = hi - lo;
+            merged    = true;
+        }
+    }
+
+    if (!merged) {
+        if (len > EEPROM_WRITE_CACHE_LINE_SIZE) {
+            // Too large to stage, overlapping lines already hold the same data
+            eeprom_driver_write_block(buf, addr, len);
+            return;
+        }
+
+        eeprom_cache_line_t *line = NULL;
+        for (uint8_t i = 0; i < EEPROM_WRITE_CACHE_LINES && !line; i++) {
+            if (!cache_lines[i].len) {
+                line = &cache_lines[i];
+            }
+        }
+        if (!line) {
+            line         = &cache_lines[cache_victim];
+            cache_victim = (cache_victim + 1) % EEPROM_WRITE_CACHE_LINES;
+            cache_write_back(line);
+        }
+        line->addr = start;
+        line->len  = len;
+        memcpy(line->data, src, len);
+    }
+
+    if (!cache_dirty) {
+        cache_dirty       = true;
+        cache_dirty_since = timer_read();
+    }
+}
+#endif
+
 uint8_t eeprom_read_byte(const uint8_t *addr) {
     uint8_t ret = 0;
     eeprom_read_block(&ret, addr, 1);
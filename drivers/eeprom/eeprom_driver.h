@@ -20,3 +20,15 @@
 
 void eeprom_driver_init(void);
 void eeprom_driver_erase(void);
+
+#ifdef EEPROM_WRITE_CACHE
+/* With the write cache enabled, the block accessors implemented by the
+ * driver are renamed so that eeprom_driver.c can provide the public ones
+ * on top of them. Code including this header only to initialise or erase
+ * the driver is unaffected.
+ */
+void eeprom_driver_read_block(void *buf, const void *addr, size_t len);
+void eeprom_driver_write_block(const void *buf, void *addr, size_t len);
+#    define eeprom_read_block eeprom_driver_read_block
+#    define eeprom_write_block eeprom_driver_write_block
+#endif
@@ -14,6 +14,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <string.h>
 #if defined(EXTERNAL_EEPROM_WP_PIN)
@@ -33,18 +34,35 @@
     there is nothing to override during linkage.
 */
 
-#include "wait.h"
+#include "timer.h"
 #include "i2c_master.h"
-#include "eeprom.h"
+#include "eeprom_driver.h"
 #include "eeprom_i2c.h"
 
 // #define DEBUG_EEPROM_OUTPUT
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
-#    include "timer.h"
 #    include "debug.h"
 #endif // DEBUG_EEPROM_OUTPUT
 
+/*
+    The EEPROM ignores its I2C address while a write cycle is in progress.
+    Rather than waiting out EXTERNAL_EEPROM_WRITE_TIME after every page, the
+    next transaction is retried until it's acknowledged -- "ACK polling" as per
+    the datasheets -- so the MCU isn't blocked after the final page, and parts
+    which complete their write cycle early aren't waited on needlessly.
+*/
+#if EXTERNAL_EEPROM_WRITE_TIME > 0
+static bool     write_in_progress = false;
+static uint16_t write_start_time;
+#endif
+
+#if EXTERNAL_EEPROM_READ_AHEAD_SIZE > 0
+static uint8_t   read_ahead[EXTERNAL_EEPROM_READ_AHEAD_SIZE];
+static uintptr_t read_ahead_addr;
+static size_t    read_ahead_len = 0;
+#endif
+
 static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     uintptr_t p = (uintptr_t)addr;
     for (int i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE; ++i) {
@@ -53,6 +71,82 @@ static inline void fill_target_address(uint8_t *buffer, const void *addr) {
     }
 }
 
+static i2c_status_t eeprom_i2c_transmit(uintptr_t addr, const uint8_t *data, uint16_t length) {
+    i2c_status_t status;
+    while ((status = i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS(addr), data, length, 100)) != I2C_STATUS_SUCCESS) {
+#if EXTERNAL_EEPROM_WRITE_TIME > 0
+        if (write_in_progress && timer_elapsed(write_start_time) <= EXTERNAL_EEPROM_WRITE_TIME) {
+            continue;
+        }
+#endif
+        break;
+    }
+
+#if EXTERNAL_EEPROM_WRITE_TIME > 0
+    // Either the EEPROM acknowledged, or the write cycle should long since have finished
+    write_in_progress = false;
+#endif
+    return status;
+}
+
+static i2c_status_t eeprom_i2c_read(uintptr_t addr, uint8_t *buf, size_t len) {
+    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
+    fill_target_address(complete_packet, (const void *)addr);
+
+    i2c_status_t status = eeprom_i2c_transmit(addr, complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE);
+    if (status == I2C_STATUS_SUCCESS) {
+        status = i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS(addr), buf, len, 100);
+    }
+    return status;
+}
+
+#if EXTERNAL_EEPROM_READ_AHEAD_SIZE > 0
+/*
+    Serves small reads from the read-ahead buffer, refilling it from the
+    requested address onwards when they miss.
+*/
+static bool read_ahead_fetch(uint8_t *buf, uintptr_t addr, size_t len) {
+    if (read_ahead_len == 0 || addr < read_ahead_addr || addr + len > read_ahead_addr + read_ahead_len) {
+        // Don't run past the end of the EEPROM, or into the next I2C address when the memory location spills into it
+        uintptr_t limit = EXTERNAL_EEPROM_BYTE_COUNT;
+#    if EXTERNAL_EEPROM_ADDRESS_SIZE < 4
+        uintptr_t window = (addr | ((1UL << (8 * EXTERNAL_EEPROM_ADDRESS_SIZE)) - 1)) + 1;
+        if (window < limit) {
+            limit = window;
+        }
+#    endif
+        size_t fill = EXTERNAL_EEPROM_READ_AHEAD_SIZE;
+        if (addr + fill > limit) {
+            fill = limit - addr;
+        }
+        if (fill < len) {
+            return false;
+        }
+
+        read_ahead_len = 0;
+        if (eeprom_i2c_read(addr, read_ahead, fill) != I2C_STATUS_SUCCESS) {
+            return false;
+        }
+        read_ahead_addr = addr;
+        read_ahead_len  = fill;
+    }
+
+    memcpy(buf, &read_ahead[addr - read_ahead_addr], len);
+    return true;
+}
+
+/*
+    Keeps the read-ahead buffer in step with data written to the EEPROM.
+*/
+static void read_ahead_update(uintptr_t addr, const uint8_t *data, size_t len) {
+    uintptr_t start = addr > read_ahead_addr ? addr : read_ahead_addr;
+    uintptr_t end   = addr + len < read_ahead_addr + read_ahead_len ? addr + len : read_ahead_addr + read_ahead_len;
+    if (start < end) {
+        memcpy(&read_ahead[start - read_ahead_addr], &data[start - addr], end - start);
+    }
+}
+#endif // EXTERNAL_EEPROM_READ_AHEAD_SIZE > 0
+
 void eeprom_driver_init(void) {
     i2c_init();
 #if defined(EXTERNAL_EEPROM_WP_PIN)
@@ -79,11 +173,12 @@ void eeprom_driver_erase(void) {
 }
 
 void eeprom_read_block(void *buf, const void *addr, size_t len) {
-    uint8_t complete_packet[EXTERNAL_EEPROM_ADDRESS_SIZE];
-    fill_target_address(complete_packet, addr);
-
-    i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE, 100);
-    i2c_receive(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), buf, len, 100);
+#if EXTERNAL_EEPROM_READ_AHEAD_SIZE > 0
+    if (len > EXTERNAL_EEPROM_READ_AHEAD_SIZE || !read_ahead_fetch(buf, (uintptr_t)addr, len))
+#endif
+    {
+        eeprom_i2c_read((uintptr_t)addr, buf, len);
+    }
 
 #if defined(CONSOLE_ENABLE) && defined(DEBUG_EEPROM_OUTPUT)
     dprintf("[EEPROM R] 0x%04X: ", ((int)addr));
@@ -105,8 +200,9 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
 #endif
 
     while (len > 0) {
+        // Each transfer covers as much of a single page as possible, as the EEPROM wraps around within the page
         uintptr_t page_offset  = target_addr % EXTERNAL_EEPROM_PAGE_SIZE;
-        int       write_length = EXTERNAL_EEPROM_PAGE_SIZE - page_offset;
+        size_t    write_length = EXTERNAL_EEPROM_PAGE_SIZE - page_offset;
         if (write_length > len) {
             write_length = len;
         }
@@ -124,8 +220,21 @@ void eeprom_write_block(const void *buf, void *addr, size_t len) {
         dprintf("\n");
 #endif // DEBUG_EEPROM_OUTPUT
 
-        i2c_transmit(EXTERNAL_EEPROM_I2C_ADDRESS((uintptr_t)addr), complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length, 100);
-        wait_ms(EXTERNAL_EEPROM_WRITE_TIME);
+        i2c_status_t status = eeprom_i2c_transmit(target_addr, complete_packet, EXTERNAL_EEPROM_ADDRESS_SIZE + write_length);
+#if EXTERNAL_EEPROM_WRITE_TIME > 0
+        if (status == I2C_STATUS_SUCCESS) {
+            write_in_progress = true;
+            write_start_time  = timer_read();
+        }
+#endif
+#if EXTERNAL_EEPROM_READ_AHEAD_SIZE > 0
+        if (status == I2C_STATUS_SUCCESS) {
+            read_ahead_update(target_addr, read_buf, write_length);
+        } else {
+            read_ahead_len = 0;
+        }
+#endif
+        (void)status;
 
         read_buf += write_length;
         target_addr += write_length;
@@ -123,3 +123,12 @@
 #ifndef EXTERNAL_EEPROM_WRITE_TIME
 #    define EXTERNAL_EEPROM_WRITE_TIME 5
 #endif
+
+/*
+    The number of bytes fetched ahead when reading small amounts of data, such
+    that sequential reads (e.g. the dynamic keymap) are served from RAM rather
+    than each requiring an I2C transaction. Set to 0 to disable.
+*/
+#ifndef EXTERNAL_EEPROM_READ_AHEAD_SIZE
+#    define EXTERNAL_EEPROM_READ_AHEAD_SIZE 32
+#endif
@@ -34,7 +34,7 @@
 #include "debug.h"
 #include "timer.h"
 #include "spi_master.h"
-#include "eeprom.h"
+#include "eeprom_driver.h"
 #include "eeprom_spi.h"
 
 #define CMD_WREN 6
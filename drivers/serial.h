@@ -28,6 +28,34 @@ void soft_serial_target_init(void);
 
 bool soft_serial_transaction(int sstd_index);
 
+#ifdef SPLIT_TRANSPORT_BATCH
+// executes the transactions in the bitmask as a single framed exchange
+bool soft_serial_batch(uint32_t sstd_indices);
+#endif // SPLIT_TRANSPORT_BATCH
+
+#ifdef SPLIT_TRANSPORT_DELTA
+// makes the next exchange of the transaction carry its whole buffer, if it's delta-encoded
+void soft_serial_resync(int sstd_index);
+#endif // SPLIT_TRANSPORT_DELTA
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+// starts the transaction in the background, while the caller carries on
+bool soft_serial_transaction_start(int sstd_index);
+// collects the result of the background transaction, without waiting for it
+transport_async_status_t soft_serial_transaction_poll(void);
+#endif // SPLIT_TRANSPORT_ASYNC
+
+#ifdef SPLIT_TRANSPORT_STATS
+typedef struct {
+    uint32_t count;    // transactions started by the master
+    uint32_t failures; // transactions which failed part-way
+    uint32_t bytes;    // bytes sent and received on the wire, including the handshake
+} split_transaction_stats_t;
+
+void soft_serial_get_stats(int sstd_index, split_transaction_stats_t *stats);
+void soft_serial_clear_stats(void);
+#endif // SPLIT_TRANSPORT_STATS
+
 #ifdef SERIAL_DEBUG
 #    include <debug.h>
 #    include <print.h>
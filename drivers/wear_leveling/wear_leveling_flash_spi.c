@@ -41,6 +41,20 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+bool backing_store_erase_range(uint32_t address, size_t length) {
+    if (address % (EXTERNAL_FLASH_SECTOR_SIZE) != 0 || length % (EXTERNAL_FLASH_SECTOR_SIZE) != 0) {
+        return false;
+    }
+
+    for (uint32_t offset = 0; offset < length; offset += (EXTERNAL_FLASH_SECTOR_SIZE)) {
+        flash_status_t status = flash_erase_sector((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + address + offset);
+        if (status != FLASH_STATUS_SUCCESS) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
@@ -68,3 +68,23 @@
  *         - Wait 50us to reset the LEDs
  */
 void ws2812_setleds(LED_TYPE *ledarray, uint16_t number_of_leds);
+
+#if defined(WS2812_DRIVER_PWM) || defined(WS2812_DRIVER_SPI)
+/* Direct access to the frame buffer (PWM and SPI drivers)
+ *
+ * ws2812_write_led() encodes a single LED straight into the frame being drawn, and ws2812_show() sends it. LEDs
+ * that aren't written keep their colour from the last frame. With WS2812_DOUBLE_BUFFER defined, the next frame is
+ * drawn while the last one is still being sent.
+ *
+ * WS2812_DIRECT_WRITE is only defined where a frame can't be seen half drawn: the PWM driver sends its one frame
+ * over and over, as does the SPI driver with a circular buffer, so they need WS2812_DOUBLE_BUFFER. Otherwise callers
+ * keep their own LED_TYPE array and hand it over with ws2812_setleds().
+ */
+#    if defined(WS2812_DOUBLE_BUFFER) || (defined(WS2812_DRIVER_SPI) && !defined(WS2812_SPI_USE_CIRCULAR_BUFFER))
+#        define WS2812_DIRECT_WRITE
+#    endif
+
+void ws2812_write_led(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b);
+void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b, uint8_t w);
+void ws2812_show(void);
+#endif
@@ -207,6 +207,15 @@ def generate_split_config(kb_info_json, config_h_lines):
         generate_encoder_config(kb_info_json['split']['encoder']['right'], config_h_lines, '_RIGHT')
 
 
+def generate_led_polar_config(kb_info_json, config_h_lines):
+    """Let rgb_matrix know that keyboard.c has the LED polar coordinates generated from the layout."""
+    if 'layout' in kb_info_json.get('rgb_matrix', {}):
+        config_h_lines.append('')
+        config_h_lines.append('#ifndef RGB_MATRIX_LED_POLAR_GENERATED')
+        config_h_lines.append('#   define RGB_MATRIX_LED_POLAR_GENERATED')
+        config_h_lines.append('#endif // RGB_MATRIX_LED_POLAR_GENERATED')
+
+
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
 @cli.argument('-kb', '--keyboard', arg_only=True, type=keyboard_folder, completer=keyboard_completer, required=True, help='Keyboard to generate config.h for.')
@@ -237,5 +246,7 @@ def generate_config_h(cli):
     if 'split' in kb_info_json:
         generate_split_config(kb_info_json, config_h_lines)
 
+    generate_led_polar_config(kb_info_json, config_h_lines)
+
     # Show the results
     dump_lines(cli.args.output, config_h_lines, cli.args.quiet)
@@ -1,5 +1,7 @@
 """Used by the make system to generate keyboard.c from info.json.
 """
+import math
+
 from milc import cli
 
 from qmk.info import info_json
@@ -8,6 +10,54 @@ from qmk.keyboard import keyboard_completer, keyboard_folder
 from qmk.path import normpath
 from qmk.constants import GPL2_HEADER_C_LIKE, GENERATED_HEADER_C_LIKE
 
+# Default for RGB_MATRIX_CENTER, from rgb_matrix.c
+RGB_MATRIX_CENTER = (112, 32)
+
+
+def _c_div(a, b):
+    """Integer division that truncates towards zero, as C does
+    """
+    q = abs(a) // abs(b)
+    return q if (a < 0) == (b < 0) else -q
+
+
+def _atan2_8(dy, dx):
+    """Port of lib8tion's atan2_8(), giving an angle from 0 to 255
+    """
+    if dy == 0:
+        return 0 if dx >= 0 else 128
+
+    abs_y = abs(dy)
+    if dx >= 0:
+        a = 32 - _c_div(32 * (dx - abs_y), dx + abs_y)
+    else:
+        a = 96 - _c_div(32 * (dx + abs_y), abs_y - dx)
+
+    return -a & 0xFF if dy < 0 else a & 0xFF
+
+
+def _sqrt16(x):
+    """Port of lib8tion's sqrt16(), which gives the integer square root, capped at 255
+    """
+    return min(math.isqrt(x), 255)
+
+
+def _gen_led_polar(led_config):
+    """Angle and distance of each LED from the default RGB_MATRIX_CENTER, for the radial and spiral effects
+    """
+    polar = []
+    for item in led_config:
+        dx = item.get('x', 0) - RGB_MATRIX_CENTER[0]
+        dy = item.get('y', 0) - RGB_MATRIX_CENTER[1]
+        polar.append(f'{{ {_atan2_8(dy, dx)},{_sqrt16((dx * dx + dy * dy) & 0xFFFF)} }}')
+
+    lines = []
+    lines.append('#ifndef RGB_MATRIX_CENTER')
+    lines.append(f'const led_polar_t PROGMEM g_led_polar[{len(polar)}] = {{ {",".join(polar)} }};')
+    lines.append('#endif')
+
+    return lines
+
 
 def _gen_led_config(info_data):
     """Convert info.json content to g_led_config
@@ -52,6 +102,8 @@ def _gen_led_config(info_data):
     lines.append(f'  {{ {",".join(pos)} }},')
     lines.append(f'  {{ {",".join(flags)} }},')
     lines.append('};')
+    if config_type == 'rgb_matrix':
+        lines.extend(_gen_led_polar(led_config))
     lines.append('#endif')
 
     return lines
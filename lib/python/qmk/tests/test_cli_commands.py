@@ -275,6 +275,19 @@ def test_generate_config_h():
     assert '#   define MATRIX_ROW_PINS { F5 }' in result.stdout
 
 
+def test_generate_keyboard_c():
+    result = check_subcommand('generate-keyboard-c', '-kb', 'boardsource/microdox/v2')
+    check_returncode(result)
+    assert 'led_config_t g_led_config = {' in result.stdout
+    assert 'const led_polar_t PROGMEM g_led_polar[44] = {' in result.stdout
+
+
+def test_generate_config_h_led_polar():
+    result = check_subcommand('generate-config-h', '-kb', 'boardsource/microdox/v2')
+    check_returncode(result)
+    assert '#   define RGB_MATRIX_LED_POLAR_GENERATED' in result.stdout
+
+
 def test_generate_rules_mk():
     result = check_subcommand('generate-rules-mk', '-kb', 'handwired/pytest/basic')
     check_returncode(result)
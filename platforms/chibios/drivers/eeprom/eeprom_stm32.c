@@ -22,6 +22,7 @@
 #include <stdbool.h>
 #include "util.h"
 #include "debug.h"
+#include "eeprom_driver.h"
 #include "eeprom_stm32.h"
 #include "flash_stm32.h"
 
@@ -9,6 +9,47 @@
 #include "printf.h"
 #include "synchronization_util.h"
 
+#ifdef SPLIT_TRANSPORT_DELTA
+#    include "split_delta.h"
+
+/* The transaction ID and the handshake both fit in the lower bits of their byte, leaving the top bit to request that the
+ * next delta-encoded buffer is sent in full. */
+#    define TRANSACTION_RESYNC 0x80
+_Static_assert(((NUM_TOTAL_TRANSACTIONS - 1) | NUM_TOTAL_TRANSACTIONS) < TRANSACTION_RESYNC, "Transaction IDs overlap the resync flag");
+
+/* The delta-encoded buffers all precede the RPC buffers in split_shmem, so the copy below stops short of them. */
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+#        define DELTA_BASE_SIZE offsetof(split_shared_memory_t, rpc_info)
+#    else
+#        define DELTA_BASE_SIZE sizeof(split_shared_memory_t)
+#    endif
+
+/* Buffers are at most 255 bytes long, which bounds the encoded size too. */
+#    define DELTA_BUFFER_SIZE SPLIT_DELTA_MAX_SIZE((DELTA_BASE_SIZE) < UINT8_MAX ? (DELTA_BASE_SIZE) : UINT8_MAX)
+
+/* Copy of each delta-encoded buffer as last exchanged with the other half, at the same offset as in split_shmem.
+ * Only trusted if the transaction's bit is set in delta_base_valid. */
+static uint8_t  delta_base[DELTA_BASE_SIZE];
+static uint32_t delta_base_valid = 0;
+static uint8_t  delta_buffer[DELTA_BUFFER_SIZE];
+
+#    define delta_base_ptr(offset) (delta_base + (offset))
+#    define delta_base_is_valid(id) (delta_base_valid & (1UL << (id)))
+#    define delta_base_set_valid(id, valid) (delta_base_valid = (valid) ? (delta_base_valid | (1UL << (id))) : (delta_base_valid & ~(1UL << (id))))
+#endif // SPLIT_TRANSPORT_DELTA
+
+#ifdef SPLIT_TRANSPORT_STATS
+static split_transaction_stats_t transaction_stats[NUM_TOTAL_TRANSACTIONS];
+
+#    define stats_record_start(id) (transaction_stats[id].count++, transaction_stats[id].bytes += 2)
+#    define stats_record_bytes(id, n) (transaction_stats[id].bytes += (n))
+#    define stats_record_failure(id) (transaction_stats[id].failures++)
+#else // SPLIT_TRANSPORT_STATS
+#    define stats_record_start(id)
+#    define stats_record_bytes(id, n)
+#    define stats_record_failure(id)
+#endif // SPLIT_TRANSPORT_STATS
+
 static inline bool initiate_transaction(uint8_t transaction_id);
 static inline bool react_to_transaction(void);
 
@@ -30,6 +71,49 @@ static THD_FUNCTION(SlaveThread, arg) {
     }
 }
 
+#ifdef SPLIT_TRANSPORT_ASYNC
+/*
+ * Asynchronous transactions are run by a thread on the master, so that the
+ * main loop can carry on while the driver moves the bytes. Only one
+ * transaction is ever on the wire: any other transaction first waits for the
+ * background one to complete, and its result is kept until it's collected.
+ */
+static binary_semaphore_t       async_start;
+static binary_semaphore_t       async_done;
+static volatile uint8_t         async_transaction_id;
+static volatile bool            async_result;
+static transport_async_status_t async_status = TRANSPORT_ASYNC_IDLE;
+
+/**
+ * @brief This thread runs on the master and executes transactions started in
+ * the background.
+ */
+static THD_WORKING_AREA(waAsyncThread, 512);
+static THD_FUNCTION(AsyncThread, arg) {
+    (void)arg;
+    chRegSetThreadName("split_protocol_async");
+
+    while (true) {
+        chBSemWait(&async_start);
+        async_result = initiate_transaction(async_transaction_id);
+        if (unlikely(!async_result)) {
+            serial_transport_driver_clear();
+        }
+        chBSemSignal(&async_done);
+    }
+}
+
+/**
+ * @brief Picks up the result of the background transaction once it has
+ * completed, optionally waiting for it to do so.
+ */
+static inline void async_update(bool wait) {
+    if (async_status == TRANSPORT_ASYNC_BUSY && chBSemWaitTimeout(&async_done, wait ? TIME_INFINITE : TIME_IMMEDIATE) == MSG_OK) {
+        async_status = async_result ? TRANSPORT_ASYNC_SUCCESS : TRANSPORT_ASYNC_FAILED;
+    }
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
 /**
  * @brief Slave specific initializations.
  */
@@ -45,8 +129,236 @@ void soft_serial_target_init(void) {
  */
 void soft_serial_initiator_init(void) {
     serial_transport_driver_master_init();
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    chBSemObjectInit(&async_start, true);
+    chBSemObjectInit(&async_done, true);
+    chThdCreateStatic(waAsyncThread, sizeof(waAsyncThread), HIGHPRIO, AsyncThread, NULL);
+#endif // SPLIT_TRANSPORT_ASYNC
 }
 
+#ifdef SPLIT_TRANSPORT_DELTA
+/**
+ * @brief Whether the supplied buffer of the transaction is delta-encoded.
+ * Buffers that lie outside of the delta copy are always sent in full.
+ */
+static inline bool is_delta_encoded(split_transaction_desc_t* transaction, uint16_t offset, uint8_t length) {
+    return transaction->delta_encoded && offset + length <= DELTA_BASE_SIZE;
+}
+
+/**
+ * @brief Sends the supplied split_shmem buffer, encoded against the copy last
+ * sent. The whole buffer is sent if that copy isn't valid.
+ *
+ * @return size_t Number of bytes sent, or 0 on failure.
+ */
+static size_t send_delta(uint8_t transaction_id, uint16_t offset, uint8_t length) {
+    uint8_t* base = delta_base_ptr(offset);
+    size_t   size = split_delta_encode(delta_buffer, delta_base_is_valid(transaction_id) ? base : NULL, split_shmem_offset_ptr(offset), length);
+
+    /* Until it's known to have been received, the other half's copy can't be trusted. */
+    delta_base_set_valid(transaction_id, false);
+    if (unlikely(!serial_transport_send(delta_buffer, size))) {
+        return 0;
+    }
+
+    memcpy(base, split_shmem_offset_ptr(offset), length);
+    delta_base_set_valid(transaction_id, true);
+    return size;
+}
+
+/**
+ * @brief Receives a delta-encoded buffer, applying it to the supplied copy
+ * once it has been received in full.
+ *
+ * @return size_t Number of bytes received, or 0 on failure.
+ */
+static size_t receive_delta(uint8_t transaction_id, uint8_t length, uint8_t* base) {
+    uint8_t* header  = delta_buffer;
+    uint8_t* payload = delta_buffer + SPLIT_DELTA_HEADER_SIZE(length);
+
+    delta_base_set_valid(transaction_id, false);
+    if (unlikely(!serial_transport_receive(header, SPLIT_DELTA_HEADER_SIZE(length)))) {
+        return 0;
+    }
+
+    size_t size = split_delta_payload_size(header, length);
+    if (size > 0 && unlikely(!serial_transport_receive(payload, size))) {
+        return 0;
+    }
+
+    split_delta_apply(base, header, payload, length);
+    delta_base_set_valid(transaction_id, true);
+    return SPLIT_DELTA_HEADER_SIZE(length) + size;
+}
+#endif // SPLIT_TRANSPORT_DELTA
+
+/**
+ * @brief Sends one of the transaction's split_shmem buffers, delta-encoded if
+ * the transaction is registered as such.
+ *
+ * @return size_t Number of bytes sent, or 0 on failure.
+ */
+static inline size_t send_buffer(uint8_t transaction_id, split_transaction_desc_t* transaction, uint16_t offset, uint8_t length) {
+#ifdef SPLIT_TRANSPORT_DELTA
+    if (is_delta_encoded(transaction, offset, length)) {
+        return send_delta(transaction_id, offset, length);
+    }
+#endif // SPLIT_TRANSPORT_DELTA
+    return serial_transport_send(split_shmem_offset_ptr(offset), length) ? length : 0;
+}
+
+/**
+ * @brief Receives one of the transaction's split_shmem buffers, delta-encoded
+ * if the transaction is registered as such. Delta-encoded data is applied to
+ * the supplied base, and then copied to split_shmem if they differ.
+ *
+ * @return size_t Number of bytes received, or 0 on failure.
+ */
+static inline size_t receive_buffer(uint8_t transaction_id, split_transaction_desc_t* transaction, uint16_t offset, uint8_t length, uint8_t* base) {
+#ifdef SPLIT_TRANSPORT_DELTA
+    if (is_delta_encoded(transaction, offset, length)) {
+        size_t size = receive_delta(transaction_id, length, base);
+        if (size > 0 && base != split_shmem_offset_ptr(offset)) {
+            memcpy(split_shmem_offset_ptr(offset), base, length);
+        }
+        return size;
+    }
+#endif // SPLIT_TRANSPORT_DELTA
+    return serial_transport_receive(split_shmem_offset_ptr(offset), length) ? length : 0;
+}
+
+/**
+ * @brief Receives the transaction's buffer from the master. The slave's own
+ * handlers are free to modify split_shmem, so delta-encoded buffers are
+ * applied to a separate copy.
+ */
+static inline size_t slave_receive_buffer(uint8_t transaction_id, split_transaction_desc_t* transaction) {
+#ifdef SPLIT_TRANSPORT_DELTA
+    uint8_t* base = delta_base_ptr(transaction->initiator2target_offset);
+#else  // SPLIT_TRANSPORT_DELTA
+    uint8_t* base = NULL;
+#endif // SPLIT_TRANSPORT_DELTA
+    return receive_buffer(transaction_id, transaction, transaction->initiator2target_offset, transaction->initiator2target_buffer_size, base);
+}
+
+/**
+ * @brief Receives the transaction's buffer from the slave. The master's copy
+ * of split_shmem isn't touched outside of transactions, so doubles as the
+ * base for delta-encoded buffers.
+ */
+static inline size_t master_receive_buffer(uint8_t transaction_id, split_transaction_desc_t* transaction) {
+    return receive_buffer(transaction_id, transaction, transaction->target2initiator_offset, transaction->target2initiator_buffer_size, split_trans_target2initiator_buffer(transaction));
+}
+
+#ifdef SPLIT_TRANSPORT_DELTA
+/**
+ * @brief Whether the receiving side's copy of a delta-encoded buffer is stale,
+ * and the whole buffer needs to be sent.
+ */
+static inline bool needs_resync(uint8_t transaction_id, split_transaction_desc_t* transaction, uint16_t offset, uint8_t buffer_size) {
+    return buffer_size && is_delta_encoded(transaction, offset, buffer_size) && !delta_base_is_valid(transaction_id);
+}
+#endif // SPLIT_TRANSPORT_DELTA
+
+#ifdef SPLIT_TRANSPORT_BATCH
+#    define BATCH_TOC_SIZE ((NUM_TOTAL_TRANSACTIONS + 7) / 8)
+#    define batch_for_each(ids, id) \
+        for (uint8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) \
+            if ((ids) & (1UL << id))
+
+/*
+ * A batch is a single exchange covering several transactions. The master sends
+ * the EXECUTE_BATCH ID, followed by a table of contents: a bitmask of the
+ * transactions in the batch, then its complement as a simple checksum. Once
+ * the slave has acknowledged it, the master sends each transaction's buffer in
+ * ID order, the slave runs each transaction's callback, and then sends each
+ * transaction's buffer back in ID order.
+ *
+ * The resync flag in the ID and the handshake applies to every delta-encoded
+ * buffer in the batch.
+ */
+
+/**
+ * @brief Receives and validates the table of contents of a batch.
+ */
+static inline bool receive_batch_toc(uint32_t* transaction_ids) {
+    uint8_t toc[BATCH_TOC_SIZE * 2];
+    if (unlikely(!serial_transport_receive(toc, sizeof(toc)))) {
+        return false;
+    }
+
+    uint32_t ids = 0;
+    for (uint8_t i = 0; i < BATCH_TOC_SIZE; ++i) {
+        if (unlikely((toc[i] ^ toc[BATCH_TOC_SIZE + i]) != 0xFF)) {
+            return false;
+        }
+        ids |= (uint32_t)toc[i] << (i * 8);
+    }
+
+    /* Only known transactions, and no nested batches. */
+    if (unlikely(((uint64_t)ids >> NUM_TOTAL_TRANSACTIONS) || (ids & (1UL << EXECUTE_BATCH)))) {
+        return false;
+    }
+
+    *transaction_ids = ids;
+    return true;
+}
+
+/**
+ * @brief React to a batch of transactions started by the master.
+ */
+static inline bool react_to_batch(bool resync) {
+    uint32_t transaction_ids = 0;
+    if (unlikely(!receive_batch_toc(&transaction_ids))) {
+        return false;
+    }
+
+    uint8_t transaction_id_shake = EXECUTE_BATCH ^ NUM_TOTAL_TRANSACTIONS;
+#    ifdef SPLIT_TRANSPORT_DELTA
+    batch_for_each(transaction_ids, id) {
+        if (needs_resync(id, &split_transaction_table[id], split_transaction_table[id].initiator2target_offset, split_transaction_table[id].initiator2target_buffer_size)) {
+            transaction_id_shake |= TRANSACTION_RESYNC;
+        }
+    }
+#    endif // SPLIT_TRANSPORT_DELTA
+    if (unlikely(!serial_transport_send(&transaction_id_shake, sizeof(transaction_id_shake)))) {
+        return false;
+    }
+
+    batch_for_each(transaction_ids, id) {
+        split_transaction_desc_t* transaction = &split_transaction_table[id];
+        if (transaction->initiator2target_buffer_size && unlikely(!slave_receive_buffer(id, transaction))) {
+            return false;
+        }
+    }
+
+    batch_for_each(transaction_ids, id) {
+        split_transaction_desc_t* transaction = &split_transaction_table[id];
+        if (transaction->slave_callback) {
+            transaction->slave_callback(transaction->initiator2target_buffer_size, split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size, split_trans_target2initiator_buffer(transaction));
+        }
+    }
+
+    batch_for_each(transaction_ids, id) {
+        split_transaction_desc_t* transaction = &split_transaction_table[id];
+        if (!transaction->target2initiator_buffer_size) {
+            continue;
+        }
+#    ifdef SPLIT_TRANSPORT_DELTA
+        if (resync) {
+            delta_base_set_valid(id, false);
+        }
+#    endif // SPLIT_TRANSPORT_DELTA
+        if (unlikely(!send_buffer(id, transaction, transaction->target2initiator_offset, transaction->target2initiator_buffer_size))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif // SPLIT_TRANSPORT_BATCH
+
 /**
  * @brief React to transactions started by the master.
  */
@@ -57,6 +369,11 @@ static inline bool react_to_transaction(void) {
         return false;
     }
 
+#ifdef SPLIT_TRANSPORT_DELTA
+    bool resync = transaction_id & TRANSACTION_RESYNC;
+    transaction_id &= ~TRANSACTION_RESYNC;
+#endif // SPLIT_TRANSPORT_DELTA
+
     /* Sanity check that we are actually responding to a valid transaction. */
     if (unlikely(transaction_id >= NUM_TOTAL_TRANSACTIONS)) {
         return false;
@@ -64,18 +381,34 @@ static inline bool react_to_transaction(void) {
 
     split_shared_memory_lock_autounlock();
 
+#ifdef SPLIT_TRANSPORT_BATCH
+    if (transaction_id == EXECUTE_BATCH) {
+#    ifdef SPLIT_TRANSPORT_DELTA
+        return react_to_batch(resync);
+#    else  // SPLIT_TRANSPORT_DELTA
+        return react_to_batch(false);
+#    endif // SPLIT_TRANSPORT_DELTA
+    }
+#endif // SPLIT_TRANSPORT_BATCH
+
     split_transaction_desc_t* transaction = &split_transaction_table[transaction_id];
 
     /* Send back the handshake which is XORed as a simple checksum,
      to signal that the slave is ready to receive possible transaction buffers  */
-    transaction_id ^= NUM_TOTAL_TRANSACTIONS;
-    if (unlikely(!serial_transport_send(&transaction_id, sizeof(transaction_id)))) {
+    uint8_t transaction_id_shake = transaction_id ^ NUM_TOTAL_TRANSACTIONS;
+#ifdef SPLIT_TRANSPORT_DELTA
+    /* Ask for the whole buffer if we don't know what the master last sent. */
+    if (needs_resync(transaction_id, transaction, transaction->initiator2target_offset, transaction->initiator2target_buffer_size)) {
+        transaction_id_shake |= TRANSACTION_RESYNC;
+    }
+#endif // SPLIT_TRANSPORT_DELTA
+    if (unlikely(!serial_transport_send(&transaction_id_shake, sizeof(transaction_id_shake)))) {
         return false;
     }
 
     /* Receive transaction buffer from the master. If this transaction requires it.*/
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        if (unlikely(!slave_receive_buffer(transaction_id, transaction))) {
             return false;
         }
     }
@@ -87,7 +420,12 @@ static inline bool react_to_transaction(void) {
 
     /* Send transaction buffer to the master. If this transaction requires it. */
     if (transaction->target2initiator_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+#ifdef SPLIT_TRANSPORT_DELTA
+        if (resync) {
+            delta_base_set_valid(transaction_id, false);
+        }
+#endif // SPLIT_TRANSPORT_DELTA
+        if (unlikely(!send_buffer(transaction_id, transaction, transaction->target2initiator_offset, transaction->target2initiator_buffer_size))) {
             return false;
         }
     }
@@ -102,6 +440,10 @@ static inline bool react_to_transaction(void) {
  * @return bool Indicates success of transaction.
  */
 bool soft_serial_transaction(int index) {
+#ifdef SPLIT_TRANSPORT_ASYNC
+    async_update(true);
+#endif // SPLIT_TRANSPORT_ASYNC
+
     bool result = initiate_transaction((uint8_t)index);
 
     if (unlikely(!result)) {
@@ -127,9 +469,20 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
 
     split_transaction_desc_t* transaction = &split_transaction_table[transaction_id];
 
+    stats_record_start(transaction_id);
+
+    uint8_t transaction_id_send = transaction_id;
+#ifdef SPLIT_TRANSPORT_DELTA
+    /* Ask for the whole buffer if we don't know what the slave last sent. */
+    if (needs_resync(transaction_id, transaction, transaction->target2initiator_offset, transaction->target2initiator_buffer_size)) {
+        transaction_id_send |= TRANSACTION_RESYNC;
+    }
+#endif // SPLIT_TRANSPORT_DELTA
+
     /* Send transaction table index to the slave, which doubles as basic handshake token. */
-    if (unlikely(!serial_transport_send(&transaction_id, sizeof(transaction_id)))) {
+    if (unlikely(!serial_transport_send(&transaction_id_send, sizeof(transaction_id_send)))) {
         serial_dprintf("SPLIT: sending handshake failed\n");
+        stats_record_failure(transaction_id);
         return false;
     }
 
@@ -139,26 +492,229 @@ static inline bool initiate_transaction(uint8_t transaction_id) {
      *   - due to the half duplex limitations on return codes, we always have to read *something*.
      *   - without the read, write only transactions *always* succeed, even during the boot process where the slave is not ready.
      */
-    if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)) || (transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS)))) {
+    if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)))) {
         serial_dprintf("SPLIT: receiving handshake failed\n");
+        stats_record_failure(transaction_id);
+        return false;
+    }
+
+#ifdef SPLIT_TRANSPORT_DELTA
+    /* The slave asks for the whole buffer if it doesn't know what we last sent. */
+    if (transaction_id_shake & TRANSACTION_RESYNC) {
+        delta_base_set_valid(transaction_id, false);
+        transaction_id_shake &= ~TRANSACTION_RESYNC;
+    }
+#endif // SPLIT_TRANSPORT_DELTA
+
+    if (unlikely(transaction_id_shake != (transaction_id ^ NUM_TOTAL_TRANSACTIONS))) {
+        serial_dprintf("SPLIT: receiving handshake failed\n");
+        stats_record_failure(transaction_id);
         return false;
     }
 
     /* Send transaction buffer to the slave. If this transaction requires it. */
     if (transaction->initiator2target_buffer_size) {
-        if (unlikely(!serial_transport_send(split_trans_initiator2target_buffer(transaction), transaction->initiator2target_buffer_size))) {
+        size_t size = send_buffer(transaction_id, transaction, transaction->initiator2target_offset, transaction->initiator2target_buffer_size);
+        if (unlikely(size == 0)) {
             serial_dprintf("SPLIT: sending buffer failed\n");
+            stats_record_failure(transaction_id);
             return false;
         }
+        stats_record_bytes(transaction_id, size);
     }
 
     /* Receive transaction buffer from the slave. If this transaction requires it. */
     if (transaction->target2initiator_buffer_size) {
-        if (unlikely(!serial_transport_receive(split_trans_target2initiator_buffer(transaction), transaction->target2initiator_buffer_size))) {
+        size_t size = master_receive_buffer(transaction_id, transaction);
+        if (unlikely(size == 0)) {
             serial_dprintf("SPLIT: receiving buffer failed\n");
+            stats_record_failure(transaction_id);
+            return false;
+        }
+        stats_record_bytes(transaction_id, size);
+    }
+
+    return true;
+}
+
+#ifdef SPLIT_TRANSPORT_BATCH
+/**
+ * @brief Initiate a batch of transactions to slave half.
+ */
+static inline bool initiate_batch(uint32_t transaction_ids) {
+    /* Sanity check that we are actually starting valid transactions. */
+    if (unlikely(((uint64_t)transaction_ids >> NUM_TOTAL_TRANSACTIONS) || (transaction_ids & (1UL << EXECUTE_BATCH)))) {
+        serial_dprintf("SPLIT: illegal batch\n");
+        return false;
+    }
+
+    split_shared_memory_lock_autounlock();
+
+    stats_record_start(EXECUTE_BATCH);
+
+    /* The ID and table of contents go out together, as the slave needs to know
+     * what's in the batch before it can tell whether it needs a resync. */
+    uint8_t frame[1 + BATCH_TOC_SIZE * 2];
+    frame[0] = EXECUTE_BATCH;
+    for (uint8_t i = 0; i < BATCH_TOC_SIZE; ++i) {
+        frame[1 + i]                  = transaction_ids >> (i * 8);
+        frame[1 + BATCH_TOC_SIZE + i] = ~frame[1 + i];
+    }
+#    ifdef SPLIT_TRANSPORT_DELTA
+    batch_for_each(transaction_ids, id) {
+        if (needs_resync(id, &split_transaction_table[id], split_transaction_table[id].target2initiator_offset, split_transaction_table[id].target2initiator_buffer_size)) {
+            frame[0] |= TRANSACTION_RESYNC;
+        }
+    }
+#    endif // SPLIT_TRANSPORT_DELTA
+
+    if (unlikely(!serial_transport_send(frame, sizeof(frame)))) {
+        serial_dprintf("SPLIT: sending batch handshake failed\n");
+        stats_record_failure(EXECUTE_BATCH);
+        return false;
+    }
+    stats_record_bytes(EXECUTE_BATCH, BATCH_TOC_SIZE * 2);
+
+    uint8_t transaction_id_shake = 0xFF;
+    if (unlikely(!serial_transport_receive(&transaction_id_shake, sizeof(transaction_id_shake)))) {
+        serial_dprintf("SPLIT: receiving batch handshake failed\n");
+        stats_record_failure(EXECUTE_BATCH);
+        return false;
+    }
+
+#    ifdef SPLIT_TRANSPORT_DELTA
+    /* The slave asks for the whole of every buffer if it doesn't know what we last sent for any of them. */
+    if (transaction_id_shake & TRANSACTION_RESYNC) {
+        batch_for_each(transaction_ids, id) {
+            delta_base_set_valid(id, false);
+        }
+        transaction_id_shake &= ~TRANSACTION_RESYNC;
+    }
+#    endif // SPLIT_TRANSPORT_DELTA
+
+    if (unlikely(transaction_id_shake != (EXECUTE_BATCH ^ NUM_TOTAL_TRANSACTIONS))) {
+        serial_dprintf("SPLIT: receiving batch handshake failed\n");
+        stats_record_failure(EXECUTE_BATCH);
+        return false;
+    }
+
+    batch_for_each(transaction_ids, id) {
+        split_transaction_desc_t* transaction = &split_transaction_table[id];
+        if (!transaction->initiator2target_buffer_size) {
+            continue;
+        }
+
+        size_t size = send_buffer(id, transaction, transaction->initiator2target_offset, transaction->initiator2target_buffer_size);
+        if (unlikely(size == 0)) {
+            serial_dprintf("SPLIT: sending batch buffer failed\n");
+            stats_record_failure(EXECUTE_BATCH);
+            return false;
+        }
+        stats_record_bytes(EXECUTE_BATCH, size);
+    }
+
+    batch_for_each(transaction_ids, id) {
+        split_transaction_desc_t* transaction = &split_transaction_table[id];
+        if (!transaction->target2initiator_buffer_size) {
+            continue;
+        }
+
+        size_t size = master_receive_buffer(id, transaction);
+        if (unlikely(size == 0)) {
+            serial_dprintf("SPLIT: receiving batch buffer failed\n");
+            stats_record_failure(EXECUTE_BATCH);
             return false;
         }
+        stats_record_bytes(EXECUTE_BATCH, size);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Start a batch of transactions from the master half to the slave half.
+ *
+ * @param indices Bitmask of the Transaction Table indices to execute.
+ * @return bool Indicates success of the whole batch.
+ */
+bool soft_serial_batch(uint32_t indices) {
+#    ifdef SPLIT_TRANSPORT_ASYNC
+    async_update(true);
+#    endif // SPLIT_TRANSPORT_ASYNC
+
+    bool result = initiate_batch(indices);
+
+    if (unlikely(!result)) {
+        /* Clear the receive queue, to start with a clean slate.
+         * Parts of failed transactions or spurious bytes could still be in it. */
+        serial_transport_driver_clear();
+    }
+
+    return result;
+}
+#endif // SPLIT_TRANSPORT_BATCH
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+/**
+ * @brief Start transaction from the master half to the slave half, in the
+ * background.
+ *
+ * @param index Transaction Table index of the transaction to start.
+ * @return bool false if the previous background transaction hasn't been
+ * collected yet.
+ */
+bool soft_serial_transaction_start(int index) {
+    async_update(false);
+    if (async_status != TRANSPORT_ASYNC_IDLE) {
+        return false;
     }
 
+    async_transaction_id = (uint8_t)index;
+    async_status         = TRANSPORT_ASYNC_BUSY;
+    chBSemSignal(&async_start);
     return true;
 }
+
+/**
+ * @brief Returns the state of the background transaction, without waiting for
+ * it. A completed transaction's result is only returned once.
+ */
+transport_async_status_t soft_serial_transaction_poll(void) {
+    async_update(false);
+    transport_async_status_t status = async_status;
+    if (status != TRANSPORT_ASYNC_BUSY) {
+        async_status = TRANSPORT_ASYNC_IDLE;
+    }
+    return status;
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
+#ifdef SPLIT_TRANSPORT_DELTA
+/**
+ * @brief Makes the next exchange of the transaction carry its whole buffer.
+ * The transaction's copy is dropped, so the master sends its buffer in full,
+ * and asks the slave to do the same.
+ */
+void soft_serial_resync(int sstd_index) {
+    split_shared_memory_lock_autounlock();
+    delta_base_set_valid(sstd_index, false);
+}
+#endif // SPLIT_TRANSPORT_DELTA
+
+#ifdef SPLIT_TRANSPORT_STATS
+/**
+ * @brief Returns the statistics gathered for the supplied transaction.
+ */
+void soft_serial_get_stats(int sstd_index, split_transaction_stats_t* stats) {
+    split_shared_memory_lock_autounlock();
+    *stats = transaction_stats[sstd_index];
+}
+
+/**
+ * @brief Clears the statistics gathered for all transactions.
+ */
+void soft_serial_clear_stats(void) {
+    split_shared_memory_lock_autounlock();
+    memset(transaction_stats, 0, sizeof(transaction_stats));
+}
+#endif // SPLIT_TRANSPORT_STATS
@@ -119,6 +119,37 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+bool backing_store_erase_range(uint32_t address, size_t length) {
+    bool          ret   = true;
+    uint32_t      start = base_offset + address;
+    uint32_t      end   = start + length;
+    flash_error_t status;
+    for (int i = 0; i < sector_count; ++i) {
+        uint32_t sector_start = flashGetSectorOffset(flash, first_sector + i);
+        uint32_t sector_end   = sector_start + flashGetSectorSize(flash, first_sector + i);
+        if (sector_end <= start || sector_start >= end) {
+            continue;
+        }
+
+        // Sectors straddling the range can't be erased without losing data outside of it
+        if (sector_start < start || sector_end > end) {
+            return false;
+        }
+
+        status = flashStartEraseSector(flash, first_sector + i);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+
+        status = flashWaitErase(flash);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            ret = false;
+        }
+    }
+
+    return ret;
+}
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
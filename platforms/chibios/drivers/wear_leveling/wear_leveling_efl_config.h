@@ -41,6 +41,17 @@
 #    endif
 #endif
 
+// Work out the granularity of backing_store_erase_range(), only needed for incremental consolidation
+#if defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION) && !defined(BACKING_STORE_ERASE_SIZE)
+#    if defined(QMK_MCU_SERIES_GD32VF103)
+#        define BACKING_STORE_ERASE_SIZE 1024 // from hal_efl_lld.c
+#    elif defined(QMK_MCU_FAMILY_STM32) && defined(STM32_FLASH_SECTOR_SIZE) // from some family's stm32_registry.h file
+#        define BACKING_STORE_ERASE_SIZE (STM32_FLASH_SECTOR_SIZE)
+#    else
+#        error "Could not automatically determine BACKING_STORE_ERASE_SIZE, set it to the largest flash sector size within the backing store"
+#    endif
+#endif
+
 // 2kB backing space allocated
 #ifndef WEAR_LEVELING_BACKING_SIZE
 #    define WEAR_LEVELING_BACKING_SIZE 2048
@@ -0,0 +1,112 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Frame buffer handling for the DMA driven WS2812 drivers
+ *
+ * None of this touches the hardware, so that it can be tested on the host.
+ */
+
+#define WS2812_SPI_BYTES_PER_BYTE 4
+
+/**
+ * @brief   Encode a byte for the SPI driver
+ *
+ * Each bit is sent as four SPI bits, 1110 for a one and 1000 for a zero, most significant bit first.
+ *
+ * @param[out] out:                 The @ref WS2812_SPI_BYTES_PER_BYTE bytes to send
+ * @param[in] data:                 The byte to encode
+ */
+static inline void ws2812_spi_encode_byte(uint8_t *out, uint8_t data) {
+    // Two bits go in each SPI byte, so they can be looked up rather than worked out one at a time
+    static const uint8_t patterns[4] = {0x88, 0x8E, 0xE8, 0xEE};
+
+    out[0] = patterns[data >> 6];
+    out[1] = patterns[(data >> 4) & 0x03];
+    out[2] = patterns[(data >> 2) & 0x03];
+    out[3] = patterns[data & 0x03];
+}
+
+/**
+ * @brief   A pair of encoded frames, one being sent while the other is drawn
+ *
+ * Only the LEDs that change are drawn. Once a frame has been handed over to be sent, the LEDs drawn into it are
+ * copied to the other frame before anything new is drawn there, so that both hold the same picture again.
+ *
+ * Both frames can be the same buffer, in which case LEDs are drawn straight into the frame being sent.
+ */
+typedef struct {
+    uint8_t *front;    // being sent
+    uint8_t *back;     // being drawn
+    uint16_t led_size; // bytes each LED takes, once encoded
+    bool     stale;    // the back frame is missing the LEDs drawn into the front one
+    uint8_t  drawn[(RGBLED_NUM + 7) / 8];
+} ws2812_frames_t;
+
+/**
+ * @brief   Set up a pair of frames, which must already hold the same picture
+ *
+ * @param[in] front:                Where the first LED's encoding starts in one frame
+ * @param[in] back:                 Where it starts in the other, or the same as front for a single frame
+ * @param[in] led_size:             The number of bytes each LED takes
+ */
+static inline void ws2812_frames_init(ws2812_frames_t *frames, void *front, void *back, uint16_t led_size) {
+    frames->front    = (uint8_t *)front;
+    frames->back     = (uint8_t *)back;
+    frames->led_size = led_size;
+    frames->stale    = false;
+    memset(frames->drawn, 0, sizeof(frames->drawn));
+}
+
+/**
+ * @brief   Bring the back frame up to date with the front one
+ *
+ * Must be called before drawing, once the hardware has finished with the back frame.
+ */
+static inline void ws2812_frames_catch_up(ws2812_frames_t *frames) {
+    if (!frames->stale) {
+        return;
+    }
+    for (uint16_t i = 0; i < sizeof(frames->drawn); i++) {
+        for (uint8_t drawn = frames->drawn[i]; drawn; drawn &= drawn - 1) {
+            uint16_t offset = (i * 8 + __builtin_ctz(drawn)) * frames->led_size;
+            memcpy(&frames->back[offset], &frames->front[offset], frames->led_size);
+        }
+    }
+    memset(frames->drawn, 0, sizeof(frames->drawn));
+    frames->stale = false;
+}
+
+/**
+ * @brief   Find where an LED's encoding goes in the back frame
+ *
+ * @param[in] led:                  The LED index [0, @ref RGBLED_NUM)
+ *
+ * @return                          The first of the LED's bytes
+ */
+static inline uint8_t *ws2812_frames_draw(ws2812_frames_t *frames, uint16_t led) {
+    frames->drawn[led / 8] |= 1 << (led % 8);
+    return &frames->back[led * frames->led_size];
+}
+
+/**
+ * @brief   Hand the back frame over to be sent
+ *
+ * @return                          The frame to send
+ */
+static inline uint8_t *ws2812_frames_swap(ws2812_frames_t *frames) {
+    if (frames->front != frames->back) {
+        uint8_t *drawn = frames->back;
+        frames->back   = frames->front;
+        frames->front  = drawn;
+        frames->stale  = true;
+    } else {
+        memset(frames->drawn, 0, sizeof(frames->drawn));
+    }
+    return frames->front;
+}
@@ -1,4 +1,5 @@
 #include "ws2812.h"
+#include "ws2812_encode.h"
 #include "quantum.h"
 #include <hal.h>
 
@@ -128,145 +129,6 @@
 #    error WS2812 PWM driver: High period for a 1 is more than a byte
 #endif
 
-/* --- PRIVATE MACROS ------------------------------------------------------- */
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given bit
- *
- * @param[in] led:                  The led index [0, @ref RGBLED_NUM)
- * @param[in] byte:                 The byte number [0, 2]
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#define WS2812_BIT(led, byte, bit) (WS2812_COLOR_BITS * (led) + 8 * (byte) + (7 - (bit)))
-
-#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given red bit
- *
- * @note    The red byte is the middle byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref RGBLED_NUM)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_RED_BIT(led, bit) WS2812_BIT((led), 1, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given green bit
- *
- * @note    The red byte is the first byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref RGBLED_NUM)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_GREEN_BIT(led, bit) WS2812_BIT((led), 0, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given blue bit
- *
- * @note    The red byte is the last byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref RGBLED_NUM)
- * @param[in] bit:                  The bit index [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_BLUE_BIT(led, bit) WS2812_BIT((led), 2, (bit))
-
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given red bit
- *
- * @note    The red byte is the middle byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref RGBLED_NUM)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_RED_BIT(led, bit) WS2812_BIT((led), 0, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given green bit
- *
- * @note    The red byte is the first byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref RGBLED_NUM)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_GREEN_BIT(led, bit) WS2812_BIT((led), 1, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given blue bit
- *
- * @note    The red byte is the last byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref RGBLED_NUM)
- * @param[in] bit:                  The bit index [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_BLUE_BIT(led, bit) WS2812_BIT((led), 2, (bit))
-
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given red bit
- *
- * @note    The red byte is the middle byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref RGBLED_NUM)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_RED_BIT(led, bit) WS2812_BIT((led), 2, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given green bit
- *
- * @note    The red byte is the first byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref RGBLED_NUM)
- * @param[in] bit:                  The bit number [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_GREEN_BIT(led, bit) WS2812_BIT((led), 1, (bit))
-
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given blue bit
- *
- * @note    The red byte is the last byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref RGBLED_NUM)
- * @param[in] bit:                  The bit index [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_BLUE_BIT(led, bit) WS2812_BIT((led), 0, (bit))
-#endif
-
-#ifdef RGBW
-/**
- * @brief   Determine the index in @ref ws2812_frame_buffer "the frame buffer" of a given white bit
- *
- * @note    The white byte is the last byte in the color packet
- *
- * @param[in] led:                  The led index [0, @ref WS2812_LED_N)
- * @param[in] bit:                  The bit index [0, 7]
- *
- * @return                          The bit index
- */
-#    define WS2812_WHITE_BIT(led, bit) WS2812_BIT((led), 3, (bit))
-#endif
-
 /* --- PRIVATE VARIABLES ---------------------------------------------------- */
 
 // STM32F2XX, STM32F4XX and STM32F7XX do NOT zero pad DMA transfers of unequal data width. Buffer width must match TIMx CCR.
@@ -291,22 +153,118 @@ typedef uint16_t ws2812_buffer_t;
 typedef uint8_t ws2812_buffer_t;
 #endif
 
-static ws2812_buffer_t ws2812_frame_buffer[WS2812_BIT_N + 1]; /**< Buffer for a frame */
+#ifdef WS2812_DOUBLE_BUFFER
+#    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
+#        error "WS2812_DOUBLE_BUFFER is not supported on WB32"
+#    endif
+#    define WS2812_FRAME_COUNT 2
+#else
+#    define WS2812_FRAME_COUNT 1
+#endif
 
-/* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
-/*
- * Gedanke: Double-buffer type transactions: double buffer transfers using two memory pointers for
- * the memory (while the DMA is reading/writing from/to a buffer, the application can
- * write/read to/from the other buffer).
+/**
+ * @brief   Buffers for a frame, one duty cycle per bit
+ *
+ * The reset period comes first, then each LED's bytes in the order they are sent, most significant bit first. With
+ * WS2812_DOUBLE_BUFFER, the DMA moves on to the other frame at the end of the one it's sending, so that the next
+ * frame can be drawn without tearing the one on the LEDs. The reset period being first means that the time it takes
+ * to switch over only ever comes out of the reset period.
  */
+static ws2812_buffer_t ws2812_frame_buffer[WS2812_FRAME_COUNT][WS2812_BIT_N + 1];
+static ws2812_frames_t ws2812_frames;
+
+#ifdef WS2812_DOUBLE_BUFFER
+// The frame for the DMA to switch to at the end of the current one, or NULL
+static ws2812_buffer_t *ws2812_next_frame = NULL;
+// Signalled by the DMA interrupt once it has switched frames
+static BSEMAPHORE_DECL(ws2812_frame_switched, true);
+
+// The switch happens within a frame's time, so anything past two means the DMA has stopped
+#    define WS2812_SWITCH_TIMEOUT TIME_US2I(2 * WS2812_BIT_N * WS2812_TIMING / 1000 + 1)
+#endif
+
+#if defined(WB32F3G71xx) || defined(WB32FQ95xx)
+#    define WS2812_DMA_MODE (WB32_DMA_CHCFG_HWHIF(WS2812_DMA_CHANNEL) | WB32_DMA_CHCFG_DIR_M2P | WB32_DMA_CHCFG_PSIZE_WORD | WB32_DMA_CHCFG_MSIZE_WORD | WB32_DMA_CHCFG_MINC | WB32_DMA_CHCFG_CIRC | WB32_DMA_CHCFG_TCIE | WB32_DMA_CHCFG_PL(3))
+#elif defined(WS2812_DOUBLE_BUFFER)
+#    define WS2812_DMA_MODE (STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | WS2812_DMA_PERIPHERAL_WIDTH | WS2812_DMA_MEMORY_WIDTH | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_TCIE | STM32_DMA_CR_PL(3))
+#else
+#    define WS2812_DMA_MODE (STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | WS2812_DMA_PERIPHERAL_WIDTH | WS2812_DMA_MEMORY_WIDTH | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3))
+#endif
+// M2P: Memory 2 Periph; PL: Priority Level
+
+/* --- PRIVATE FUNCTIONS ---------------------------------------------------- */
+
+#ifdef WS2812_DOUBLE_BUFFER
+/**
+ * @brief   Switches the DMA over to the next frame, once it reaches the end of the current one
+ */
+static void ws2812_dma_callback(void *param, uint32_t flags) {
+    (void)param;
+
+    ws2812_buffer_t *next = __atomic_load_n(&ws2812_next_frame, __ATOMIC_ACQUIRE);
+    if ((flags & STM32_DMA_ISR_TCIF) && next != NULL) {
+        // Disabling the stream clears its mode, so that has to be set again
+        dmaStreamDisable(WS2812_DMA_STREAM);
+        dmaStreamSetMemory0(WS2812_DMA_STREAM, next);
+        dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_BIT_N);
+        dmaStreamSetMode(WS2812_DMA_STREAM, WS2812_DMA_MODE);
+        dmaStreamEnable(WS2812_DMA_STREAM);
+        __atomic_store_n(&ws2812_next_frame, NULL, __ATOMIC_RELEASE);
+
+        chSysLockFromISR();
+        chBSemSignalI(&ws2812_frame_switched);
+        chSysUnlockFromISR();
+    }
+}
+#endif
+
+static void ws2812_encode_led(uint16_t led_number, const LED_TYPE* color) {
+    ws2812_buffer_t *bits = (ws2812_buffer_t *)ws2812_frames_draw(&ws2812_frames, led_number);
+    // The colour structs are laid out in the order the bytes are sent in
+    const uint8_t *bytes = (const uint8_t *)color;
+    for (uint8_t i = 0; i < WS2812_CHANNELS; i++) {
+        for (uint8_t mask = 0x80; mask; mask >>= 1) {
+            *bits++ = (bytes[i] & mask) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+        }
+    }
+}
+
+static void ws2812_ensure_init(void) {
+    static bool s_init = false;
+    if (!s_init) {
+        ws2812_init();
+        s_init = true;
+    }
+}
+
+// Gets the frame being drawn ready for the next LED
+static void ws2812_prepare(void) {
+    ws2812_ensure_init();
+#ifdef WS2812_DOUBLE_BUFFER
+    // Until the DMA has switched over, the frame to draw is still the one being sent. This thread sleeps until then,
+    // rather than spinning, and gives up if the DMA has stopped rather than hang. A signal can be left over from a
+    // switch nobody waited for, hence checking again.
+    while (__atomic_load_n(&ws2812_next_frame, __ATOMIC_ACQUIRE) != NULL) {
+        if (chBSemWaitTimeout(&ws2812_frame_switched, WS2812_SWITCH_TIMEOUT) == MSG_TIMEOUT) {
+            break;
+        }
+    }
+#endif
+    ws2812_frames_catch_up(&ws2812_frames);
+}
+
+/* --- PUBLIC FUNCTIONS ----------------------------------------------------- */
 
 void ws2812_init(void) {
     // Initialize led frame buffer
-    uint32_t i;
-    for (i = 0; i < WS2812_COLOR_BIT_N; i++)
-        ws2812_frame_buffer[i] = WS2812_DUTYCYCLE_0; // All color bits are zero duty cycle
-    for (i = 0; i < WS2812_RESET_BIT_N; i++)
-        ws2812_frame_buffer[i + WS2812_COLOR_BIT_N] = 0; // All reset bits are zero
+    for (uint8_t frame = 0; frame < WS2812_FRAME_COUNT; frame++) {
+        uint32_t i;
+        for (i = 0; i < WS2812_RESET_BIT_N; i++)
+            ws2812_frame_buffer[frame][i] = 0; // All reset bits are zero
+        for (i = 0; i < WS2812_COLOR_BIT_N; i++)
+            ws2812_frame_buffer[frame][i + WS2812_RESET_BIT_N] = WS2812_DUTYCYCLE_0; // All color bits are zero duty cycle
+    }
+    ws2812_frames_init(&ws2812_frames, &ws2812_frame_buffer[0][WS2812_RESET_BIT_N], &ws2812_frame_buffer[WS2812_FRAME_COUNT - 1][WS2812_RESET_BIT_N], WS2812_COLOR_BITS * sizeof(ws2812_buffer_t));
 
     palSetLineMode(RGB_DI_PIN, WS2812_OUTPUT_MODE);
 
@@ -330,17 +288,19 @@ void ws2812_init(void) {
     // dmaInit(); // Joe added this
 #if defined(WB32F3G71xx) || defined(WB32FQ95xx)
     dmaStreamAlloc(WS2812_DMA_STREAM - WB32_DMA_STREAM(0), 10, NULL, NULL);
-    dmaStreamSetSource(WS2812_DMA_STREAM, ws2812_frame_buffer);
+    dmaStreamSetSource(WS2812_DMA_STREAM, ws2812_frame_buffer[0]);
     dmaStreamSetDestination(WS2812_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1])); // Ziel ist der An-Zeit im Cap-Comp-Register
-    dmaStreamSetMode(WS2812_DMA_STREAM, WB32_DMA_CHCFG_HWHIF(WS2812_DMA_CHANNEL) | WB32_DMA_CHCFG_DIR_M2P | WB32_DMA_CHCFG_PSIZE_WORD | WB32_DMA_CHCFG_MSIZE_WORD | WB32_DMA_CHCFG_MINC | WB32_DMA_CHCFG_CIRC | WB32_DMA_CHCFG_TCIE | WB32_DMA_CHCFG_PL(3));
 #else
+#    ifdef WS2812_DOUBLE_BUFFER
+    dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, ws2812_dma_callback, NULL);
+#    else
     dmaStreamAlloc(WS2812_DMA_STREAM - STM32_DMA_STREAM(0), 10, NULL, NULL);
+#    endif
     dmaStreamSetPeripheral(WS2812_DMA_STREAM, &(WS2812_PWM_DRIVER.tim->CCR[WS2812_PWM_CHANNEL - 1])); // Ziel ist der An-Zeit im Cap-Comp-Register
-    dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffer);
-    dmaStreamSetMode(WS2812_DMA_STREAM, STM32_DMA_CR_CHSEL(WS2812_DMA_CHANNEL) | STM32_DMA_CR_DIR_M2P | WS2812_DMA_PERIPHERAL_WIDTH | WS2812_DMA_MEMORY_WIDTH | STM32_DMA_CR_MINC | STM32_DMA_CR_CIRC | STM32_DMA_CR_PL(3));
+    dmaStreamSetMemory0(WS2812_DMA_STREAM, ws2812_frame_buffer[0]);
 #endif
+    dmaStreamSetMode(WS2812_DMA_STREAM, WS2812_DMA_MODE);
     dmaStreamSetTransactionSize(WS2812_DMA_STREAM, WS2812_BIT_N);
-    // M2P: Memory 2 Periph; PL: Priority Level
 
 #if (STM32_DMA_SUPPORTS_DMAMUX == TRUE)
     // If the MCU has a DMAMUX we need to assign the correct resource
@@ -359,38 +319,34 @@ void ws2812_init(void) {
 }
 
 void ws2812_write_led(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b) {
-    // Write color to frame buffer
-    for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-    }
+    ws2812_prepare();
+    LED_TYPE color = {.r = r, .g = g, .b = b};
+    ws2812_encode_led(led_number, &color);
 }
+
 void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
-    // Write color to frame buffer
-    for (uint8_t bit = 0; bit < 8; bit++) {
-        ws2812_frame_buffer[WS2812_RED_BIT(led_number, bit)]   = ((r >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_GREEN_BIT(led_number, bit)] = ((g >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
-        ws2812_frame_buffer[WS2812_BLUE_BIT(led_number, bit)]  = ((b >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+    ws2812_prepare();
+    LED_TYPE color = {.r = r, .g = g, .b = b};
 #ifdef RGBW
-        ws2812_frame_buffer[WS2812_WHITE_BIT(led_number, bit)] = ((w >> bit) & 0x01) ? WS2812_DUTYCYCLE_1 : WS2812_DUTYCYCLE_0;
+    color.w = w;
+#endif
+    ws2812_encode_led(led_number, &color);
+}
+
+void ws2812_show(void) {
+    // Without a second frame, the DMA sends the one being drawn over and over, so there's nothing to do
+#ifdef WS2812_DOUBLE_BUFFER
+    ws2812_prepare();
+    uint8_t *frame = ws2812_frames_swap(&ws2812_frames);
+    __atomic_store_n(&ws2812_next_frame, (ws2812_buffer_t *)frame - WS2812_RESET_BIT_N, __ATOMIC_RELEASE);
 #endif
-    }
 }
 
 // Setleds for standard RGB
 void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
-    static bool s_init = false;
-    if (!s_init) {
-        ws2812_init();
-        s_init = true;
-    }
-
+    ws2812_prepare();
     for (uint16_t i = 0; i < leds; i++) {
-#ifdef RGBW
-        ws2812_write_led_rgbw(i, ledarray[i].r, ledarray[i].g, ledarray[i].b, ledarray[i].w);
-#else
-        ws2812_write_led(i, ledarray[i].r, ledarray[i].g, ledarray[i].b);
-#endif
+        ws2812_encode_led(i, &ledarray[i]);
     }
+    ws2812_show();
 }
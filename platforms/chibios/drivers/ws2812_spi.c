@@ -1,5 +1,6 @@
 #include "quantum.h"
 #include "ws2812.h"
+#include "ws2812_encode.h"
 
 /* Adapted from https://github.com/gamazeps/ws2812b-chibios-SPIDMA/ */
 
@@ -73,7 +74,7 @@
 #    define WS2812_SCK_OUTPUT_MODE PAL_MODE_ALTERNATE(WS2812_SPI_SCK_PAL_MODE) | PAL_OUTPUT_TYPE_PUSHPULL
 #endif
 
-#define BYTES_FOR_LED_BYTE 4
+#define BYTES_FOR_LED_BYTE WS2812_SPI_BYTES_PER_BYTE
 #ifdef RGBW
 #    define WS2812_CHANNELS 4
 #else
@@ -83,59 +84,51 @@
 #define DATA_SIZE (BYTES_FOR_LED * RGBLED_NUM)
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
+#define TXBUF_SIZE (PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE)
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
-
-/*
- * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
- */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
-}
-
-static void set_led_color_rgb(LED_TYPE color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
-
-#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
+// With a second buffer, the next frame can be drawn while the last one is still being sent
+#ifdef WS2812_DOUBLE_BUFFER
+#    if defined(WS2812_SPI_USE_CIRCULAR_BUFFER)
+#        error "WS2812_DOUBLE_BUFFER can't be used with WS2812_SPI_USE_CIRCULAR_BUFFER"
+#    endif
+#    define TXBUF_COUNT 2
+#else
+#    define TXBUF_COUNT 1
 #endif
-#ifdef RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 4 + j] = get_protocol_eq(color.w, j);
+
+static uint8_t txbuf[TXBUF_COUNT][TXBUF_SIZE] = {0};
+
+static ws2812_frames_t ws2812_frames;
+
+// Waits for the frame being sent to finish, so that its buffer can be drawn into
+static void ws2812_wait_sent(void) {
+#if !defined(WS2812_SPI_USE_CIRCULAR_BUFFER) && !defined(WS2812_SPI_SYNC)
+    osalSysLock();
+    if (WS2812_SPI.state == SPI_ACTIVE) {
+        _spi_wait_s(&WS2812_SPI);
+    }
+    osalSysUnlock();
 #endif
 }
 
+static void ws2812_encode_led(uint16_t led_number, const LED_TYPE* color) {
+    uint8_t* out = ws2812_frames_draw(&ws2812_frames, led_number);
+    // The colour structs are laid out in the order the bytes are sent in
+    const uint8_t* bytes = (const uint8_t*)color;
+    for (uint8_t i = 0; i < WS2812_CHANNELS; i++, out += BYTES_FOR_LED_BYTE) {
+        ws2812_spi_encode_byte(out, bytes[i]);
+    }
+}
+
 void ws2812_init(void) {
+    // Every LED starts off black in each buffer
+    for (uint8_t i = 0; i < TXBUF_COUNT; i++) {
+        for (uint16_t j = 0; j < RGBLED_NUM * WS2812_CHANNELS; j++) {
+            ws2812_spi_encode_byte(&txbuf[i][PREAMBLE_SIZE + j * BYTES_FOR_LED_BYTE], 0);
+        }
+    }
+    ws2812_frames_init(&ws2812_frames, &txbuf[0][PREAMBLE_SIZE], &txbuf[TXBUF_COUNT - 1][PREAMBLE_SIZE], BYTES_FOR_LED);
+
     palSetLineMode(RGB_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
 
 #ifdef WS2812_SPI_SCK_PIN
@@ -181,28 +174,67 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI, sizeof(txbuf) / sizeof(txbuf[0]), txbuf);
+    spiStartSend(&WS2812_SPI, TXBUF_SIZE, txbuf[0]);
 #endif
 }
 
-void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
+static void ws2812_ensure_init(void) {
     static bool s_init = false;
     if (!s_init) {
         ws2812_init();
         s_init = true;
     }
+}
 
-    for (uint8_t i = 0; i < leds; i++) {
-        set_led_color_rgb(ledarray[i], i);
-    }
+// Gets the frame being drawn ready for the next LED
+static void ws2812_prepare(void) {
+    ws2812_ensure_init();
+#ifndef WS2812_DOUBLE_BUFFER
+    // There's only the one buffer, so drawing into it while it's sent would tear the frame
+    ws2812_wait_sent();
+#endif
+    ws2812_frames_catch_up(&ws2812_frames);
+}
+
+void ws2812_write_led(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b) {
+    ws2812_prepare();
+    LED_TYPE color = {.r = r, .g = g, .b = b};
+    ws2812_encode_led(led_number, &color);
+}
 
-    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
-    // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
+void ws2812_write_led_rgbw(uint16_t led_number, uint8_t r, uint8_t g, uint8_t b, uint8_t w) {
+    ws2812_prepare();
+    LED_TYPE color = {.r = r, .g = g, .b = b};
+#ifdef RGBW
+    color.w = w;
+#endif
+    ws2812_encode_led(led_number, &color);
+}
+
+void ws2812_show(void) {
+    ws2812_ensure_init();
+    // The other buffer is only free once the previous frame has been sent
+    ws2812_wait_sent();
+    ws2812_frames_catch_up(&ws2812_frames);
+    uint8_t* frame = ws2812_frames_swap(&ws2812_frames) - PREAMBLE_SIZE;
+
+    // Send async - each led takes ~0.03ms, 50 leds ~1.5ms. The next frame waits for this one to finish before it
+    // touches a buffer that's still being sent.
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI, sizeof(txbuf) / sizeof(txbuf[0]), txbuf);
+    spiSend(&WS2812_SPI, TXBUF_SIZE, frame);
 #    else
-    spiStartSend(&WS2812_SPI, sizeof(txbuf) / sizeof(txbuf[0]), txbuf);
+    spiStartSend(&WS2812_SPI, TXBUF_SIZE, frame);
 #    endif
+#else
+    (void)frame;
 #endif
 }
+
+void ws2812_setleds(LED_TYPE* ledarray, uint16_t leds) {
+    ws2812_prepare();
+    for (uint16_t i = 0; i < leds; i++) {
+        ws2812_encode_led(i, &ledarray[i]);
+    }
+    ws2812_show();
+}
@@ -77,8 +77,9 @@ uint16_t timer_read(void) {
     return (uint16_t)timer_read32();
 }
 
-uint32_t timer_read32(void) {
-    chSysLock();
+// Get the ticks since timer_clear(), less the ticks already accounted for in ms_offset.
+// This function must be called from within a system lock zone (so that it can safely use and update the static data).
+static inline uint32_t get_timer_ticks(void) {
     uint32_t ticks = get_system_time_ticks() - ticks_offset;
     if (ticks < last_ticks) {
         // The 32-bit tick counter overflowed and wrapped around.  We cannot just extend the counter to 64 bits here,
@@ -91,13 +92,30 @@ uint32_t timer_read32(void) {
         ticks_offset += OVERFLOW_ADJUST_TICKS;
         ms_offset += OVERFLOW_ADJUST_MS;
     }
-    last_ticks              = ticks;
+    last_ticks = ticks;
+    return ticks;
+}
+
+uint32_t timer_read32(void) {
+    chSysLock();
+    uint32_t ticks          = get_timer_ticks();
     uint32_t ms_offset_copy = ms_offset; // read while still holding the lock to ensure a consistent value
     chSysUnlock();
 
     return (uint32_t)TIME_I2MS(ticks) + ms_offset_copy;
 }
 
+uint32_t timer_read_us(void) {
+    chSysLock();
+    uint32_t ticks          = get_timer_ticks();
+    uint32_t ms_offset_copy = ms_offset;
+    chSysUnlock();
+
+    // Resolution is that of the system tick, e.g. 100us with CH_CFG_ST_FREQUENCY = 10000; wraps around like the
+    // microseconds it counts, every ~71 minutes
+    return (uint32_t)((uint64_t)ticks * 1000000 / CH_CFG_ST_FREQUENCY) + ms_offset_copy * 1000;
+}
+
 uint16_t timer_elapsed(uint16_t last) {
     return TIMER_DIFF_16(timer_read(), last);
 }
@@ -22,6 +22,15 @@ void     eeprom_update_dword(uint32_t *__p, uint32_t __value);
 void     eeprom_update_block(const void *__src, void *__dst, size_t __n);
 #endif
 
+#if defined(EEPROM_WRITE_CACHE)
+#    if !defined(EEPROM_DRIVER)
+#        error EEPROM_WRITE_CACHE requires an EEPROM_DRIVER based EEPROM implementation.
+#    endif
+void eeprom_flush(void);
+void eeprom_cache_task(void);
+void eeprom_cache_discard(void);
+#endif
+
 #if defined(EEPROM_CUSTOM)
 #    ifndef EEPROM_SIZE
 #        error EEPROM_SIZE has not been defined for custom driver.
@@ -60,8 +69,8 @@ void     eeprom_update_block(const void *__src, void *__dst, size_t __n);
 #    define TOTAL_EEPROM_BYTE_COUNT 4096
 #elif defined(EEPROM_TEST_HARNESS)
 #    ifndef FLASH_STM32_MOCKED
-// Normal tests
-#        define TOTAL_EEPROM_BYTE_COUNT 32
+// Normal tests, sized like an ATmega32U4 so data stored past EECONFIG_SIZE stays in bounds
+#        define TOTAL_EEPROM_BYTE_COUNT 1024
 #    else
 // Flash wear-leveling testing
 #        include "eeprom_stm32_tests.h"
@@ -0,0 +1,101 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "eeprom.h"
+#include "timer.h"
+void advance_time(uint32_t ms);
+
+/* Not including eeprom_driver.h, as that would redirect the block calls below to the driver */
+void eeprom_driver_erase(void);
+void eeprom_driver_read_block(void *buf, const void *addr, size_t len);
+}
+
+/* Cache configuration (see rules.mk):
+ *   2 lines of 8 bytes, written back 100ms after the first change
+ */
+
+class EepromCacheTest : public testing::Test {
+   protected:
+    void SetUp() override {
+        eeprom_cache_discard();
+        eeprom_driver_erase();
+    }
+
+    uint8_t stored(uintptr_t addr) {
+        uint8_t value;
+        eeprom_driver_read_block(&value, (const void *)addr, 1);
+        return value;
+    }
+};
+
+TEST_F(EepromCacheTest, WritesAreDeferred) {
+    eeprom_write_byte((uint8_t *)10, 0x42);
+    EXPECT_EQ(stored(10), 0);
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)10), 0x42);
+
+    eeprom_cache_task();
+    EXPECT_EQ(stored(10), 0);
+
+    advance_time(100);
+    eeprom_cache_task();
+    EXPECT_EQ(stored(10), 0x42);
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)10), 0x42);
+}
+
+TEST_F(EepromCacheTest, AdjacentWritesAreCoalesced) {
+    eeprom_update_byte((uint8_t *)21, 0x21);
+    eeprom_update_byte((uint8_t *)20, 0x20);
+    eeprom_update_word((uint16_t *)22, 0x2322);
+    eeprom_update_dword((uint32_t *)24, 0x27262524);
+
+    /* A third range would need a line of its own, but all eight bytes share one */
+    eeprom_write_byte((uint8_t *)40, 0x40);
+    eeprom_write_byte((uint8_t *)60, 0x60);
+    EXPECT_EQ(stored(20), 0x20);
+    EXPECT_EQ(stored(27), 0x27);
+    EXPECT_EQ(stored(40), 0);
+    EXPECT_EQ(stored(60), 0);
+
+    eeprom_flush();
+    EXPECT_EQ(stored(40), 0x40);
+    EXPECT_EQ(stored(60), 0x60);
+}
+
+TEST_F(EepromCacheTest, ReadsOverlayDirtyLines) {
+    uint8_t data[6] = {1, 2, 3, 4, 5, 6};
+    uint8_t read[12];
+
+    eeprom_write_block(data, (void *)100, sizeof(data));
+    eeprom_write_byte((uint8_t *)107, 7);
+
+    eeprom_read_block(read, (void *)98, sizeof(read));
+    uint8_t expected[12] = {0, 0, 1, 2, 3, 4, 5, 6, 0, 7, 0, 0};
+    EXPECT_EQ(memcmp(read, expected, sizeof(read)), 0);
+}
+
+TEST_F(EepromCacheTest, LargeWritesStayCoherent) {
+    uint8_t data[16];
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        data[i] = 0x80 + i;
+    }
+
+    eeprom_write_byte((uint8_t *)130, 0x11);
+    eeprom_write_block(data, (void *)128, sizeof(data));
+    EXPECT_EQ(stored(128), 0x80);
+
+    /* The stale cached byte must not overwrite the newer data */
+    eeprom_flush();
+    EXPECT_EQ(stored(130), 0x82);
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)130), 0x82);
+}
+
+TEST_F(EepromCacheTest, DiscardDropsPendingWrites) {
+    eeprom_write_byte((uint8_t *)200, 0xAA);
+    eeprom_cache_discard();
+    eeprom_flush();
+    EXPECT_EQ(stored(200), 0);
+    EXPECT_EQ(eeprom_read_byte((uint8_t *)200), 0);
+}
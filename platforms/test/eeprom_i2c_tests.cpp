@@ -0,0 +1,189 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "eeprom.h"
+#include "eeprom_driver.h"
+#include "eeprom_i2c.h"
+#include "i2c_master.h"
+#include "timer.h"
+void advance_time(uint32_t ms);
+}
+
+/* Host-side simulation of an I2C EEPROM (see rules.mk for its geometry).
+ *
+ * Bus time is accounted for at 400kHz, and kept in step with the platform timer. A write cycle takes less than the
+ * datasheet's worst case EXTERNAL_EEPROM_WRITE_TIME, and the part ignores its address until the cycle completes.
+ * Page writes wrap around within the page, like the real thing.
+ */
+namespace {
+constexpr uint32_t BYTE_US        = 23;   // 9 bit times at 400kHz
+constexpr uint32_t WRITE_CYCLE_US = 1800; // typical, rather than maximum, write cycle time
+
+struct I2cEepromSimulator {
+    std::array<uint8_t, EXTERNAL_EEPROM_BYTE_COUNT> memory;
+
+    uint32_t pointer;
+    uint64_t busy_until;
+    uint32_t sub_ms;
+    uint32_t transactions;
+    uint32_t nacks;
+    uint32_t page_writes;
+
+    void reset() {
+        memory.fill(0);
+        pointer    = 0;
+        busy_until = 0;
+        sub_ms     = 0;
+        clear_stats();
+    }
+
+    void clear_stats() {
+        transactions = 0;
+        nacks        = 0;
+        page_writes  = 0;
+    }
+
+    uint64_t now() const {
+        return (uint64_t)timer_read32() * 1000 + sub_ms;
+    }
+
+    void spend(uint32_t us) {
+        sub_ms += us;
+        advance_time(sub_ms / 1000);
+        sub_ms %= 1000;
+    }
+
+    // Sends the address byte, returning whether the part acknowledged it
+    bool address(uint8_t addr) {
+        spend(BYTE_US);
+        EXPECT_EQ(addr, EXTERNAL_EEPROM_I2C_BASE_ADDRESS) << "Unexpected I2C address";
+        if (now() < busy_until) {
+            ++nacks;
+            return false;
+        }
+        ++transactions;
+        return true;
+    }
+} sim;
+} // namespace
+
+extern "C" void i2c_init(void) {}
+
+extern "C" i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    if (!sim.address(address)) {
+        return I2C_STATUS_ERROR;
+    }
+    sim.spend(length * BYTE_US);
+
+    EXPECT_GE(length, EXTERNAL_EEPROM_ADDRESS_SIZE) << "Transmission without a memory location";
+    EXPECT_LE(length, EXTERNAL_EEPROM_ADDRESS_SIZE + EXTERNAL_EEPROM_PAGE_SIZE) << "Transmission larger than a page";
+    sim.pointer = 0;
+    for (int i = 0; i < EXTERNAL_EEPROM_ADDRESS_SIZE; ++i) {
+        sim.pointer = (sim.pointer << 8) | data[i];
+    }
+
+    if (length > EXTERNAL_EEPROM_ADDRESS_SIZE) {
+        uint32_t page = sim.pointer - (sim.pointer % EXTERNAL_EEPROM_PAGE_SIZE);
+        for (int i = EXTERNAL_EEPROM_ADDRESS_SIZE; i < length; ++i) {
+            sim.memory[page + (sim.pointer % EXTERNAL_EEPROM_PAGE_SIZE)] = data[i];
+            sim.pointer                                                   = page + ((sim.pointer + 1) % EXTERNAL_EEPROM_PAGE_SIZE);
+        }
+        sim.busy_until = sim.now() + WRITE_CYCLE_US;
+        ++sim.page_writes;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+extern "C" i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    if (!sim.address(address)) {
+        return I2C_STATUS_ERROR;
+    }
+    sim.spend(length * BYTE_US);
+
+    for (uint16_t i = 0; i < length; ++i) {
+        data[i]     = sim.memory[sim.pointer];
+        sim.pointer = (sim.pointer + 1) % EXTERNAL_EEPROM_BYTE_COUNT;
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+class EepromI2cTest : public testing::Test {
+   protected:
+    void SetUp() override {
+        sim.reset();
+        eeprom_driver_init();
+        eeprom_driver_erase();
+        sim.clear_stats();
+    }
+};
+
+TEST_F(EepromI2cTest, UnalignedBlocksRoundTrip) {
+    uint8_t data[100];
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        data[i] = i + 1;
+    }
+
+    eeprom_write_block(data, (void*)20, sizeof(data));
+    EXPECT_EQ(sim.page_writes, 4);
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        EXPECT_EQ(sim.memory[20 + i], i + 1);
+    }
+    EXPECT_EQ(sim.memory[19], 0);
+    EXPECT_EQ(sim.memory[120], 0);
+
+    uint8_t read[100];
+    eeprom_read_block(read, (void*)20, sizeof(read));
+    EXPECT_EQ(memcmp(read, data, sizeof(data)), 0);
+}
+
+TEST_F(EepromI2cTest, BurstWritesPollForCompletion) {
+    uint8_t data[1024];
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = i * 7;
+    }
+
+    uint32_t start = timer_read32();
+    eeprom_write_block(data, (void*)0, sizeof(data));
+    uint32_t elapsed = timer_elapsed32(start);
+
+    // Waiting out the full write time after every page would have taken 32 * 5ms
+    EXPECT_EQ(sim.page_writes, sizeof(data) / EXTERNAL_EEPROM_PAGE_SIZE);
+    EXPECT_GT(sim.nacks, 0) << "Expected the driver to poll while the part was busy";
+    EXPECT_LT(elapsed, (sizeof(data) / EXTERNAL_EEPROM_PAGE_SIZE) * EXTERNAL_EEPROM_WRITE_TIME * 2 / 3);
+
+    // Reading straight afterwards has to wait for the last page to be written
+    EXPECT_EQ(eeprom_read_byte((const uint8_t*)1023), (uint8_t)(1023 * 7));
+}
+
+TEST_F(EepromI2cTest, SequentialReadsUseReadAhead) {
+    uint8_t data[512];
+    for (uint16_t i = 0; i < sizeof(data); ++i) {
+        data[i] = i ^ 0x5A;
+    }
+    eeprom_write_block(data, (void*)0, sizeof(data));
+    sim.clear_stats();
+
+    // Reload a keymap's worth of keycodes, a word at a time
+    for (uint16_t i = 0; i < 512; i += 2) {
+        EXPECT_EQ(eeprom_read_word((const uint16_t*)(uintptr_t)i), (uint16_t)(((uint8_t)((i + 1) ^ 0x5A)) << 8 | (uint8_t)(i ^ 0x5A)));
+    }
+
+    // One address write and one read per block, rather than per word
+    EXPECT_EQ(sim.transactions, 2 * 512 / EXTERNAL_EEPROM_READ_AHEAD_SIZE);
+}
+
+TEST_F(EepromI2cTest, ReadAheadStaysCoherent) {
+    EXPECT_EQ(eeprom_read_byte((const uint8_t*)100), 0);
+
+    eeprom_write_byte((uint8_t*)105, 0x42);
+    eeprom_write_word((uint16_t*)130, 0x1234);
+
+    EXPECT_EQ(eeprom_read_byte((const uint8_t*)105), 0x42);
+    EXPECT_EQ(eeprom_read_word((const uint16_t*)130), 0x1234);
+    EXPECT_EQ(sim.memory[105], 0x42);
+    EXPECT_EQ(sim.memory[131], 0x12);
+}
@@ -0,0 +1,165 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "i2c_master.h"
+#if defined(LED_DRIVER_TEST_IS31FL3733)
+#    include "is31fl3733.h"
+#    define LED_DRIVER(name) IS31FL3733_##name
+#elif defined(LED_DRIVER_TEST_IS31FL3737)
+#    include "is31fl3737.h"
+#    define LED_DRIVER(name) IS31FL3737_##name
+#elif defined(LED_DRIVER_TEST_CKLED2001)
+#    include "ckled2001.h"
+#    define LED_DRIVER(name) CKLED2001_##name
+#endif
+}
+
+/* Host-side simulation of the LED driver's register pages (see rules.mk for which driver is built).
+ *
+ * Writes to 0xFD select the page, and every other write lands on the selected page, auto-incrementing from the
+ * register given in its first byte. Transfers of a PWM block can be made to fail, in which case nothing is written.
+ */
+namespace {
+constexpr uint8_t ADDR            = 0x50;
+constexpr uint8_t PAGE_REGISTER   = 0xFD;
+constexpr uint8_t PAGE_LEDCONTROL = 0x00;
+constexpr uint8_t PAGE_PWM        = 0x01;
+
+struct LedDriverSimulator {
+    std::array<std::array<uint8_t, 256>, 4> pages;
+
+    uint8_t  page;
+    uint32_t pwm_transfers;
+    uint32_t control_writes;
+    uint32_t fail_after; // PWM block transfers to let through before failing
+    uint32_t fail_count; // PWM block transfers to fail after that
+
+    void reset() {
+        for (auto &p : pages) {
+            p.fill(0);
+        }
+        page       = 0;
+        fail_after = 0;
+        fail_count = 0;
+        clear_stats();
+    }
+
+    void clear_stats() {
+        pwm_transfers  = 0;
+        control_writes = 0;
+    }
+
+    bool transmit(const uint8_t *data, uint16_t length) {
+        if (data[0] == PAGE_REGISTER) {
+            page = data[1];
+            return true;
+        }
+        if (page == PAGE_PWM && length == 17) {
+            ++pwm_transfers;
+            if (fail_count > 0) {
+                if (fail_after == 0) {
+                    --fail_count;
+                    return false;
+                }
+                --fail_after;
+            }
+        }
+        if (page == PAGE_LEDCONTROL) {
+            ++control_writes;
+        }
+        for (uint16_t i = 1; i < length; i++) {
+            pages[page & 3][(uint8_t)(data[0] + i - 1)] = data[i];
+        }
+        return true;
+    }
+} sim;
+} // namespace
+
+extern "C" {
+// Each LED has its red, green and blue on the same column of PWM registers in the first, second and third 64
+#define LED(i) \
+    { 0, (i), 64 + (i), 128 + (i) }
+#define LEDS_8(i) LED(i), LED(i + 1), LED(i + 2), LED(i + 3), LED(i + 4), LED(i + 5), LED(i + 6), LED(i + 7)
+#if defined(LED_DRIVER_TEST_CKLED2001)
+const ckled2001_led PROGMEM g_ckled2001_leds[DRIVER_LED_TOTAL] = {
+#else
+const is31_led PROGMEM g_is31_leds[DRIVER_LED_TOTAL] = {
+#endif
+    LEDS_8(0), LEDS_8(8), LEDS_8(16), LEDS_8(24), LEDS_8(32), LEDS_8(40), LEDS_8(48), LEDS_8(56),
+};
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t *data, uint16_t length, uint16_t timeout) {
+    EXPECT_EQ(address, ADDR << 1) << "Unexpected I2C address";
+    return sim.transmit(data, length) ? I2C_STATUS_SUCCESS : I2C_STATUS_ERROR;
+}
+}
+
+class LedDriverI2c : public testing::Test {
+   protected:
+    void SetUp() override {
+        sim.reset();
+        // Bring the driver's buffers in line with the cleared registers
+        LED_DRIVER(set_color_all)(1, 1, 1);
+        LED_DRIVER(set_color_all)(0, 0, 0);
+        update();
+        sim.clear_stats();
+    }
+
+    void update() {
+        LED_DRIVER(update_pwm_buffers)(ADDR, 0);
+        LED_DRIVER(update_led_control_registers)(ADDR, 0);
+    }
+
+    void expect_color(uint8_t index, uint8_t r, uint8_t g, uint8_t b) {
+        EXPECT_EQ(sim.pages[PAGE_PWM][index], r) << "LED " << +index;
+        EXPECT_EQ(sim.pages[PAGE_PWM][64 + index], g) << "LED " << +index;
+        EXPECT_EQ(sim.pages[PAGE_PWM][128 + index], b) << "LED " << +index;
+    }
+};
+
+TEST_F(LedDriverI2c, OnlyDirtyBlocksAreSent) {
+    LED_DRIVER(set_color)(17, 1, 2, 3);
+    update();
+    EXPECT_EQ(sim.pwm_transfers, 3u);
+    expect_color(17, 1, 2, 3);
+
+    // Setting the same color again leaves nothing to send
+    sim.clear_stats();
+    LED_DRIVER(set_color)(17, 1, 2, 3);
+    update();
+    EXPECT_EQ(sim.pwm_transfers, 0u);
+}
+
+TEST_F(LedDriverI2c, FailedBlocksAreSentByTheNextUpdate) {
+    LED_DRIVER(set_color_all)(10, 20, 30);
+
+    // The third block fails, and the update gives up on the rest
+    sim.fail_after = 2;
+    sim.fail_count = 1;
+    update();
+    EXPECT_EQ(sim.pwm_transfers, 3u);
+    expect_color(0, 10, 0, 0);
+    expect_color(16, 10, 0, 0);
+    expect_color(32, 0, 0, 0);
+    // The failed transfer may have landed on the LED control page, so that is sent again
+    EXPECT_EQ(sim.control_writes, 24u);
+
+    // Only the blocks which weren't sent go out next time
+    sim.clear_stats();
+    update();
+    EXPECT_EQ(sim.pwm_transfers, 10u);
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        expect_color(i, 10, 20, 30);
+    }
+
+    sim.clear_stats();
+    update();
+    EXPECT_EQ(sim.pwm_transfers, 0u);
+    EXPECT_EQ(sim.control_writes, 0u);
+}
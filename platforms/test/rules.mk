@@ -23,3 +23,66 @@ eeprom_stm32_SRC := \
 	$(PLATFORM_PATH)/chibios/drivers/eeprom/eeprom_stm32.c
 eeprom_stm32_tiny_SRC := $(eeprom_stm32_SRC)
 eeprom_stm32_large_SRC := $(eeprom_stm32_SRC)
+
+eeprom_cache_DEFS := \
+	-DEEPROM_DRIVER \
+	-DEEPROM_TRANSIENT \
+	-DEEPROM_WRITE_CACHE \
+	-DTRANSIENT_EEPROM_SIZE=256 \
+	-DEEPROM_WRITE_CACHE_LINES=2 \
+	-DEEPROM_WRITE_CACHE_LINE_SIZE=8 \
+	-DEEPROM_WRITE_CACHE_TIMEOUT=100
+
+eeprom_cache_SRC := \
+	$(TOP_DIR)/drivers/eeprom/eeprom_driver.c \
+	$(TOP_DIR)/drivers/eeprom/eeprom_transient.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_cache_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+eeprom_i2c_DEFS := \
+	-DEEPROM_DRIVER \
+	-DEEPROM_I2C
+
+eeprom_i2c_INC := \
+	$(TOP_DIR)/drivers/eeprom \
+	$(PLATFORM_PATH)/chibios/drivers
+
+eeprom_i2c_SRC := \
+	$(TOP_DIR)/drivers/eeprom/eeprom_driver.c \
+	$(TOP_DIR)/drivers/eeprom/eeprom_i2c.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/eeprom_i2c_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+ws2812_encode_DEFS := \
+	-DRGBLED_NUM=37
+
+ws2812_encode_INC := \
+	$(PLATFORM_PATH)/chibios/drivers
+
+ws2812_encode_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/ws2812_encode_tests.cpp
+
+led_driver_i2c_DEFS := \
+	-DDRIVER_COUNT=1 \
+	-DDRIVER_LED_TOTAL=64
+
+led_driver_i2c_INC := \
+	$(TOP_DIR)/drivers/led \
+	$(TOP_DIR)/drivers/led/issi \
+	$(PLATFORM_PATH)/chibios/drivers
+
+led_driver_i2c_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/led_driver_i2c_tests.cpp \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c
+
+is31fl3733_i2c_DEFS := $(led_driver_i2c_DEFS) -DLED_DRIVER_TEST_IS31FL3733
+is31fl3733_i2c_INC := $(led_driver_i2c_INC)
+is31fl3733_i2c_SRC := $(led_driver_i2c_SRC) $(TOP_DIR)/drivers/led/issi/is31fl3733.c
+
+is31fl3737_i2c_DEFS := $(led_driver_i2c_DEFS) -DLED_DRIVER_TEST_IS31FL3737
+is31fl3737_i2c_INC := $(led_driver_i2c_INC)
+is31fl3737_i2c_SRC := $(led_driver_i2c_SRC) $(TOP_DIR)/drivers/led/issi/is31fl3737.c
+
+ckled2001_i2c_DEFS := $(led_driver_i2c_DEFS) -DLED_DRIVER_TEST_CKLED2001
+ckled2001_i2c_INC := $(led_driver_i2c_INC)
+ckled2001_i2c_SRC := $(led_driver_i2c_SRC) $(TOP_DIR)/drivers/led/ckled2001.c
@@ -1 +1 @@
-TEST_LIST += eeprom_stm32_tiny eeprom_stm32_large
+TEST_LIST += eeprom_stm32_tiny eeprom_stm32_large eeprom_cache eeprom_i2c ws2812_encode is31fl3733_i2c is31fl3737_i2c ckled2001_i2c
@@ -17,13 +17,16 @@
 #include "timer.h"
 
 static uint32_t current_time = 0;
+static uint32_t current_us   = 0;
 
 void timer_init(void) {
     current_time = 0;
+    current_us   = 0;
 }
 
 void timer_clear(void) {
     current_time = 0;
+    current_us   = 0;
 }
 
 uint16_t timer_read(void) {
@@ -32,6 +35,9 @@ uint16_t timer_read(void) {
 uint32_t timer_read32(void) {
     return current_time;
 }
+uint32_t timer_read_us(void) {
+    return current_time * 1000 + current_us;
+}
 uint16_t timer_elapsed(uint16_t last) {
     return TIMER_DIFF_16(timer_read(), last);
 }
@@ -41,10 +47,16 @@ uint32_t timer_elapsed32(uint32_t last) {
 
 void set_time(uint32_t t) {
     current_time = t;
+    current_us   = 0;
 }
 void advance_time(uint32_t ms) {
     current_time += ms;
 }
+void advance_time_us(uint32_t us) {
+    current_us += us;
+    current_time += current_us / 1000;
+    current_us %= 1000;
+}
 
 void wait_ms(uint32_t ms) {
     advance_time(ms);
@@ -0,0 +1,153 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "ws2812_encode.h"
+}
+
+/* Configuration (see rules.mk):
+ *   RGBLED_NUM 37, so that the last byte of drawn LEDs is only partly used
+ */
+
+#define CHANNELS 3
+#define LED_SIZE (CHANNELS * WS2812_SPI_BYTES_PER_BYTE)
+
+namespace {
+// How the SPI driver used to encode each pair of bits, one at a time
+uint8_t reference_spi_byte(uint8_t data, int pos) {
+    uint8_t eq = 0;
+    if (data & (1 << (2 * (3 - pos))))
+        eq = 0b1110;
+    else
+        eq = 0b1000;
+    if (data & (2 << (2 * (3 - pos))))
+        eq += 0b11100000;
+    else
+        eq += 0b10000000;
+    return eq;
+}
+
+uint32_t rng = 1;
+
+uint32_t random_number() {
+    // xorshift32
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+} // namespace
+
+TEST(Ws2812Encode, SpiMatchesBitByBit) {
+    for (uint16_t data = 0; data < 256; data++) {
+        uint8_t out[WS2812_SPI_BYTES_PER_BYTE];
+        ws2812_spi_encode_byte(out, data);
+        for (int pos = 0; pos < WS2812_SPI_BYTES_PER_BYTE; pos++) {
+            EXPECT_EQ(out[pos], reference_spi_byte(data, pos)) << "data " << data << ", byte " << pos;
+        }
+    }
+}
+
+TEST(Ws2812Encode, SpiSendsMostSignificantBitFirst) {
+    for (uint16_t data = 0; data < 256; data++) {
+        uint8_t out[WS2812_SPI_BYTES_PER_BYTE];
+        ws2812_spi_encode_byte(out, data);
+
+        // Every data bit is four SPI bits, high for three of them for a one and for one of them for a zero
+        uint8_t decoded = 0;
+        for (int bit = 0; bit < 8; bit++) {
+            uint8_t nibble = (out[bit / 2] >> (bit % 2 ? 0 : 4)) & 0x0F;
+            ASSERT_TRUE(nibble == 0b1110 || nibble == 0b1000) << "data " << data << ", bit " << bit;
+            decoded = (decoded << 1) | (nibble == 0b1110);
+        }
+        EXPECT_EQ(decoded, data);
+    }
+}
+
+class Ws2812Frames : public testing::Test {
+   protected:
+    uint8_t              buffers[2][RGBLED_NUM * LED_SIZE];
+    uint8_t              picture[RGBLED_NUM][CHANNELS];
+    ws2812_frames_t      frames;
+    std::vector<uint8_t> sent;
+
+    void SetUp() override {
+        memset(picture, 0, sizeof(picture));
+        for (uint8_t i = 0; i < 2; i++) {
+            for (uint16_t j = 0; j < RGBLED_NUM * CHANNELS; j++) {
+                ws2812_spi_encode_byte(&buffers[i][j * WS2812_SPI_BYTES_PER_BYTE], 0);
+            }
+        }
+    }
+
+    void draw(uint16_t led, uint8_t r, uint8_t g, uint8_t b) {
+        ws2812_frames_catch_up(&frames);
+        uint8_t *out = ws2812_frames_draw(&frames, led);
+        picture[led][0] = r;
+        picture[led][1] = g;
+        picture[led][2] = b;
+        for (uint8_t i = 0; i < CHANNELS; i++) {
+            ws2812_spi_encode_byte(&out[i * WS2812_SPI_BYTES_PER_BYTE], picture[led][i]);
+        }
+    }
+
+    void show() {
+        ws2812_frames_catch_up(&frames);
+        uint8_t *frame = ws2812_frames_swap(&frames);
+        sent.assign(frame, frame + RGBLED_NUM * LED_SIZE);
+    }
+
+    void expect_sent_picture() {
+        std::vector<uint8_t> expected(RGBLED_NUM * LED_SIZE);
+        for (uint16_t led = 0; led < RGBLED_NUM; led++) {
+            for (uint8_t i = 0; i < CHANNELS; i++) {
+                ws2812_spi_encode_byte(&expected[led * LED_SIZE + i * WS2812_SPI_BYTES_PER_BYTE], picture[led][i]);
+            }
+        }
+        ASSERT_EQ(sent, expected);
+    }
+
+    void draw_and_show_frames() {
+        for (int frame = 0; frame < 2000; frame++) {
+            // Mostly a few LEDs at a time, sometimes none, sometimes all of them
+            uint32_t choice = random_number();
+            uint16_t count  = choice % 16 == 0 ? RGBLED_NUM : choice % 5;
+            for (uint16_t i = 0; i < count; i++) {
+                uint32_t colour = random_number();
+                draw(count == RGBLED_NUM ? i : colour % RGBLED_NUM, colour >> 8, colour >> 16, colour >> 24);
+            }
+            show();
+            expect_sent_picture();
+            if (HasFailure()) {
+                FAIL() << "Sent the wrong picture in frame " << frame;
+            }
+        }
+    }
+};
+
+TEST_F(Ws2812Frames, DoubleBufferSendsWholePicture) {
+    ws2812_frames_init(&frames, buffers[0], buffers[1], LED_SIZE);
+    draw_and_show_frames();
+}
+
+TEST_F(Ws2812Frames, DoubleBufferNeverDrawsIntoFrameBeingSent) {
+    ws2812_frames_init(&frames, buffers[0], buffers[1], LED_SIZE);
+    for (int frame = 0; frame < 100; frame++) {
+        uint8_t *sending = frames.front;
+        std::vector<uint8_t> before(sending, sending + RGBLED_NUM * LED_SIZE);
+        draw(frame % RGBLED_NUM, frame, frame, frame);
+        draw((frame * 7) % RGBLED_NUM, 0, frame, 0);
+        EXPECT_EQ(std::vector<uint8_t>(sending, sending + RGBLED_NUM * LED_SIZE), before);
+        show();
+        EXPECT_NE(frames.front, sending);
+    }
+}
+
+TEST_F(Ws2812Frames, SingleBufferSendsWholePicture) {
+    ws2812_frames_init(&frames, buffers[0], buffers[0], LED_SIZE);
+    draw_and_show_frames();
+    EXPECT_EQ(frames.front, buffers[0]);
+}
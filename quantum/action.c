@@ -895,7 +895,7 @@ __attribute__((weak)) void register_code(uint8_t code) {
             // Force a new key press if the key is already pressed
             // without this, keys with the same keycode, but different
             // modifiers will be reported incorrectly, see issue #1708
-            if (is_key_pressed(keyboard_report, code)) {
+            if (has_key(code)) {
                 del_key(code);
                 send_keyboard_report();
             }
@@ -21,7 +21,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "action_layer.h"
 #include "timer.h"
 #include "keycode_config.h"
-#include <string.h>
 
 extern keymap_config_t keymap_config;
 
@@ -36,9 +35,40 @@ static uint8_t suppressed_mods    = 0;
 // report_keyboard_t keyboard_report = {};
 report_keyboard_t *keyboard_report = &(report_keyboard_t){};
 
-extern inline void add_key(uint8_t key);
-extern inline void del_key(uint8_t key);
-extern inline void clear_keys(void);
+// The keys in keyboard_report are filled in from here whenever it is sent
+static report_key_bitmap_t pressed_keys = {};
+
+/** \brief Add key
+ *
+ * Adds a key to the keyboard report, which takes effect on the next send_keyboard_report()
+ */
+void add_key(uint8_t key) {
+    key_bitmap_add(&pressed_keys, key);
+}
+
+/** \brief Del key
+ *
+ * Removes a key from the keyboard report, which takes effect on the next send_keyboard_report()
+ */
+void del_key(uint8_t key) {
+    key_bitmap_del(&pressed_keys, key);
+}
+
+/** \brief Clear keys
+ *
+ * Removes every key, but not the mods, from the keyboard report
+ */
+void clear_keys(void) {
+    key_bitmap_clear(&pressed_keys);
+}
+
+/** \brief Has key
+ *
+ * Returns true if the key has been added to the keyboard report, whether or not it has been sent yet
+ */
+bool has_key(uint8_t key) {
+    return key != KC_NO && key_bitmap_is_set(&pressed_keys, key);
+}
 
 #ifndef NO_ACTION_ONESHOT
 static uint8_t oneshot_mods        = 0;
@@ -245,6 +275,7 @@ bool is_oneshot_enabled(void) {
  * FIXME: needs doc
  */
 void send_keyboard_report(void) {
+    key_bitmap_to_report(&pressed_keys, keyboard_report);
     keyboard_report->mods = real_mods;
     keyboard_report->mods |= weak_mods;
 
@@ -257,7 +288,7 @@ void send_keyboard_report(void) {
         }
 #    endif
         keyboard_report->mods |= oneshot_mods;
-        if (has_anykey(keyboard_report)) {
+        if (pressed_keys.count) {
             clear_oneshot_mods();
         }
     }
@@ -270,17 +301,7 @@ void send_keyboard_report(void) {
     keyboard_report->mods |= weak_override_mods;
 #endif
 
-#ifdef PROTOCOL_VUSB
     host_keyboard_send(keyboard_report);
-#else
-    static report_keyboard_t last_report;
-
-    /* Only send the report if there are changes to propagate to the host. */
-    if (memcmp(keyboard_report, &last_report, sizeof(report_keyboard_t)) != 0) {
-        memcpy(&last_report, keyboard_report, sizeof(report_keyboard_t));
-        host_keyboard_send(keyboard_report);
-    }
-#endif
 }
 
 /** \brief Get mods
@@ -108,6 +108,49 @@ RGB hsv_to_rgb_nocie(HSV hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
 
+/* Which of v, p, q and t go to red, green and blue in each region of the hue, two bits each */
+#define HSV_REGION(r, g, b) ((r) | (g) << 2 | (b) << 4)
+enum { HSV_V, HSV_P, HSV_Q, HSV_T };
+static const uint8_t hsv_regions[7] = {
+    HSV_REGION(HSV_V, HSV_T, HSV_P), HSV_REGION(HSV_Q, HSV_V, HSV_P), HSV_REGION(HSV_P, HSV_V, HSV_T), HSV_REGION(HSV_P, HSV_Q, HSV_V), HSV_REGION(HSV_T, HSV_P, HSV_V), HSV_REGION(HSV_V, HSV_P, HSV_Q), HSV_REGION(HSV_V, HSV_T, HSV_P),
+};
+
+/* Gives the same results as hsv_to_rgb(), but without its division, which is done in software on AVR and Cortex-M0,
+ * or the switch on the region of the hue. */
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t h = hsv[i].h;
+        uint8_t s = hsv[i].s;
+#ifdef USE_CIE1931_CURVE
+        uint8_t v = pgm_read_byte(&CIE1931_CURVE[hsv[i].v]);
+#else
+        uint8_t v = hsv[i].v;
+#endif
+
+        if (s == 0) {
+            rgb[i].r = v;
+            rgb[i].g = v;
+            rgb[i].b = v;
+            continue;
+        }
+
+        // h * 6 / 255
+        uint8_t region    = (h >= 43) + (h >= 85) + (h >= 128) + (h >= 170) + (h >= 213) + (h == 255);
+        uint8_t remainder = (h * 2 - region * 85) * 3;
+
+        uint8_t values[4];
+        values[HSV_V] = v;
+        values[HSV_P] = (v * (255 - s)) >> 8;
+        values[HSV_Q] = (v * (255 - ((s * remainder) >> 8))) >> 8;
+        values[HSV_T] = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+
+        uint8_t order = hsv_regions[region];
+        rgb[i].r      = values[order & 3];
+        rgb[i].g      = values[(order >> 2) & 3];
+        rgb[i].b      = values[order >> 4];
+    }
+}
+
 #ifdef RGBW
 #    ifndef MIN
 #        define MIN(a, b) ((a) < (b) ? (a) : (b))
@@ -14,6 +14,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
+
 #include "keymap.h" // to get keymaps[][][]
 #include "eeprom.h"
 #include "progmem.h" // to read default from flash
@@ -173,9 +175,13 @@ void dynamic_keymap_reset(void) {
     }
 }
 
+#ifdef DYNAMIC_KEYMAP_BULK_TRANSFER
+static void bulk_merge_staged(uint8_t target, uint16_t offset, uint16_t size, uint8_t *data);
+#endif
+
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    void *   source                     = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
     uint8_t *target                     = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < dynamic_keymap_eeprom_size) {
@@ -186,19 +192,18 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         source++;
         target++;
     }
+#ifdef DYNAMIC_KEYMAP_BULK_TRANSFER
+    bulk_merge_staged(DYNAMIC_KEYMAP_BULK_KEYMAP, offset, size, data);
+#endif
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    if (offset >= dynamic_keymap_eeprom_size) return;
+    if (size > dynamic_keymap_eeprom_size - offset) {
+        size = dynamic_keymap_eeprom_size - offset;
     }
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset), size);
 }
 
 // This overrides the one in quantum/keymap_common.c
@@ -225,7 +230,7 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -236,18 +241,17 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
         source++;
         target++;
     }
+#ifdef DYNAMIC_KEYMAP_BULK_TRANSFER
+    bulk_merge_staged(DYNAMIC_KEYMAP_BULK_MACROS, offset, size, data);
+#endif
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    if (offset >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) return;
+    if (size > DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset) {
+        size = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - offset;
     }
+    eeprom_update_block(data, (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset), size);
 }
 
 void dynamic_keymap_macro_reset(void) {
@@ -259,6 +263,120 @@ void dynamic_keymap_macro_reset(void) {
     }
 }
 
+#ifdef DYNAMIC_KEYMAP_BULK_TRANSFER
+#    ifndef DYNAMIC_KEYMAP_BULK_BUFFER_SIZE
+#        define DYNAMIC_KEYMAP_BULK_BUFFER_SIZE 256
+#    endif
+
+static uint8_t  bulk_target = DYNAMIC_KEYMAP_BULK_NONE;
+static bool     bulk_ok;
+static uint16_t bulk_base;
+static uint16_t bulk_length;
+static uint8_t  bulk_buffer[DYNAMIC_KEYMAP_BULK_BUFFER_SIZE];
+
+static uint8_t *bulk_region_address(void) {
+    return (uint8_t *)(uintptr_t)(bulk_target == DYNAMIC_KEYMAP_BULK_MACROS ? DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR : DYNAMIC_KEYMAP_EEPROM_ADDR);
+}
+
+static uint16_t bulk_region_size(void) {
+    return bulk_target == DYNAMIC_KEYMAP_BULK_MACROS ? DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE : DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
+}
+
+// Writes the part of the staged run that differs from the EEPROM with a
+// single block write, and reads the run back.
+static void bulk_flush(void) {
+    if (bulk_length == 0) return;
+
+    uint8_t *address = bulk_region_address() + bulk_base;
+    uint16_t first   = 0;
+    uint16_t last    = bulk_length;
+    while (first < last && eeprom_read_byte(address + first) == bulk_buffer[first]) {
+        first++;
+    }
+    while (last > first && eeprom_read_byte(address + last - 1) == bulk_buffer[last - 1]) {
+        last--;
+    }
+    if (first < last) {
+        eeprom_write_block(&bulk_buffer[first], address + first, last - first);
+    }
+    for (uint16_t i = 0; i < bulk_length; i++) {
+        if (eeprom_read_byte(address + i) != bulk_buffer[i]) {
+            bulk_ok = false;
+            break;
+        }
+    }
+    bulk_length = 0;
+}
+
+// Replaces what was read from EEPROM with the chunks staged for it, so
+// that the host reads back what it uploaded before the commit.
+static void bulk_merge_staged(uint8_t target, uint16_t offset, uint16_t size, uint8_t *data) {
+    if (bulk_target != target || bulk_length == 0) return;
+
+    uint16_t begin = offset > bulk_base ? offset : bulk_base;
+    uint16_t end   = offset + size < bulk_base + bulk_length ? offset + size : bulk_base + bulk_length;
+    if (begin < end) {
+        memcpy(&data[begin - offset], &bulk_buffer[begin - bulk_base], end - begin);
+    }
+}
+
+bool dynamic_keymap_bulk_begin(uint8_t target) {
+    // Starting a new session drops the staged data of the old one. Runs it
+    // already wrote when the staging buffer filled up stay written.
+    bulk_target = target <= DYNAMIC_KEYMAP_BULK_MACROS ? target : DYNAMIC_KEYMAP_BULK_NONE;
+    bulk_ok     = true;
+    bulk_length = 0;
+    return bulk_target == target;
+}
+
+bool dynamic_keymap_bulk_write(uint8_t target, uint16_t offset, uint16_t size, const uint8_t *data) {
+    if (bulk_target == DYNAMIC_KEYMAP_BULK_NONE || bulk_target != target) return false;
+
+    uint16_t region_size = bulk_region_size();
+    if (offset >= region_size) return true;
+    if (size > region_size - offset) {
+        size = region_size - offset;
+    }
+
+    // Hosts upload the buffer front to back, so consecutive chunks are
+    // collected into one run and written once it is full or broken.
+    if (bulk_length > 0 && (offset != bulk_base + bulk_length || bulk_length + size > sizeof(bulk_buffer))) {
+        bulk_flush();
+    }
+    if (size > sizeof(bulk_buffer)) {
+        eeprom_write_block(data, bulk_region_address() + offset, size);
+        return true;
+    }
+    if (bulk_length == 0) {
+        bulk_base = offset;
+    }
+    memcpy(&bulk_buffer[bulk_length], data, size);
+    bulk_length += size;
+    return true;
+}
+
+bool dynamic_keymap_bulk_commit(uint16_t *checksum) {
+    if (bulk_target == DYNAMIC_KEYMAP_BULK_NONE) return false;
+
+    bulk_flush();
+
+    // Fletcher-16 over the committed region, so the host can compare it
+    // against the data it sent without reading everything back.
+    uint8_t *address = bulk_region_address();
+    uint16_t size    = bulk_region_size();
+    uint16_t sum1 = 0, sum2 = 0;
+    for (uint16_t i = 0; i < size; i++) {
+        sum1 = (sum1 + eeprom_read_byte(address + i)) % 255;
+        sum2 = (sum2 + sum1) % 255;
+    }
+    *checksum = (sum2 << 8) | sum1;
+
+    bool ok     = bulk_ok;
+    bulk_target = DYNAMIC_KEYMAP_BULK_NONE;
+    return ok;
+}
+#endif // DYNAMIC_KEYMAP_BULK_TRANSFER
+
 void dynamic_keymap_macro_send(uint8_t id) {
     if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
         return;
@@ -290,6 +408,10 @@ void dynamic_keymap_macro_send(uint8_t id) {
         ++p;
     }
 
+#ifdef SEND_STRING_ASYNC_QUEUE
+    // Queue the macro, it is typed out from keyboard_task()
+    send_string_async_eeprom_macro(p, DYNAMIC_KEYMAP_MACRO_DELAY);
+#else
     // Send the macro string one or three chars at a time
     // by making temporary 1 or 3 char strings
     char data[4] = {0, 0, 0, 0};
@@ -314,4 +436,5 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
     }
+#endif
 }
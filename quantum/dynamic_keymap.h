@@ -62,3 +62,34 @@ void     dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t
 void     dynamic_keymap_macro_reset(void);
 
 void dynamic_keymap_macro_send(uint8_t id);
+
+#ifdef DYNAMIC_KEYMAP_BULK_TRANSFER
+// Bulk transfer sessions stage the chunks written through
+// dynamic_keymap_bulk_write() in RAM and write consecutive chunks to
+// EEPROM with one eeprom_write_block() call, covering just the bytes that
+// changed, instead of one EEPROM write for every 28 byte raw HID packet.
+// Every block is read back once written, and reading the buffer during a
+// session returns the staged chunks.
+//
+// dynamic_keymap_bulk_begin() starts a session for the keymap or the macro
+// buffer (DYNAMIC_KEYMAP_BULK_NONE aborts the current one), and
+// dynamic_keymap_bulk_commit() writes whatever is still staged. It returns
+// false if any block did not verify, and sets checksum to the Fletcher-16
+// of the whole target region as stored in EEPROM.
+//
+// A session is only atomic while everything uploaded fits in the
+// DYNAMIC_KEYMAP_BULK_BUFFER_SIZE byte staging buffer as one run. A run is
+// written as soon as it is full, or the host skips to another offset, and
+// aborting drops the chunks that are still staged, but not the runs that
+// were already written. A host that aborts a larger upload has to upload
+// the whole region again to get back to a known state.
+enum dynamic_keymap_bulk_target {
+    DYNAMIC_KEYMAP_BULK_NONE = 0,
+    DYNAMIC_KEYMAP_BULK_KEYMAP,
+    DYNAMIC_KEYMAP_BULK_MACROS,
+};
+
+bool dynamic_keymap_bulk_begin(uint8_t target);
+bool dynamic_keymap_bulk_write(uint8_t target, uint16_t offset, uint16_t size, const uint8_t *data);
+bool dynamic_keymap_bulk_commit(uint16_t *checksum);
+#endif
@@ -90,6 +90,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef EEPROM_DRIVER
 #    include "eeprom_driver.h"
 #endif
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+#    include "wear_leveling.h"
+#endif
 #if defined(CRC_ENABLE)
 #    include "crc.h"
 #endif
@@ -410,6 +413,9 @@ void keyboard_init(void) {
     // init after split init
     pointing_device_init();
 #endif
+#ifdef KEY_OVERRIDE_ENABLE
+    key_override_init();
+#endif
 
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
@@ -464,6 +470,13 @@ static bool matrix_task(void) {
 
     matrix_scan_perf_task();
 
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_QUEUE)
+    // Changes are kept in the matrix until the queued character is typed out, so that its modifiers don't apply to them
+    if (send_string_async_typing()) {
+        matrix_changed = false;
+    }
+#endif
+
     // Short-circuit the complete matrix processing if it is not necessary
     if (!matrix_changed) {
         generate_tick_event();
@@ -541,6 +554,14 @@ void quantum_task(void) {
     key_override_task();
 #endif
 
+#if defined(LEADER_ENABLE) && defined(LEADER_SEQUENCE_COUNT)
+    leader_task();
+#endif
+
+#if defined(SEND_STRING_ENABLE) && defined(SEND_STRING_ASYNC_QUEUE)
+    send_string_task();
+#endif
+
 #ifdef SEQUENCER_ENABLE
     sequencer_task();
 #endif
@@ -671,4 +692,12 @@ void keyboard_task(void) {
 #endif
 
     led_task();
+
+#ifdef EEPROM_WRITE_CACHE
+    eeprom_cache_task();
+#endif
+
+#if defined(WEAR_LEVELING_ENABLE) && defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+    wear_leveling_task();
+#endif
 }
@@ -17,6 +17,10 @@
 
 /* Author: Wojciech Siewierski < wojciech dot siewierski at onet dot pl > */
 #include "process_dynamic_macro.h"
+#ifdef DYNAMIC_MACRO_EEPROM_ADDR
+#    include <stddef.h>
+#    include "eeprom.h"
+#endif
 
 // default feedback method
 void dynamic_macro_led_blink(void) {
@@ -52,13 +56,192 @@ __attribute__((weak)) void dynamic_macro_record_end_user(int8_t direction) {
 #define DYNAMIC_MACRO_CURRENT_LENGTH(BEGIN, POINTER) ((int)(direction * ((POINTER) - (BEGIN))))
 #define DYNAMIC_MACRO_CURRENT_CAPACITY(BEGIN, END2) ((int)(direction * ((END2) - (BEGIN)) + 1))
 
+#ifdef DYNAMIC_MACRO_COMPACT
+/* Compact event encoding. Every event starts with a header holding the
+ * pressed state, a flag telling whether a tap state byte follows and
+ * the key index (row * MATRIX_COLS + col). Small matrices fit the
+ * index in the 6 low bits of a single byte, larger ones use a second
+ * byte for 14 bits in total. Positions outside of the matrix (combos,
+ * encoders) use the all-ones escape index followed by the raw row and
+ * column. The bytes of an event are laid out in the direction the
+ * macro grows, so both macros can be decoded front to back.
+ *
+ *   header [index low] [row col [keycode]] [tap] [delay]
+ */
+#    define DM_HEADER_PRESSED 0x80
+#    define DM_HEADER_TAP 0x40
+#    if MATRIX_ROWS * MATRIX_COLS < 0x3F
+#        define DM_INDEX_ESCAPE 0x3F
+#    else
+#        define DM_INDEX_WIDE
+#        define DM_INDEX_ESCAPE 0x3FFF
+_Static_assert(MATRIX_ROWS * MATRIX_COLS < DM_INDEX_ESCAPE, "Matrix too large for DYNAMIC_MACRO_COMPACT");
+#    endif
+#    define DM_MAX_EVENT_SIZE 8
+
+#    ifdef DYNAMIC_MACRO_RECORD_TIMING
+#        ifndef DYNAMIC_MACRO_TIMING_RESOLUTION
+#            define DYNAMIC_MACRO_TIMING_RESOLUTION 8
+#        endif
+static uint16_t dm_last_event_time;
+#    endif
+
+/**
+ * Encode a single key event.
+ *
+ * @param[out] event  Buffer of at least DM_MAX_EVENT_SIZE bytes.
+ * @param[in]  record The key event to encode.
+ * @return The number of bytes used.
+ */
+static uint8_t dynamic_macro_encode(uint8_t *event, keyrecord_t *record) {
+    keypos_t key   = record->event.key;
+    uint8_t  len   = 0;
+    uint16_t index = DM_INDEX_ESCAPE;
+    uint8_t  tap   = 0;
+
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        index = key.row * MATRIX_COLS + key.col;
+    }
+#    ifndef NO_ACTION_TAPPING
+    memcpy(&tap, &record->tap, sizeof(tap));
+#    endif
+
+#    ifdef DM_INDEX_WIDE
+    event[len++] = (record->event.pressed ? DM_HEADER_PRESSED : 0) | (tap ? DM_HEADER_TAP : 0) | (index >> 8);
+    event[len++] = index & 0xFF;
+#    else
+    event[len++] = (record->event.pressed ? DM_HEADER_PRESSED : 0) | (tap ? DM_HEADER_TAP : 0) | index;
+#    endif
+    if (index == DM_INDEX_ESCAPE) {
+        event[len++] = key.row;
+        event[len++] = key.col;
+#    ifdef COMBO_ENABLE
+        event[len++] = record->keycode & 0xFF;
+        event[len++] = record->keycode >> 8;
+#    endif
+    }
+    if (tap) {
+        event[len++] = tap;
+    }
+#    ifdef DYNAMIC_MACRO_RECORD_TIMING
+    uint16_t delay = TIMER_DIFF_16(record->event.time, dm_last_event_time) / DYNAMIC_MACRO_TIMING_RESOLUTION;
+    event[len++]   = delay > UINT8_MAX ? UINT8_MAX : delay;
+    dm_last_event_time = record->event.time;
+#    endif
+
+    return len;
+}
+
+static inline uint8_t dynamic_macro_read_byte(dynamic_macro_cell_t **macro_pointer, int8_t direction) {
+    uint8_t value = **macro_pointer;
+    *macro_pointer += direction;
+    return value;
+}
+
+/* Saved macros may be stale or damaged, so decoding stops at the
+ * first event that runs past the end of the macro or does not make
+ * sense.
+ */
+static bool dynamic_macro_read_invalid(dynamic_macro_cell_t **macro_pointer, dynamic_macro_cell_t *macro_end) {
+    dprintln("dynamic macro: stopping at a truncated or invalid event");
+    *macro_pointer = macro_end;
+    return false;
+}
+#endif
+
+/**
+ * Decode the event at the macro iterator and advance it past the event.
+ *
+ * @param[in,out] macro_pointer The buffer position of the event.
+ * @param[in]     macro_end     The element after the last macro buffer element.
+ * @param[in]     direction     Either +1 or -1, which way to iterate the buffer.
+ * @param[out]    record        The decoded key event.
+ * @param[out]    delay         The delay in milliseconds recorded before the event.
+ * @return false if the event does not fit before macro_end or is not valid,
+ *         in which case macro_pointer is moved to macro_end.
+ */
+static bool dynamic_macro_read_event(dynamic_macro_cell_t **macro_pointer, dynamic_macro_cell_t *macro_end, int8_t direction, keyrecord_t *record, uint16_t *delay) {
+    *delay = 0;
+    if (*macro_pointer == macro_end) {
+        return false;
+    }
+#ifdef DYNAMIC_MACRO_COMPACT
+    int     available = direction * (macro_end - *macro_pointer);
+    uint8_t size      = 1;
+
+#    ifdef DM_INDEX_WIDE
+    size = 2;
+#    endif
+    if (available < size) {
+        return dynamic_macro_read_invalid(macro_pointer, macro_end);
+    }
+
+    uint8_t  header = dynamic_macro_read_byte(macro_pointer, direction);
+    uint16_t index  = header & DM_INDEX_ESCAPE;
+
+#    ifdef DM_INDEX_WIDE
+    index = (uint16_t)(header & 0x3F) << 8 | dynamic_macro_read_byte(macro_pointer, direction);
+#    endif
+
+    // Check the whole event is there before reading the rest of it
+    if (index == DM_INDEX_ESCAPE) {
+        size += 2;
+#    ifdef COMBO_ENABLE
+        size += 2;
+#    endif
+    } else if (index >= MATRIX_ROWS * MATRIX_COLS) {
+        return dynamic_macro_read_invalid(macro_pointer, macro_end);
+    }
+    if (header & DM_HEADER_TAP) {
+        size++;
+    }
+#    ifdef DYNAMIC_MACRO_RECORD_TIMING
+    size++;
+#    endif
+    if (available < size) {
+        return dynamic_macro_read_invalid(macro_pointer, macro_end);
+    }
+
+    memset(record, 0, sizeof(keyrecord_t));
+    record->event.pressed = header & DM_HEADER_PRESSED;
+    record->event.time    = timer_read() | 1;
+    if (index == DM_INDEX_ESCAPE) {
+        record->event.key.row = dynamic_macro_read_byte(macro_pointer, direction);
+        record->event.key.col = dynamic_macro_read_byte(macro_pointer, direction);
+#    ifdef COMBO_ENABLE
+        record->keycode = dynamic_macro_read_byte(macro_pointer, direction);
+        record->keycode |= (uint16_t)dynamic_macro_read_byte(macro_pointer, direction) << 8;
+#    endif
+    } else {
+        record->event.key.row = index / MATRIX_COLS;
+        record->event.key.col = index % MATRIX_COLS;
+    }
+    if (header & DM_HEADER_TAP) {
+        uint8_t tap = dynamic_macro_read_byte(macro_pointer, direction);
+#    ifndef NO_ACTION_TAPPING
+        memcpy(&record->tap, &tap, sizeof(tap));
+#    else
+        (void)tap;
+#    endif
+    }
+#    ifdef DYNAMIC_MACRO_RECORD_TIMING
+    *delay = dynamic_macro_read_byte(macro_pointer, direction) * DYNAMIC_MACRO_TIMING_RESOLUTION;
+#    endif
+    return true;
+#else
+    *record = **macro_pointer;
+    *macro_pointer += direction;
+    return true;
+#endif
+}
+
 /**
  * Start recording of the dynamic macro.
  *
  * @param[out] macro_pointer The new macro buffer iterator.
  * @param[in]  macro_buffer  The macro buffer used to initialize macro_pointer.
  */
-void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_buffer) {
+void dynamic_macro_record_start(dynamic_macro_cell_t **macro_pointer, dynamic_macro_cell_t *macro_buffer) {
     dprintln("dynamic macro recording: started");
 
     dynamic_macro_record_start_user();
@@ -66,6 +249,9 @@ void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_
     clear_keyboard();
     layer_clear();
     *macro_pointer = macro_buffer;
+#ifdef DYNAMIC_MACRO_RECORD_TIMING
+    dm_last_event_time = timer_read();
+#endif
 }
 
 /**
@@ -75,17 +261,21 @@ void dynamic_macro_record_start(keyrecord_t **macro_pointer, keyrecord_t *macro_
  * @param macro_end[in]    The element after the last macro buffer element.
  * @param direction[in]    Either +1 or -1, which way to iterate the buffer.
  */
-void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_t direction) {
+void dynamic_macro_play(dynamic_macro_cell_t *macro_buffer, dynamic_macro_cell_t *macro_end, int8_t direction) {
     dprintf("dynamic macro: slot %d playback\n", DYNAMIC_MACRO_CURRENT_SLOT());
 
     layer_state_t saved_layer_state = layer_state;
+    keyrecord_t   record;
 
     clear_keyboard();
     layer_clear();
 
-    while (macro_buffer != macro_end) {
-        process_record(macro_buffer);
-        macro_buffer += direction;
+    uint16_t delay;
+    while (dynamic_macro_read_event(&macro_buffer, macro_end, direction, &record, &delay)) {
+        if (delay) {
+            wait_ms(delay);
+        }
+        process_record(&record);
 #ifdef DYNAMIC_MACRO_DELAY
         wait_ms(DYNAMIC_MACRO_DELAY);
 #endif
@@ -107,7 +297,7 @@ void dynamic_macro_play(keyrecord_t *macro_buffer, keyrecord_t *macro_end, int8_
  * @param direction[in]  Either +1 or -1, which way to iterate the buffer.
  * @param record[in]     The current keypress.
  */
-void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_pointer, keyrecord_t *macro2_end, int8_t direction, keyrecord_t *record) {
+void dynamic_macro_record_key(dynamic_macro_cell_t *macro_buffer, dynamic_macro_cell_t **macro_pointer, dynamic_macro_cell_t *macro2_end, int8_t direction, keyrecord_t *record) {
     /* If we've just started recording, ignore all the key releases. */
     if (!record->event.pressed && *macro_pointer == macro_buffer) {
         dprintln("dynamic macro: ignoring a leading key-up event");
@@ -117,12 +307,26 @@ void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_poi
     /* The other end of the other macro is the last buffer element it
      * is safe to use before overwriting the other macro.
      */
+#ifdef DYNAMIC_MACRO_COMPACT
+    uint8_t event[DM_MAX_EVENT_SIZE];
+    uint8_t len = dynamic_macro_encode(event, record);
+
+    if (DYNAMIC_MACRO_CURRENT_CAPACITY(*macro_pointer, macro2_end) >= len) {
+        for (uint8_t i = 0; i < len; i++) {
+            **macro_pointer = event[i];
+            *macro_pointer += direction;
+        }
+    } else {
+        dynamic_macro_record_key_user(direction, record);
+    }
+#else
     if (*macro_pointer - direction != macro2_end) {
         **macro_pointer = *record;
         *macro_pointer += direction;
     } else {
         dynamic_macro_record_key_user(direction, record);
     }
+#endif
 
     dprintf("dynamic macro: slot %d length: %d/%d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, *macro_pointer), DYNAMIC_MACRO_CURRENT_CAPACITY(macro_buffer, macro2_end));
 }
@@ -131,21 +335,122 @@ void dynamic_macro_record_key(keyrecord_t *macro_buffer, keyrecord_t **macro_poi
  * End recording of the dynamic macro. Essentially just update the
  * pointer to the end of the macro.
  */
-void dynamic_macro_record_end(keyrecord_t *macro_buffer, keyrecord_t *macro_pointer, int8_t direction, keyrecord_t **macro_end) {
+void dynamic_macro_record_end(dynamic_macro_cell_t *macro_buffer, dynamic_macro_cell_t *macro_pointer, int8_t direction, dynamic_macro_cell_t **macro_end) {
     dynamic_macro_record_end_user(direction);
 
     /* Do not save the keys being held when stopping the recording,
      * i.e. the keys used to access the layer DYN_REC_STOP is on.
+     * Events can only be decoded front to back, so find the end of
+     * the last key-up event; everything after it is a key-down.
      */
-    while (macro_pointer != macro_buffer && (macro_pointer - direction)->event.pressed) {
-        dprintln("dynamic macro: trimming a trailing key-down event");
-        macro_pointer -= direction;
+    dynamic_macro_cell_t *last_release_end = macro_buffer;
+    dynamic_macro_cell_t *iterator         = macro_buffer;
+    keyrecord_t           record;
+    uint16_t              delay;
+
+    while (dynamic_macro_read_event(&iterator, macro_pointer, direction, &record, &delay)) {
+        if (!record.event.pressed) {
+            last_release_end = iterator;
+        }
+    }
+    if (last_release_end != macro_pointer) {
+        dprintln("dynamic macro: trimming trailing key-down events");
+    }
+
+    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, last_release_end));
+
+    *macro_end = last_release_end;
+}
+
+#ifdef DYNAMIC_MACRO_EEPROM_ADDR
+/* Persistent copy of the macro buffer:
+ *
+ *   header (10 bytes) | buffer image
+ *
+ * The header records the format the image was written in, and the
+ * image is only restored if it matches the current build. Only the
+ * used parts of the image are written, using update semantics so
+ * unchanged bytes are not rewritten.
+ */
+typedef struct {
+    uint16_t magic;
+    uint8_t  format;      // DM_EEPROM_VERSION and the DM_FORMAT_* flags
+    uint8_t  matrix_rows; // compact events store keys as an index into the matrix
+    uint8_t  matrix_cols;
+    uint8_t  cell_size; // sizeof(dynamic_macro_cell_t)
+    uint16_t length[2];
+} dynamic_macro_eeprom_header_t;
+
+#    define DM_EEPROM_MAGIC (uint16_t)0xD4AD
+#    define DM_EEPROM_VERSION 1
+#    define DM_FORMAT_COMPACT 0x01
+#    define DM_FORMAT_RECORD_TIMING 0x02
+#    define DM_FORMAT_COMBO 0x04
+#    define DM_FORMAT_NO_TAPPING 0x08
+
+#    ifdef DYNAMIC_MACRO_COMPACT
+#        define DM_FORMAT_COMPACT_FLAG DM_FORMAT_COMPACT
+#    else
+#        define DM_FORMAT_COMPACT_FLAG 0
+#    endif
+#    ifdef DYNAMIC_MACRO_RECORD_TIMING
+#        define DM_FORMAT_RECORD_TIMING_FLAG DM_FORMAT_RECORD_TIMING
+#    else
+#        define DM_FORMAT_RECORD_TIMING_FLAG 0
+#    endif
+#    ifdef COMBO_ENABLE
+#        define DM_FORMAT_COMBO_FLAG DM_FORMAT_COMBO
+#    else
+#        define DM_FORMAT_COMBO_FLAG 0
+#    endif
+#    ifdef NO_ACTION_TAPPING
+#        define DM_FORMAT_NO_TAPPING_FLAG DM_FORMAT_NO_TAPPING
+#    else
+#        define DM_FORMAT_NO_TAPPING_FLAG 0
+#    endif
+#    define DM_EEPROM_FORMAT (DM_EEPROM_VERSION << 4 | DM_FORMAT_COMPACT_FLAG | DM_FORMAT_RECORD_TIMING_FLAG | DM_FORMAT_COMBO_FLAG | DM_FORMAT_NO_TAPPING_FLAG)
+
+#    define DM_EEPROM_HEADER ((dynamic_macro_eeprom_header_t *)(DYNAMIC_MACRO_EEPROM_ADDR))
+#    define DM_EEPROM_IMAGE ((dynamic_macro_cell_t *)(DYNAMIC_MACRO_EEPROM_ADDR + sizeof(dynamic_macro_eeprom_header_t)))
+
+static void dynamic_macro_eeprom_header(dynamic_macro_eeprom_header_t *header) {
+    header->magic       = DM_EEPROM_MAGIC;
+    header->format      = DM_EEPROM_FORMAT;
+    header->matrix_rows = MATRIX_ROWS;
+    header->matrix_cols = MATRIX_COLS;
+    header->cell_size   = sizeof(dynamic_macro_cell_t);
+}
+
+static void dynamic_macro_load(dynamic_macro_cell_t *macro_buffer, dynamic_macro_cell_t **macro_end, dynamic_macro_cell_t **r_macro_end) {
+    dynamic_macro_eeprom_header_t header, expected;
+
+    eeprom_read_block(&header, DM_EEPROM_HEADER, sizeof(header));
+    dynamic_macro_eeprom_header(&expected);
+    if (memcmp(&header, &expected, offsetof(dynamic_macro_eeprom_header_t, length)) != 0) {
+        dprintln("dynamic macro: no saved macros in the current format");
+        return;
+    }
+    if ((uint32_t)header.length[0] + header.length[1] > DYNAMIC_MACRO_SIZE) {
+        return;
     }
+    eeprom_read_block(macro_buffer, DM_EEPROM_IMAGE, header.length[0] * sizeof(dynamic_macro_cell_t));
+    eeprom_read_block(macro_buffer + DYNAMIC_MACRO_SIZE - header.length[1], DM_EEPROM_IMAGE + DYNAMIC_MACRO_SIZE - header.length[1], header.length[1] * sizeof(dynamic_macro_cell_t));
+    *macro_end   = macro_buffer + header.length[0];
+    *r_macro_end = macro_buffer + DYNAMIC_MACRO_SIZE - 1 - header.length[1];
+}
+
+static void dynamic_macro_save(dynamic_macro_cell_t *macro_buffer, dynamic_macro_cell_t *macro_end, dynamic_macro_cell_t *r_macro_end) {
+    dynamic_macro_eeprom_header_t header;
 
-    dprintf("dynamic macro: slot %d saved, length: %d\n", DYNAMIC_MACRO_CURRENT_SLOT(), DYNAMIC_MACRO_CURRENT_LENGTH(macro_buffer, macro_pointer));
+    dynamic_macro_eeprom_header(&header);
+    header.length[0] = macro_end - macro_buffer;
+    header.length[1] = macro_buffer + DYNAMIC_MACRO_SIZE - 1 - r_macro_end;
 
-    *macro_end = macro_pointer;
+    eeprom_update_block(macro_buffer, DM_EEPROM_IMAGE, header.length[0] * sizeof(dynamic_macro_cell_t));
+    eeprom_update_block(macro_buffer + DYNAMIC_MACRO_SIZE - header.length[1], DM_EEPROM_IMAGE + DYNAMIC_MACRO_SIZE - header.length[1], header.length[1] * sizeof(dynamic_macro_cell_t));
+    eeprom_update_block(&header, DM_EEPROM_HEADER, sizeof(header));
 }
+#endif
 
 /* Handle the key events related to the dynamic macros. Should be
  * called from process_record_user() like this:
@@ -182,28 +487,37 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
      * macros or one long macro and one short macro. Or even one empty
      * and one using the whole buffer.
      */
-    static keyrecord_t macro_buffer[DYNAMIC_MACRO_SIZE];
+    static dynamic_macro_cell_t macro_buffer[DYNAMIC_MACRO_SIZE];
 
     /* Pointer to the first buffer element after the first macro.
      * Initially points to the very beginning of the buffer since the
      * macro is empty. */
-    static keyrecord_t *macro_end = macro_buffer;
+    static dynamic_macro_cell_t *macro_end = macro_buffer;
 
     /* The other end of the macro buffer. Serves as the beginning of
      * the second macro. */
-    static keyrecord_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
+    static dynamic_macro_cell_t *const r_macro_buffer = macro_buffer + DYNAMIC_MACRO_SIZE - 1;
 
     /* Like macro_end but for the second macro. */
-    static keyrecord_t *r_macro_end = r_macro_buffer;
+    static dynamic_macro_cell_t *r_macro_end = r_macro_buffer;
 
     /* A persistent pointer to the current macro position (iterator)
      * used during the recording. */
-    static keyrecord_t *macro_pointer = NULL;
+    static dynamic_macro_cell_t *macro_pointer = NULL;
 
     /* 0   - no macro is being recorded right now
      * 1,2 - either macro 1 or 2 is being recorded */
     static uint8_t macro_id = 0;
 
+#ifdef DYNAMIC_MACRO_EEPROM_ADDR
+    static bool macros_loaded = false;
+
+    if (!macros_loaded) {
+        dynamic_macro_load(macro_buffer, &macro_end, &r_macro_end);
+        macros_loaded = true;
+    }
+#endif
+
     if (macro_id == 0) {
         /* No macro recording in progress. */
         if (!record->event.pressed) {
@@ -242,6 +556,9 @@ bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record) {
                             dynamic_macro_record_end(r_macro_buffer, macro_pointer, -1, &r_macro_end);
                             break;
                     }
+#ifdef DYNAMIC_MACRO_EEPROM_ADDR
+                    dynamic_macro_save(macro_buffer, macro_end, r_macro_end);
+#endif
                     macro_id = 0;
                 }
                 return false;
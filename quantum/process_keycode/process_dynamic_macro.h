@@ -33,6 +33,17 @@
 #    define DYNAMIC_MACRO_SIZE 128
 #endif
 
+/* With DYNAMIC_MACRO_COMPACT the buffer holds encoded events instead
+ * of whole key records and DYNAMIC_MACRO_SIZE is counted in bytes. A
+ * plain key event takes one byte on matrices with fewer than 63 keys
+ * and two bytes on larger ones.
+ */
+#ifdef DYNAMIC_MACRO_COMPACT
+typedef uint8_t dynamic_macro_cell_t;
+#else
+typedef keyrecord_t dynamic_macro_cell_t;
+#endif
+
 void dynamic_macro_led_blink(void);
 bool process_dynamic_macro(uint16_t keycode, keyrecord_t *record);
 void dynamic_macro_record_start_user(void);
@@ -26,6 +26,14 @@
 #    define KEY_OVERRIDE_REPEAT_DELAY 500
 #endif
 
+// Maximum number of overrides covered by the trigger lookup index. Larger override lists fall back to a linear scan.
+#ifndef KEY_OVERRIDE_INDEX_SIZE
+#    define KEY_OVERRIDE_INDEX_SIZE 32
+#endif
+#if KEY_OVERRIDE_INDEX_SIZE > 254
+#    error "KEY_OVERRIDE_INDEX_SIZE must not exceed 254"
+#endif
+
 // For benchmarking the time it takes to call process_key_override on every key press (needs keyboard debugging enabled as well)
 // #define BENCH_KEY_OVERRIDE
 
@@ -84,6 +92,13 @@ static bool enabled = true;
 // Public variables
 __attribute__((weak)) const key_override_t **key_overrides = NULL;
 
+// Lookup index. Holds the positions of all overrides within `key_overrides`, sorted by trigger keycode and then by position, so that all overrides sharing a trigger form one contiguous run that preserves the declaration order. The trigger of each position is kept alongside, so that entries replaced or edited in place are noticed and the index rebuilt before it is used.
+static const key_override_t **indexed_overrides = NULL;
+static bool                   index_valid       = false;
+static uint8_t                index_count       = 0;
+static uint8_t                override_index[KEY_OVERRIDE_INDEX_SIZE];
+static uint16_t               index_triggers[KEY_OVERRIDE_INDEX_SIZE];
+
 // Forward decls
 static const key_override_t *clear_active_override(const bool allow_reregister);
 
@@ -110,6 +125,84 @@ bool key_override_is_enabled(void) {
     return enabled;
 }
 
+void key_override_init(void) {
+    indexed_overrides = key_overrides;
+    index_valid       = false;
+    index_count       = 0;
+
+    if (key_overrides == NULL) {
+        return;
+    }
+
+    for (uint8_t i = 0;; i++) {
+        const key_override_t *const override = key_overrides[i];
+
+        if (override == NULL) {
+            break;
+        }
+
+        if (i >= KEY_OVERRIDE_INDEX_SIZE) {
+            key_override_printf("Too many key overrides for index, falling back to linear scan\n");
+            return;
+        }
+
+        // Insertion sort by trigger. Entries with an equal trigger stay in declaration order since i is always the largest position so far.
+        uint8_t j = i;
+        while (j > 0 && index_triggers[j - 1] > override->trigger) {
+            override_index[j] = override_index[j - 1];
+            index_triggers[j] = index_triggers[j - 1];
+            j--;
+        }
+        override_index[j] = i;
+        index_triggers[j] = override->trigger;
+        index_count       = i + 1;
+    }
+
+    index_valid = true;
+}
+
+/** Whether `key_overrides` still holds the same number of entries with the same triggers as when the index was built. Costs a comparison per entry, which is much cheaper than trying every override. */
+static bool index_is_current(void) {
+    if (key_overrides != indexed_overrides) {
+        return false;
+    }
+
+    if (!index_valid) {
+        // Too many overrides for the index, or key_overrides is NULL. Adding entries in place doesn't make room, so this stays a linear scan.
+        return true;
+    }
+
+    for (uint8_t i = 0; i < index_count; i++) {
+        const key_override_t *const override = key_overrides[override_index[i]];
+        if (override == NULL || override->trigger != index_triggers[i]) {
+            return false;
+        }
+    }
+
+    return key_overrides[index_count] == NULL;
+}
+
+/** Finds the run of index entries whose override has the given trigger. Sets begin == end if there is none. */
+static void find_trigger_range(const uint16_t trigger, uint8_t *begin, uint8_t *end) {
+    uint8_t lo = 0;
+    uint8_t hi = index_count;
+
+    while (lo < hi) {
+        const uint8_t mid = lo + (hi - lo) / 2;
+        if (index_triggers[mid] < trigger) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    *begin = lo;
+    while (lo < index_count && index_triggers[lo] == trigger) {
+        lo++;
+    }
+    *end = lo;
+}
+
 // Returns whether the modifiers that are pressed are such that the override should activate
 static bool key_override_matches_active_modifiers(const key_override_t *override, const uint8_t mods) {
     // Check that negative keys pass
@@ -243,141 +336,204 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_overrides == NULL) {
-        return true;
+/** Tries activating a single override. Returns true if the override was activated, in which case `send_key_action` is set to whether the key action for `keycode` should be sent. */
+static bool try_activating_single_override(const key_override_t *const override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *send_key_action) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0;; i++) {
-        const key_override_t *const override = key_overrides[i];
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
-        }
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
-        }
+    // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
+    const bool no_trigger = override->trigger == KC_NO;
 
-        const bool is_trigger = override->trigger == keycode;
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
-        }
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
-        }
+    // Check if trigger key is down.
+    const bool trigger_down = is_trigger && key_down;
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
-        }
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required, yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    if (!should_activate) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
 
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    key_override_printf("Activating override\n");
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+    clear_active_override(false);
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
-            continue;
+    active_override                 = override;
+    active_override_trigger_is_down = true;
+
+    set_suppressed_override_mods(override->suppressed_mods);
+
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_KEY(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
         }
+    }
 
-        key_override_printf("Activating override\n");
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
 
-        clear_active_override(false);
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
 
-        set_suppressed_override_mods(override->suppressed_mods);
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_KEY(override->trigger)) {
-                del_key(override->trigger);
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_KEY(mod_free_replacement)) {
+                add_key(mod_free_replacement);
             } else {
-                unregister_code(override->trigger);
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                wait_ms(10);
+                register_code(mod_free_replacement);
             }
         }
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
+    }
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    *send_key_action = !trigger_down;
+
+    return true;
+}
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+/** Tries activating the overrides that could possibly activate for this event, in declaration order, until one activates or none are left. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    bool send_key_action = true;
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
-        }
+    *activated = false;
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
+    if (key_overrides == NULL) {
+        return true;
+    }
 
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
-            } else {
-                if (IS_KEY(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
-                }
+    if (!index_is_current()) {
+        key_override_init();
+    }
+
+    if (!index_valid) {
+        for (uint8_t i = 0;; i++) {
+            const key_override_t *const override = key_overrides[i];
+
+            // End of array
+            if (override == NULL) {
+                break;
+            }
+
+            if (try_activating_single_override(override, keycode, layer, key_down, is_mod, active_mods, &send_key_action)) {
+                *activated = true;
+                return send_key_action;
             }
-        } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
         }
 
-        *activated = true;
+        return true;
+    }
+
+    // An override can only activate if its trigger was just pressed, is the last non-mod key that was pressed down, or if it has no trigger at all. Gather the index runs for these triggers.
+    const uint16_t triggers[3] = {keycode, last_key_down, KC_NO};
+    uint8_t        begin[3];
+    uint8_t        end[3];
+    uint8_t        num_ranges = 0;
 
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+    for (uint8_t t = 0; t < 3; t++) {
+        bool duplicate = false;
+        for (uint8_t r = 0; r < t; r++) {
+            duplicate |= triggers[r] == triggers[t];
+        }
+        if (duplicate) {
+            continue;
+        }
+
+        find_trigger_range(triggers[t], &begin[num_ranges], &end[num_ranges]);
+        if (begin[num_ranges] != end[num_ranges]) {
+            num_ranges++;
+        }
     }
 
-    *activated = false;
+    // Merge the runs so that candidates are tried in declaration order, the same as a linear scan would.
+    while (true) {
+        uint8_t next = 0xFF;
+        uint8_t pick = 0;
+
+        for (uint8_t r = 0; r < num_ranges; r++) {
+            if (begin[r] != end[r] && override_index[begin[r]] < next) {
+                next = override_index[begin[r]];
+                pick = r;
+            }
+        }
+
+        if (next == 0xFF) {
+            break;
+        }
+
+        begin[pick]++;
+
+        if (try_activating_single_override(key_overrides[next], keycode, layer, key_down, is_mod, active_mods, &send_key_action)) {
+            *activated = true;
+            return send_key_action;
+        }
+    }
 
     return true;
 }
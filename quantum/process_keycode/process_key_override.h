@@ -103,6 +103,9 @@ void key_override_toggle(void);
 /** Returns whether key overrides are enabled */
 bool key_override_is_enabled(void);
 
+/** Builds the trigger lookup index for `key_overrides`. Called on init, and again automatically on the next key event if `key_overrides` is reassigned or its entries or their triggers change */
+void key_override_init(void);
+
 /** Handling of key overrides and its implemented keycodes */
 bool process_key_override(const uint16_t keycode, const keyrecord_t *const record);
 
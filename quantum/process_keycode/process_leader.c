@@ -23,6 +23,10 @@
 #        define LEADER_TIMEOUT 300
 #    endif
 
+#    ifdef LEADER_SEQUENCE_COUNT
+#        include "progmem.h"
+#    endif
+
 __attribute__((weak)) void leader_start(void) {}
 
 __attribute__((weak)) void leader_end(void) {}
@@ -34,6 +38,116 @@ uint16_t leader_time = 0;
 uint16_t leader_sequence[5]   = {0, 0, 0, 0, 0};
 uint8_t  leader_sequence_size = 0;
 
+#    ifdef LEADER_SEQUENCE_COUNT
+#        if LEADER_SEQUENCE_COUNT > 255
+#            error "LEADER_SEQUENCE_COUNT must not exceed 255"
+#        endif
+/*
+ * `trie_order` holds the positions of the `leader_sequences` table sorted by keys, which makes it an implicit trie: all
+ * sequences that share a prefix form one contiguous run, and a shorter sequence sorts before every sequence it is a prefix
+ * of (KC_NO terminates the keys and is the smallest keycode). Matching keeps the run of sequences that still agree with
+ * the keys typed so far, and narrows it with every key.
+ */
+static uint8_t trie_order[LEADER_SEQUENCE_COUNT];
+static bool    trie_sorted = false;
+static uint8_t trie_begin  = 0;
+static uint8_t trie_end    = 0;
+static uint8_t trie_depth  = 0;
+
+static inline uint16_t leader_table_key(uint8_t position, uint8_t depth) {
+    return depth < LEADER_SEQUENCE_MAX_LENGTH ? pgm_read_word(&leader_sequences[position].keys[depth]) : KC_NO;
+}
+
+static inline uint16_t leader_sequence_key(uint8_t index, uint8_t depth) {
+    return leader_table_key(trie_order[index], depth);
+}
+
+static bool leader_table_less(uint8_t a, uint8_t b) {
+    for (uint8_t depth = 0; depth < LEADER_SEQUENCE_MAX_LENGTH; depth++) {
+        uint16_t key_a = leader_table_key(a, depth);
+        uint16_t key_b = leader_table_key(b, depth);
+        if (key_a != key_b) {
+            return key_a < key_b;
+        }
+        if (key_a == KC_NO) {
+            break;
+        }
+    }
+    return false;
+}
+
+/** Sorts the table positions by keys. The sort is stable, so of two identical sequences the first declared one fires. */
+static void leader_sequences_sort(void) {
+    for (uint8_t i = 0; i < LEADER_SEQUENCE_COUNT; i++) {
+        uint8_t j = i;
+        while (j > 0 && leader_table_less(i, trie_order[j - 1])) {
+            trie_order[j] = trie_order[j - 1];
+            j--;
+        }
+        trie_order[j] = i;
+    }
+    trie_sorted = true;
+}
+
+static void leader_sequence_finish(int16_t match) {
+    leading = false;
+    if (match >= 0) {
+        void (*action)(void) = (void (*)(void))pgm_read_ptr(&leader_sequences[trie_order[match]].action);
+        if (action) {
+            action();
+        }
+    }
+    leader_end();
+}
+
+/** Narrows the candidate run to the sequences continuing with `keycode`. Fires the sequence as soon as it is the only candidate left. */
+static void leader_sequence_advance(uint16_t keycode) {
+    uint8_t begin = trie_begin;
+    while (begin < trie_end && leader_sequence_key(begin, trie_depth) != keycode) {
+        begin++;
+    }
+    uint8_t end = begin;
+    while (end < trie_end && leader_sequence_key(end, trie_depth) == keycode) {
+        end++;
+    }
+
+    if (begin == end || keycode == KC_NO) {
+        // No declared sequence starts with the keys typed so far. Keep leading until the timeout, so that sequences
+        // checked in matrix_scan_user can still match.
+        trie_end = trie_begin;
+        return;
+    }
+
+    trie_begin = begin;
+    trie_end   = end;
+    trie_depth++;
+
+    // The exact match, if any, is always the first entry of the run
+    if (trie_end - trie_begin == 1 && leader_sequence_key(trie_begin, trie_depth) == KC_NO) {
+        leader_sequence_finish(trie_begin);
+    }
+}
+
+bool leader_sequence_matched(void) {
+    return trie_depth > 0 && trie_begin < trie_end && leader_sequence_key(trie_begin, trie_depth) == KC_NO;
+}
+
+void leader_task(void) {
+    if (!leading) {
+        return;
+    }
+#        ifdef LEADER_NO_TIMEOUT
+    if (leader_sequence_size == 0) {
+        return;
+    }
+#        endif
+    if (timer_elapsed(leader_time) > LEADER_TIMEOUT) {
+        // Fire the longest sequence typed so far, if it exists
+        leader_sequence_finish(leader_sequence_matched() ? trie_begin : -1);
+    }
+}
+#    endif
+
 void qk_leader_start(void) {
     if (leading) {
         return;
@@ -43,6 +157,14 @@ void qk_leader_start(void) {
     leader_time          = timer_read();
     leader_sequence_size = 0;
     memset(leader_sequence, 0, sizeof(leader_sequence));
+#    ifdef LEADER_SEQUENCE_COUNT
+    if (!trie_sorted) {
+        leader_sequences_sort();
+    }
+    trie_begin = 0;
+    trie_end   = LEADER_SEQUENCE_COUNT;
+    trie_depth = 0;
+#    endif
 }
 
 bool process_leader(uint16_t keycode, keyrecord_t *record) {
@@ -58,6 +180,17 @@ bool process_leader(uint16_t keycode, keyrecord_t *record) {
                     keycode = keycode & 0xFF;
                 }
 #    endif // LEADER_KEY_STRICT_KEY_PROCESSING
+#    ifdef LEADER_SEQUENCE_COUNT
+                // Sequences may be longer than leader_sequence, which only records the first keys
+                if (leader_sequence_size < (sizeof(leader_sequence) / sizeof(leader_sequence[0]))) {
+                    leader_sequence[leader_sequence_size] = keycode;
+                    leader_sequence_size++;
+                }
+#        ifdef LEADER_PER_KEY_TIMING
+                leader_time = timer_read();
+#        endif
+                leader_sequence_advance(keycode);
+#    else
                 if (leader_sequence_size < (sizeof(leader_sequence) / sizeof(leader_sequence[0]))) {
                     leader_sequence[leader_sequence_size] = keycode;
                     leader_sequence_size++;
@@ -66,8 +199,9 @@ bool process_leader(uint16_t keycode, keyrecord_t *record) {
                     leader_end();
                     return true;
                 }
-#    ifdef LEADER_PER_KEY_TIMING
+#        ifdef LEADER_PER_KEY_TIMING
                 leader_time = timer_read();
+#        endif
 #    endif
                 return false;
             }
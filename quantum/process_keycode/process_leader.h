@@ -24,6 +24,34 @@ void leader_start(void);
 void leader_end(void);
 void qk_leader_start(void);
 
+#ifdef LEADER_SEQUENCE_COUNT
+#    ifndef LEADER_SEQUENCE_MAX_LENGTH
+#        define LEADER_SEQUENCE_MAX_LENGTH 8
+#    endif
+
+/** A leader sequence and the action fired when it is typed. Shorter sequences are terminated by KC_NO. */
+typedef struct {
+    uint16_t keys[LEADER_SEQUENCE_MAX_LENGTH];
+    void (*action)(void);
+} leader_sequence_t;
+
+/** Define this as a PROGMEM array of LEADER_SEQUENCE_COUNT sequences, in any order. */
+extern const leader_sequence_t leader_sequences[LEADER_SEQUENCE_COUNT];
+
+#    define LEADER_SEQ(action_fn, ...) \
+        { .keys = {__VA_ARGS__}, .action = (action_fn) }
+
+/** Returns whether the keys typed so far are exactly a sequence of the table, which fires on timeout */
+bool leader_sequence_matched(void);
+
+void leader_task(void);
+
+// Sequences in matrix_scan_user are only checked if the table does not have a match of its own
+#    define LEADER_SEQUENCE_UNMATCHED() !leader_sequence_matched()
+#else
+#    define LEADER_SEQUENCE_UNMATCHED() true
+#endif
+
 #define SEQ_ONE_KEY(key) if (leader_sequence[0] == (key) && leader_sequence[1] == 0 && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
 #define SEQ_TWO_KEYS(key1, key2) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == 0 && leader_sequence[3] == 0 && leader_sequence[4] == 0)
 #define SEQ_THREE_KEYS(key1, key2, key3) if (leader_sequence[0] == (key1) && leader_sequence[1] == (key2) && leader_sequence[2] == (key3) && leader_sequence[3] == 0 && leader_sequence[4] == 0)
@@ -37,7 +65,7 @@ void qk_leader_start(void);
     extern uint8_t  leader_sequence_size
 
 #ifdef LEADER_NO_TIMEOUT
-#    define LEADER_DICTIONARY() if (leading && leader_sequence_size > 0 && timer_elapsed(leader_time) > LEADER_TIMEOUT)
+#    define LEADER_DICTIONARY() if (leading && leader_sequence_size > 0 && timer_elapsed(leader_time) > LEADER_TIMEOUT && LEADER_SEQUENCE_UNMATCHED())
 #else
-#    define LEADER_DICTIONARY() if (leading && timer_elapsed(leader_time) > LEADER_TIMEOUT)
+#    define LEADER_DICTIONARY() if (leading && timer_elapsed(leader_time) > LEADER_TIMEOUT && LEADER_SEQUENCE_UNMATCHED())
 #endif
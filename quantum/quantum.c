@@ -36,6 +36,10 @@
 #    include "haptic.h"
 #endif
 
+#ifdef EEPROM_WRITE_CACHE
+#    include "eeprom.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -154,6 +158,9 @@ void shutdown_quantum(void) {
 #ifdef HAPTIC_ENABLE
     haptic_shutdown();
 #endif
+#ifdef EEPROM_WRITE_CACHE
+    eeprom_flush();
+#endif
 }
 
 void reset_keyboard(void) {
@@ -458,6 +465,9 @@ __attribute__((weak)) void shutdown_user() {}
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#ifdef EEPROM_WRITE_CACHE
+    eeprom_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
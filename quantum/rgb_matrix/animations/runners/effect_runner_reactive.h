@@ -7,7 +7,8 @@ typedef HSV (*reactive_f)(HSV hsv, uint16_t offset);
 bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint16_t max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+    uint16_t           max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+    rgb_matrix_batch_t batch    = {0};
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         uint16_t tick = max_tick;
@@ -20,10 +21,52 @@ bool effect_runner_reactive(effect_params_t* params, reactive_f effect_func) {
         }
 
         uint16_t offset = scale16by8(tick, qadd8(rgb_matrix_config.speed, 1));
-        RGB      rgb    = rgb_matrix_hsv_to_rgb(effect_func(rgb_matrix_config.hsv, offset));
-        rgb_matrix_set_color(i, rgb.r, rgb.g, rgb.b);
+        rgb_matrix_batch_add(&batch, i, effect_func(rgb_matrix_config.hsv, offset));
     }
+    rgb_matrix_batch_flush(&batch);
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+#    ifdef RGB_MATRIX_SPARSE_UPDATES
+// Only renders the LEDs that are being reacted to, whose hit expired since the previous frame, or that something else
+// has written since the previous frame. For effects that depend on nothing but the configured colour, speed and the key hits.
+bool effect_runner_reactive_sparse(effect_params_t* params, reactive_f effect_func) {
+    // LEDs that were drawn for a hit, so they are drawn once more at their final value when it expires
+    static uint8_t hit_leds[(DRIVER_LED_TOTAL + 7) / 8];
+
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint16_t           max_tick = 65535 / qadd8(rgb_matrix_config.speed, 1);
+    rgb_matrix_batch_t batch    = {0};
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+        bool     hit  = false;
+        uint16_t tick = max_tick;
+        // Reverse search to find most recent key hit
+        for (int8_t j = g_last_hit_tracker.count - 1; j >= 0; j--) {
+            if (g_last_hit_tracker.index[j] == i && g_last_hit_tracker.tick[j] < tick) {
+                tick = g_last_hit_tracker.tick[j];
+                hit  = true;
+                break;
+            }
+        }
+        uint8_t bit     = 1 << (i % 8);
+        bool    was_hit = hit_leds[i / 8] & bit;
+        if (hit) {
+            hit_leds[i / 8] |= bit;
+        } else {
+            hit_leds[i / 8] &= ~bit;
+        }
+        if (!hit && !was_hit && !rgb_matrix_led_needs_render(params, i)) {
+            continue;
+        }
+
+        uint16_t offset = scale16by8(tick, qadd8(rgb_matrix_config.speed, 1));
+        rgb_matrix_batch_add(&batch, i, effect_func(rgb_matrix_config.hsv, offset));
+    }
+    rgb_matrix_batch_flush(&batch);
+    return rgb_matrix_check_finished_leds(led_max);
+}
+#    endif // RGB_MATRIX_SPARSE_UPDATES
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
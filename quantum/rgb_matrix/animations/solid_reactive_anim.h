@@ -12,7 +12,11 @@ static HSV SOLID_REACTIVE_math(HSV hsv, uint16_t offset) {
 }
 
 bool SOLID_REACTIVE(effect_params_t* params) {
+#            if defined(RGB_MATRIX_SPARSE_UPDATES) && !defined(RGB_MATRIX_SOLID_REACTIVE_GRADIENT_MODE)
+    return effect_runner_reactive_sparse(params, &SOLID_REACTIVE_math);
+#            else
     return effect_runner_reactive(params, &SOLID_REACTIVE_math);
+#            endif
 }
 
 #        endif // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
@@ -1,4 +1,4 @@
-#if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
+#ifdef ENABLE_RGB_MATRIX_TYPING_HEATMAP
 RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #    ifdef RGB_MATRIX_CUSTOM_EFFECT_IMPLS
 
@@ -13,85 +13,169 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+
+// Room for a dozen neighbours per key by default, except on AVR, which can't spare the RAM
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS
+#            ifdef __AVR__
+#                define RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS 0
+#            else
+#                define RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS (DRIVER_LED_TOTAL * 12)
+#            endif
+#        endif
+
+// Each LED's temperature the last time it was changed, and when that was, in steps of the decrease delay.
+// The temperature drops by one every step, so is only worked out when it's needed, rather than on a timer.
+static uint8_t heatmap_heat[DRIVER_LED_TOTAL];
+static uint8_t heatmap_touched[DRIVER_LED_TOTAL];
+
+static uint8_t heatmap_tick(void) {
+    return timer_read32() / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+}
+
+// Only valid as long as the LED is looked at at least every 255 steps, which rendering does while the effect runs
+static uint8_t heatmap_current(uint8_t led, uint8_t tick) {
+    return qsub8(heatmap_heat[led], tick - heatmap_touched[led]);
+}
+
+static void heatmap_add(uint8_t led, uint8_t amount, uint8_t tick) {
+    heatmap_heat[led]    = qadd8(heatmap_current(led, tick), amount);
+    heatmap_touched[led] = tick;
+}
+
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+// How much a key press warms up another key, depending on how far away it is
+static uint8_t heatmap_spread(uint8_t led_a, uint8_t led_b) {
+    int16_t dx = g_led_config.point[led_a].x - g_led_config.point[led_b].x;
+    int16_t dy = g_led_config.point[led_a].y - g_led_config.point[led_b].y;
+    // Most keys are too far away, so don't bother with the square root for them
+    if (abs(dx) >= RGB_MATRIX_TYPING_HEATMAP_SPREAD || abs(dy) >= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+        return 0;
+    }
+    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, sqrt16(dx * dx + dy * dy));
+    return amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT ? RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT : amount;
+}
+
+#            if RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS > 0
+typedef struct {
+    uint8_t led;
+    uint8_t amount;
+} heatmap_neighbour_t;
+
+// The keys each key press spreads to, worked out when the effect starts. Keys whose lists didn't fit are left
+// with a count of UINT8_MAX, and look through every key when they're pressed instead.
+static heatmap_neighbour_t heatmap_neighbours[RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS];
+static uint16_t            heatmap_first[DRIVER_LED_TOTAL];
+static uint8_t             heatmap_count[DRIVER_LED_TOTAL];
+
+// Appends the key's neighbours to the list, unless they don't all fit
+static void heatmap_list_neighbours(uint8_t led, uint16_t* used) {
+    uint16_t n = *used;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t target = g_led_config.matrix_co[row][col];
+            if (target == NO_LED || target == led) {
+                continue;
+            }
+            uint8_t amount = heatmap_spread(led, target);
+            if (amount == 0) {
+                continue;
+            }
+            if (n == RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS || n - *used == UINT8_MAX - 1) {
+                return;
+            }
+            heatmap_neighbours[n++] = (heatmap_neighbour_t){.led = target, .amount = amount};
+        }
+    }
+    heatmap_first[led] = *used;
+    heatmap_count[led] = n - *used;
+    *used              = n;
+}
+
+static void heatmap_find_neighbours(void) {
+    uint16_t used = 0;
+    memset(heatmap_count, UINT8_MAX, sizeof heatmap_count);
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t led = g_led_config.matrix_co[row][col];
+            if (led != NO_LED && heatmap_count[led] == UINT8_MAX) {
+                heatmap_list_neighbours(led, &used);
+            }
+        }
+    }
+}
+#            endif // RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS > 0
+#        endif     // RGB_MATRIX_TYPING_HEATMAP_SLIM
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
-#        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
-    // Limit effect to pressed keys
-    g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
-#        else
-    if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
+    uint8_t led = g_led_config.matrix_co[row][col];
+    if (led == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
+    uint8_t tick = heatmap_tick();
+    heatmap_add(led, 32, tick);
+
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+#            if RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS > 0
+    if (heatmap_count[led] != UINT8_MAX) {
+        const heatmap_neighbour_t* neighbour = &heatmap_neighbours[heatmap_first[led]];
+        for (uint8_t n = 0; n < heatmap_count[led]; n++, neighbour++) {
+            heatmap_add(neighbour->led, neighbour->amount, tick);
+        }
+        return;
+    }
+#            endif // RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS > 0
     for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
         for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
-            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
+            uint8_t target = g_led_config.matrix_co[i_row][i_col];
+            if (target == NO_LED || target == led) { // skip as target key doesn't have an led position
                 continue;
             }
-            if (i_row == row && i_col == col) {
-                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], 32);
-            } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
-                }
+            uint8_t amount = heatmap_spread(led, target);
+            if (amount) {
+                heatmap_add(target, amount, tick);
             }
         }
     }
-#        endif
+#        endif // RGB_MATRIX_TYPING_HEATMAP_SLIM
 }
 
-// A timer to track the last time we decremented all heatmap values.
-static uint16_t heatmap_decrease_timer;
-// Whether we should decrement the heatmap values during the next update.
-static bool decrease_heatmap_values;
-
 bool TYPING_HEATMAP(effect_params_t* params) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    if (params->init) {
+    if (params->init && params->iter == 0) {
         rgb_matrix_set_color_all(0, 0, 0);
-        memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
-    }
-
-    // The heatmap animation might run in several iterations depending on
-    // `RGB_MATRIX_LED_PROCESS_LIMIT`, therefore we only want to update the
-    // timer when the animation starts.
-    if (params->iter == 0) {
-        decrease_heatmap_values = timer_elapsed(heatmap_decrease_timer) >= RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
-
-        // Restart the timer if we are going to decrease the heatmap this frame.
-        if (decrease_heatmap_values) {
-            heatmap_decrease_timer = timer_read();
-        }
+        memset(heatmap_heat, 0, sizeof heatmap_heat);
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM) && RGB_MATRIX_TYPING_HEATMAP_NEIGHBOURS > 0
+        heatmap_find_neighbours();
+#        endif
     }
 
-    // Render heatmap & decrease
-    uint8_t count = 0;
-    for (uint8_t row = 0; row < MATRIX_ROWS && count < RGB_MATRIX_LED_PROCESS_LIMIT; row++) {
-        for (uint8_t col = 0; col < MATRIX_COLS && RGB_MATRIX_LED_PROCESS_LIMIT; col++) {
-            if (g_led_config.matrix_co[row][col] >= led_min && g_led_config.matrix_co[row][col] < led_max) {
-                count++;
-                uint8_t val = g_rgb_frame_buffer[row][col];
-                if (!HAS_ANY_FLAGS(g_led_config.flags[g_led_config.matrix_co[row][col]], params->flags)) continue;
-
-                HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
-                RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
-                rgb_matrix_set_color(g_led_config.matrix_co[row][col], rgb.r, rgb.g, rgb.b);
-
-                if (decrease_heatmap_values) {
-                    g_rgb_frame_buffer[row][col] = qsub8(val, 1);
-                }
+    uint8_t            tick  = heatmap_tick();
+    rgb_matrix_batch_t batch = {0};
+    for (uint8_t i = led_min; i < led_max; i++) {
+        uint8_t val = 0;
+        if (heatmap_heat[i]) {
+            val = heatmap_current(i, tick);
+            if (val == 0) {
+                // Cooled down, so it no longer matters when it was last touched
+                heatmap_heat[i] = 0;
             }
         }
+#        ifdef RGB_MATRIX_SPARSE_UPDATES
+        // Cold keys stay dark, so only need drawing after they've cooled down or something else has lit them up
+        else if (!rgb_matrix_led_needs_render(params, i)) {
+            continue;
+        }
+#        endif // RGB_MATRIX_SPARSE_UPDATES
+        RGB_MATRIX_TEST_LED_FLAGS();
+
+        HSV hsv = {170 - qsub8(val, 85), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)};
+        rgb_matrix_batch_add(&batch, i, hsv);
     }
+    rgb_matrix_batch_flush(&batch);
 
     return rgb_matrix_check_finished_leds(led_max);
 }
 
 #    endif // RGB_MATRIX_CUSTOM_EFFECT_IMPLS
-#endif     // defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
+#endif     // ENABLE_RGB_MATRIX_TYPING_HEATMAP
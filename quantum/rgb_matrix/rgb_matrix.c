@@ -31,10 +31,58 @@ const led_point_t k_rgb_matrix_center = {112, 32};
 const led_point_t k_rgb_matrix_center = RGB_MATRIX_CENTER;
 #endif
 
-__attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
+#ifndef RGB_MATRIX_LED_POLAR_PROGMEM
+static led_polar_t rgb_matrix_compute_led_polar(uint8_t index) {
+    int16_t     dx    = g_led_config.point[index].x - k_rgb_matrix_center.x;
+    int16_t     dy    = g_led_config.point[index].y - k_rgb_matrix_center.y;
+    led_polar_t polar = {.angle = atan2_8(dy, dx), .dist = sqrt16(dx * dx + dy * dy)};
+    return polar;
+}
+
+#    ifdef RGB_MATRIX_LED_POLAR_CACHE
+static led_polar_t rgb_led_polar[DRIVER_LED_TOTAL];
+#    endif
+#endif // RGB_MATRIX_LED_POLAR_PROGMEM
+
+// Angle and distance from the centre, which the radial and spiral effects would otherwise work out every frame
+
+static inline led_polar_t rgb_matrix_led_polar(uint8_t index) {
+#if defined(RGB_MATRIX_LED_POLAR_PROGMEM)
+    led_polar_t polar = {.angle = pgm_read_byte(&g_led_polar[index].angle), .dist = pgm_read_byte(&g_led_polar[index].dist)};
+    return polar;
+#elif defined(RGB_MATRIX_LED_POLAR_CACHE)
+    return rgb_led_polar[index];
+#else
+    return rgb_matrix_compute_led_polar(index);
+#endif
+}
+
+static RGB rgb_matrix_hsv_to_rgb_default(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+// Aliased, so that the batched conversion can tell whether the keyboard has replaced it
+RGB rgb_matrix_hsv_to_rgb(HSV hsv) __attribute__((weak, alias("rgb_matrix_hsv_to_rgb_default")));
+
+void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+    if (rgb_matrix_hsv_to_rgb != rgb_matrix_hsv_to_rgb_default) {
+        for (uint8_t i = 0; i < count; i++) {
+            rgb[i] = rgb_matrix_hsv_to_rgb(hsv[i]);
+        }
+        return;
+    }
+    hsv_to_rgb_batch(hsv, rgb, count);
+}
+
+void rgb_matrix_batch_flush(rgb_matrix_batch_t *batch) {
+    RGB rgb[RGB_MATRIX_BATCH_SIZE];
+    rgb_matrix_hsv_to_rgb_batch(batch->hsv, rgb, batch->count);
+    for (uint8_t i = 0; i < batch->count; i++) {
+        rgb_matrix_set_color(batch->index[i], rgb[i].r, rgb[i].g, rgb[i].b);
+    }
+    batch->count = 0;
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -136,6 +184,26 @@ static uint32_t rgb_timer_buffer;
 static last_hit_t last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_SPARSE_UPDATES
+// LEDs written by anything but the effect since the current frame started, and during the previous frame
+static uint8_t rgb_dirty_leds[(DRIVER_LED_TOTAL + 7) / 8];
+static uint8_t rgb_last_dirty_leds[(DRIVER_LED_TOTAL + 7) / 8];
+static bool    rgb_effect_rendering; // the effect's own writes don't make LEDs dirty
+static HSV     rgb_last_hsv;
+static uint8_t rgb_last_speed;
+#endif // RGB_MATRIX_SPARSE_UPDATES
+
+#ifdef RGB_MATRIX_RENDER_BUDGET
+static uint8_t                   rgb_render_next_led = 0;
+static uint8_t                   rgb_render_chunk    = RGB_MATRIX_LED_PROCESS_LIMIT;
+static uint32_t                  rgb_render_led_cost = 0; // smoothed render time per LED, in 1/64us
+static rgb_matrix_render_stats_t rgb_render_stats;
+static uint32_t                  rgb_render_window;
+static uint16_t                  rgb_render_frames;
+static uint32_t                  rgb_render_time_us;
+static uint16_t                  rgb_render_max_us;
+#endif // RGB_MATRIX_RENDER_BUDGET
+
 // split rgb matrix
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
@@ -197,6 +265,11 @@ void rgb_matrix_update_pwm_buffers(void) {
 }
 
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+#ifdef RGB_MATRIX_SPARSE_UPDATES
+    if (index >= 0 && index < DRIVER_LED_TOTAL && !rgb_effect_rendering) {
+        rgb_dirty_leds[index / 8] |= 1 << (index % 8);
+    }
+#endif // RGB_MATRIX_SPARSE_UPDATES
     rgb_matrix_driver.set_color(index, red, green, blue);
 }
 
@@ -205,10 +278,19 @@ void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++)
         rgb_matrix_set_color(i, red, green, blue);
 #else
+#    ifdef RGB_MATRIX_SPARSE_UPDATES
+    memset(rgb_dirty_leds, 0xFF, sizeof(rgb_dirty_leds));
+#    endif // RGB_MATRIX_SPARSE_UPDATES
     rgb_matrix_driver.set_color_all(red, green, blue);
 #endif
 }
 
+#ifdef RGB_MATRIX_SPARSE_UPDATES
+bool rgb_matrix_led_needs_render(effect_params_t *params, uint8_t index) {
+    return params->init || ((rgb_dirty_leds[index / 8] | rgb_last_dirty_leds[index / 8]) & (1 << (index % 8)));
+}
+#endif // RGB_MATRIX_SPARSE_UPDATES
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
     if (!is_keyboard_master()) return;
@@ -248,7 +330,7 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
     }
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
-#if defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
+#ifdef ENABLE_RGB_MATRIX_TYPING_HEATMAP
 #    if defined(RGB_MATRIX_KEYRELEASES)
     if (!pressed)
 #    else
@@ -259,7 +341,7 @@ void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
             process_rgb_matrix_typing_heatmap(row, col);
         }
     }
-#endif // defined(RGB_MATRIX_FRAMEBUFFER_EFFECTS) && defined(ENABLE_RGB_MATRIX_TYPING_HEATMAP)
+#endif // ENABLE_RGB_MATRIX_TYPING_HEATMAP
 }
 
 void rgb_matrix_test(void) {
@@ -330,6 +412,9 @@ static void rgb_task_sync(void) {
 static void rgb_task_start(void) {
     // reset iter
     rgb_effect_params.iter = 0;
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    rgb_render_next_led = 0;
+#endif // RGB_MATRIX_RENDER_BUDGET
 
     // update double buffers
     g_rgb_timer = rgb_timer_buffer;
@@ -337,6 +422,17 @@ static void rgb_task_start(void) {
     g_last_hit_tracker = last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_SPARSE_UPDATES
+    memcpy(rgb_last_dirty_leds, rgb_dirty_leds, sizeof(rgb_dirty_leds));
+    memset(rgb_dirty_leds, 0, sizeof(rgb_dirty_leds));
+    // sparse effects only depend on these, so have to redraw everything when they change
+    if (memcmp(&rgb_last_hsv, &rgb_matrix_config.hsv, sizeof(HSV)) != 0 || rgb_last_speed != rgb_matrix_config.speed) {
+        memset(rgb_last_dirty_leds, 0xFF, sizeof(rgb_last_dirty_leds));
+        rgb_last_hsv   = rgb_matrix_config.hsv;
+        rgb_last_speed = rgb_matrix_config.speed;
+    }
+#endif // RGB_MATRIX_SPARSE_UPDATES
+
     // next task
     rgb_task_state = RENDERING;
 }
@@ -348,6 +444,10 @@ static void rgb_task_render(uint8_t effect) {
         rgb_effect_params.flags = rgb_matrix_config.flags;
         rgb_matrix_set_color_all(0, 0, 0);
     }
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    rgb_effect_params.led_min   = rgb_render_next_led;
+    rgb_effect_params.led_count = MIN(rgb_render_chunk, DRIVER_LED_TOTAL - rgb_render_next_led);
+#endif // RGB_MATRIX_RENDER_BUDGET
 
     // each effect can opt to do calculations
     // and/or request PWM buffer updates.
@@ -408,13 +508,64 @@ static void rgb_task_flush(uint8_t effect) {
 
     // update pwm buffers
     rgb_matrix_update_pwm_buffers();
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    rgb_render_frames++;
+#endif // RGB_MATRIX_RENDER_BUDGET
 
     // next task
     rgb_task_state = SYNCING;
 }
 
+#ifdef RGB_MATRIX_RENDER_BUDGET
+// Sizes the next render iteration from how long this one took
+static void rgb_render_govern(uint32_t elapsed_us) {
+    uint8_t rendered = rgb_effect_params.led_count;
+    rgb_render_next_led += rendered;
+
+    rgb_render_time_us += elapsed_us;
+    if (elapsed_us > rgb_render_max_us) {
+        rgb_render_max_us = MIN(elapsed_us, UINT16_MAX);
+    }
+
+    if (rendered > 0) {
+        // Smoothed over a few iterations, so that a coarse timer still averages out to the right cost. Kept at four
+        // times the scale it's used at, so that it settles on the exact cost rather than a few steps short of it.
+        uint32_t cost = MIN((elapsed_us << 4) / rendered, UINT16_MAX);
+        rgb_render_led_cost += cost - (rgb_render_led_cost >> 2);
+
+        cost                   = rgb_render_led_cost >> 2;
+        uint32_t chunk         = cost ? ((uint32_t)RGB_MATRIX_RENDER_BUDGET << 4) / cost : DRIVER_LED_TOTAL;
+        rgb_render_chunk       = MAX(MIN(chunk, DRIVER_LED_TOTAL), 1);
+        rgb_render_stats.chunk = rgb_render_chunk;
+    }
+}
+
+static void rgb_render_update_stats(void) {
+    uint32_t elapsed = timer_elapsed32(rgb_render_window);
+    if (elapsed < 1000) {
+        return;
+    }
+
+    rgb_render_stats.fps    = (uint32_t)rgb_render_frames * 1000 / elapsed;
+    rgb_render_stats.load   = MIN(rgb_render_time_us / elapsed, 1000);
+    rgb_render_stats.max_us = rgb_render_max_us;
+
+    rgb_render_window += elapsed;
+    rgb_render_frames  = 0;
+    rgb_render_time_us = 0;
+    rgb_render_max_us  = 0;
+}
+
+const rgb_matrix_render_stats_t *rgb_matrix_get_render_stats(void) {
+    return &rgb_render_stats;
+}
+#endif // RGB_MATRIX_RENDER_BUDGET
+
 void rgb_matrix_task(void) {
     rgb_task_timers();
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    rgb_render_update_stats();
+#endif // RGB_MATRIX_RENDER_BUDGET
 
     // Ideally we would also stop sending zeros to the LED driver PWM buffers
     // while suspended and just do a software shutdown. This is a cheap hack for now.
@@ -430,13 +581,26 @@ void rgb_matrix_task(void) {
         case STARTING:
             rgb_task_start();
             break;
-        case RENDERING:
+        case RENDERING: {
+#ifdef RGB_MATRIX_RENDER_BUDGET
+            uint32_t render_start = timer_read_us();
+#endif // RGB_MATRIX_RENDER_BUDGET
+#ifdef RGB_MATRIX_SPARSE_UPDATES
+            rgb_effect_rendering = true;
             rgb_task_render(effect);
+            rgb_effect_rendering = false;
+#else
+            rgb_task_render(effect);
+#endif // RGB_MATRIX_SPARSE_UPDATES
             if (effect) {
                 rgb_matrix_indicators();
                 rgb_matrix_indicators_advanced(&rgb_effect_params);
             }
+#ifdef RGB_MATRIX_RENDER_BUDGET
+            rgb_render_govern(timer_read_us() - render_start);
+#endif // RGB_MATRIX_RENDER_BUDGET
             break;
+        }
         case FLUSHING:
             rgb_task_flush(effect);
             break;
@@ -461,7 +625,10 @@ void rgb_matrix_indicators_advanced(effect_params_t *params) {
      * and not sure which would be better. Otherwise, this should be called from
      * rgb_task_render, right before the iter++ line.
      */
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+#if defined(RGB_MATRIX_RENDER_BUDGET)
+    uint8_t min = params->led_min;
+    uint8_t max = min + params->led_count;
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
     uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * (params->iter - 1);
     uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;
     if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
@@ -480,6 +647,12 @@ __attribute__((weak)) void rgb_matrix_indicators_advanced_user(uint8_t led_min,
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#if defined(RGB_MATRIX_LED_POLAR_CACHE) && !defined(RGB_MATRIX_LED_POLAR_PROGMEM)
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        rgb_led_polar[i] = rgb_matrix_compute_led_polar(i);
+    }
+#endif
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
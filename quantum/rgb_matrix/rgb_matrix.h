@@ -22,6 +22,7 @@
 #include <stdbool.h>
 #include "rgb_matrix_types.h"
 #include "color.h"
+#include "progmem.h"
 #include "quantum.h"
 
 #ifdef IS31FL3731
@@ -50,19 +51,28 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT (DRIVER_LED_TOTAL + 4) / 5
 #endif
 
-#if defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+#ifdef RGB_MATRIX_RENDER_BUDGET
+// The governor picks how many LEDs each iteration renders, to fit in the budget
+#    define RGB_MATRIX_CHUNK_MIN(params) ((params)->led_min)
+#    define RGB_MATRIX_CHUNK_SIZE(params) ((params)->led_count)
+#elif defined(RGB_MATRIX_LED_PROCESS_LIMIT) && RGB_MATRIX_LED_PROCESS_LIMIT > 0 && RGB_MATRIX_LED_PROCESS_LIMIT < DRIVER_LED_TOTAL
+#    define RGB_MATRIX_CHUNK_MIN(params) (RGB_MATRIX_LED_PROCESS_LIMIT * (params)->iter)
+#    define RGB_MATRIX_CHUNK_SIZE(params) (RGB_MATRIX_LED_PROCESS_LIMIT)
+#endif
+
+#ifdef RGB_MATRIX_CHUNK_MIN
 #    if defined(RGB_MATRIX_SPLIT)
 #        define RGB_MATRIX_USE_LIMITS(min, max)                                                   \
-            uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter;                            \
-            uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;                                     \
+            uint8_t min = RGB_MATRIX_CHUNK_MIN(params);                                           \
+            uint8_t max = min + RGB_MATRIX_CHUNK_SIZE(params);                                    \
             if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;                                   \
             uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;                                     \
             if (is_keyboard_left() && (max > k_rgb_matrix_split[0])) max = k_rgb_matrix_split[0]; \
             if (!(is_keyboard_left()) && (min < k_rgb_matrix_split[0])) min = k_rgb_matrix_split[0];
 #    else
-#        define RGB_MATRIX_USE_LIMITS(min, max)                        \
-            uint8_t min = RGB_MATRIX_LED_PROCESS_LIMIT * params->iter; \
-            uint8_t max = min + RGB_MATRIX_LED_PROCESS_LIMIT;          \
+#        define RGB_MATRIX_USE_LIMITS(min, max)                \
+            uint8_t min = RGB_MATRIX_CHUNK_MIN(params);        \
+            uint8_t max = min + RGB_MATRIX_CHUNK_SIZE(params); \
             if (max > DRIVER_LED_TOTAL) max = DRIVER_LED_TOTAL;
 #    endif
 #else
@@ -122,6 +132,31 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
+RGB  rgb_matrix_hsv_to_rgb(HSV hsv);
+void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count);
+
+// Sets the colour of every LED in the batch, then empties it
+void rgb_matrix_batch_flush(rgb_matrix_batch_t *batch);
+
+static inline void rgb_matrix_batch_add(rgb_matrix_batch_t *batch, uint8_t index, HSV hsv) {
+    batch->index[batch->count] = index;
+    batch->hsv[batch->count]   = hsv;
+    if (++batch->count == RGB_MATRIX_BATCH_SIZE) {
+        rgb_matrix_batch_flush(batch);
+    }
+}
+
+#ifdef RGB_MATRIX_RENDER_BUDGET
+// Rendering statistics, updated every second
+const rgb_matrix_render_stats_t *rgb_matrix_get_render_stats(void);
+#endif
+
+#ifdef RGB_MATRIX_SPARSE_UPDATES
+// Whether an LED has been written by anything since the previous frame, so an effect that only
+// updates the LEDs it changes still has to render it
+bool rgb_matrix_led_needs_render(effect_params_t *params, uint8_t index);
+#endif
+
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed);
 
 void rgb_matrix_task(void);
@@ -258,6 +293,12 @@ extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
+
+// Generated from info.json along with g_led_config, so only valid for the default centre
+#if defined(RGB_MATRIX_LED_POLAR_GENERATED) && !defined(RGB_MATRIX_CENTER)
+#    define RGB_MATRIX_LED_POLAR_PROGMEM
+extern const led_polar_t g_led_polar[DRIVER_LED_TOTAL] PROGMEM;
+#endif
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
@@ -335,6 +335,14 @@ const rgb_matrix_driver_t rgb_matrix_driver = {
 #        pragma message "You need to use a custom driver, or re-implement the WS2812 driver to use a different configuration."
 #    endif
 
+#    ifdef WS2812_DIRECT_WRITE
+// Colours go straight into the driver's frame buffer, which keeps the LEDs that aren't set
+static void init(void) {}
+
+static void flush(void) {
+    ws2812_show();
+}
+#    else
 // LED color buffer
 LED_TYPE rgb_matrix_ws2812_array[DRIVER_LED_TOTAL];
 
@@ -344,6 +352,7 @@ static void flush(void) {
     // Assumes use of RGB_DI_PIN
     ws2812_setleds(rgb_matrix_ws2812_array, DRIVER_LED_TOTAL);
 }
+#    endif // WS2812_DIRECT_WRITE
 
 // Set an led in the buffer to a color
 static inline void setled(int i, uint8_t r, uint8_t g, uint8_t b) {
@@ -360,16 +369,26 @@ static inline void setled(int i, uint8_t r, uint8_t g, uint8_t b) {
     }
 #    endif
 
+#    ifdef WS2812_DIRECT_WRITE
+#        ifdef RGBW
+    LED_TYPE color = {.r = r, .g = g, .b = b};
+    convert_rgb_to_rgbw(&color);
+    ws2812_write_led_rgbw(i, color.r, color.g, color.b, color.w);
+#        else
+    ws2812_write_led(i, r, g, b);
+#        endif
+#    else
     rgb_matrix_ws2812_array[i].r = r;
     rgb_matrix_ws2812_array[i].g = g;
     rgb_matrix_ws2812_array[i].b = b;
-#    ifdef RGBW
+#        ifdef RGBW
     convert_rgb_to_rgbw(&rgb_matrix_ws2812_array[i]);
-#    endif
+#        endif
+#    endif // WS2812_DIRECT_WRITE
 }
 
 static void setled_all(uint8_t r, uint8_t g, uint8_t b) {
-    for (int i = 0; i < sizeof(rgb_matrix_ws2812_array) / sizeof(rgb_matrix_ws2812_array[0]); i++) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
         setled(i, r, g, b);
     }
 }
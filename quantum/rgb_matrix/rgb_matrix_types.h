@@ -49,6 +49,17 @@ typedef struct PACKED {
 } last_hit_t;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+// LEDs converted from HSV at a time by the effect runners
+#ifndef RGB_MATRIX_BATCH_SIZE
+#    define RGB_MATRIX_BATCH_SIZE 16
+#endif // RGB_MATRIX_BATCH_SIZE
+
+typedef struct {
+    uint8_t count;
+    uint8_t index[RGB_MATRIX_BATCH_SIZE];
+    HSV     hsv[RGB_MATRIX_BATCH_SIZE];
+} rgb_matrix_batch_t;
+
 typedef enum rgb_task_states { STARTING, RENDERING, FLUSHING, SYNCING } rgb_task_states;
 
 typedef uint8_t led_flags_t;
@@ -57,13 +68,33 @@ typedef struct PACKED {
     uint8_t     iter;
     led_flags_t flags;
     bool        init;
+#ifdef RGB_MATRIX_RENDER_BUDGET
+    // LEDs to render in this iteration, as sized by the governor
+    uint8_t led_min;
+    uint8_t led_count;
+#endif // RGB_MATRIX_RENDER_BUDGET
 } effect_params_t;
 
+#ifdef RGB_MATRIX_RENDER_BUDGET
+typedef struct {
+    uint16_t fps;    // frames flushed per second
+    uint16_t load;   // share of the time spent rendering, in thousandths
+    uint16_t max_us; // longest single render iteration
+    uint8_t  chunk;  // LEDs the next render iteration will cover, kept up to date
+} rgb_matrix_render_stats_t;
+#endif // RGB_MATRIX_RENDER_BUDGET
+
 typedef struct PACKED {
     uint8_t x;
     uint8_t y;
 } led_point_t;
 
+// Position of an LED relative to the centre of the board
+typedef struct PACKED {
+    uint8_t angle;
+    uint8_t dist;
+} led_polar_t;
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
@@ -903,8 +903,7 @@ __attribute__((weak)) void rgblight_call_driver(LED_TYPE *start_led, uint8_t num
 #ifndef RGBLIGHT_CUSTOM_DRIVER
 
 void rgblight_set(void) {
-    LED_TYPE *start_led;
-    uint8_t   num_leds = rgblight_ranges.clipping_num_leds;
+    uint8_t num_leds = rgblight_ranges.clipping_num_leds;
 
     if (!rgblight_config.enable) {
         for (uint8_t i = rgblight_ranges.effect_start_pos; i < rgblight_ranges.effect_end_pos; i++) {
@@ -929,22 +928,37 @@ void rgblight_set(void) {
     }
 #    endif
 
-#    ifdef RGBLIGHT_LED_MAP
+#    if defined(RGBLIGHT_LED_MAP) && defined(RGBLIGHT_WS2812) && defined(WS2812_DIRECT_WRITE)
+    // The map is applied on the way into the driver's frame buffer, rather than to a copy of every LED
+    for (uint8_t i = 0; i < num_leds; i++) {
+        LED_TYPE color = led[pgm_read_byte(&led_map[rgblight_ranges.clipping_start_pos + i])];
+#        ifdef RGBW
+        convert_rgb_to_rgbw(&color);
+        ws2812_write_led_rgbw(i, color.r, color.g, color.b, color.w);
+#        else
+        ws2812_write_led(i, color.r, color.g, color.b);
+#        endif
+    }
+    ws2812_show();
+#    else
+    LED_TYPE *start_led;
+#        ifdef RGBLIGHT_LED_MAP
     LED_TYPE led0[RGBLED_NUM];
     for (uint8_t i = 0; i < RGBLED_NUM; i++) {
         led0[i] = led[pgm_read_byte(&led_map[i])];
     }
     start_led = led0 + rgblight_ranges.clipping_start_pos;
-#    else
+#        else
     start_led = led + rgblight_ranges.clipping_start_pos;
-#    endif
+#        endif
 
-#    ifdef RGBW
+#        ifdef RGBW
     for (uint8_t i = 0; i < num_leds; i++) {
         convert_rgb_to_rgbw(&start_led[i]);
     }
-#    endif
+#        endif
     rgblight_call_driver(start_led, num_leds);
+#    endif
 }
 #endif
 
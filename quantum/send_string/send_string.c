@@ -20,6 +20,10 @@
 
 #include "send_string.h"
 
+#ifdef SEND_STRING_ASYNC_QUEUE
+#    include "eeprom.h"
+#endif
+
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
 #    include "audio.h"
 #    ifndef BELL_SOUND
@@ -142,6 +146,117 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 // Note: we bit-pack in "reverse" order to optimize loading
 #define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
 
+#ifdef SEND_STRING_BATCHED
+#    ifndef SEND_STRING_BATCH_NKRO_KEYS
+#        define SEND_STRING_BATCH_NKRO_KEYS 16
+#    endif
+#    if defined(NKRO_ENABLE) && SEND_STRING_BATCH_NKRO_KEYS > KEYBOARD_REPORT_KEYS
+#        define SEND_STRING_BATCH_MAX_KEYS SEND_STRING_BATCH_NKRO_KEYS
+#    else
+#        define SEND_STRING_BATCH_MAX_KEYS KEYBOARD_REPORT_KEYS
+#    endif
+
+/* Keys and modifiers currently held down by batched typing.
+ *
+ * Instead of a full press and release per character, each character
+ * adds its key to the report while the previous keys are still held,
+ * so that every report carries exactly one new key press and the host
+ * sees the characters in order. Held keys are released together when
+ * a character needs a different modifier, repeats a held key, or does
+ * not fit into the report anymore.
+ */
+static uint8_t batch_keys[SEND_STRING_BATCH_MAX_KEYS];
+static uint8_t batch_count = 0;
+static uint8_t batch_mods  = 0;
+
+static void send_batch_report(void) {
+    send_keyboard_report();
+#    if TAP_CODE_DELAY > 0
+    wait_ms(TAP_CODE_DELAY);
+#    endif
+}
+
+static void release_batch_keys(void) {
+    for (uint8_t i = 0; i < batch_count; i++) {
+        del_key(batch_keys[i]);
+    }
+    batch_count = 0;
+}
+
+static uint8_t batch_capacity(void) {
+#    ifdef NKRO_ENABLE
+    if (keymap_config.nkro) {
+        return SEND_STRING_BATCH_MAX_KEYS;
+    }
+#    endif
+    return KEYBOARD_REPORT_KEYS;
+}
+
+/** \brief Releases all keys and modifiers held by batched typing. */
+static void send_string_batch_flush(void) {
+    if (batch_count == 0 && batch_mods == 0) {
+        return;
+    }
+    release_batch_keys();
+    del_mods(batch_mods);
+    batch_mods = 0;
+    send_batch_report();
+}
+
+/** \brief Types a character as part of a batch.
+ *
+ * \return false if the character cannot be batched and has to be sent with send_char() instead.
+ */
+static bool send_char_batched(char ascii_code, uint8_t interval) {
+    uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)ascii_code]);
+
+    if (interval != 0 || keycode == KC_NO || PGM_LOADBIT(ascii_to_dead_lut, (uint8_t)ascii_code)) {
+        send_string_batch_flush();
+        return false;
+    }
+
+    uint8_t mods = 0;
+    if (PGM_LOADBIT(ascii_to_shift_lut, (uint8_t)ascii_code)) {
+        mods |= MOD_BIT(KC_LEFT_SHIFT);
+    }
+    if (PGM_LOADBIT(ascii_to_altgr_lut, (uint8_t)ascii_code)) {
+        mods |= MOD_BIT(KC_RIGHT_ALT);
+    }
+
+    if (mods != batch_mods) {
+        // Release the held keys and switch modifiers before pressing the next key
+        release_batch_keys();
+        del_mods(batch_mods);
+        add_mods(mods);
+        batch_mods = mods;
+        send_batch_report();
+    } else {
+        for (uint8_t i = 0; i < batch_count; i++) {
+            if (batch_keys[i] == keycode) {
+                // Repeated key, it has to go up before it can go down again
+                release_batch_keys();
+                send_batch_report();
+                break;
+            }
+        }
+    }
+
+    if (batch_count == batch_capacity()) {
+        // Release the held keys in the same report that presses the new one
+        release_batch_keys();
+    }
+
+    batch_keys[batch_count++] = keycode;
+    add_key(keycode);
+    send_batch_report();
+
+    return true;
+}
+#else
+#    define send_string_batch_flush()
+#    define send_char_batched(ascii_code, interval) false
+#endif
+
 void send_string(const char *string) {
     send_string_with_delay(string, 0);
 }
@@ -149,8 +264,12 @@ void send_string(const char *string) {
 void send_string_with_delay(const char *string, uint8_t interval) {
     while (1) {
         char ascii_code = *string;
-        if (!ascii_code) break;
+        if (!ascii_code) {
+            send_string_batch_flush();
+            break;
+        }
         if (ascii_code == SS_QMK_PREFIX) {
+            send_string_batch_flush();
             ascii_code = *(++string);
             if (ascii_code == SS_TAP_CODE) {
                 // tap
@@ -176,7 +295,7 @@ void send_string_with_delay(const char *string, uint8_t interval) {
                 while (ms--)
                     wait_ms(1);
             }
-        } else {
+        } else if (!send_char_batched(ascii_code, interval)) {
             send_char(ascii_code);
         }
         ++string;
@@ -220,6 +339,320 @@ void send_char(char ascii_code) {
     }
 }
 
+#ifdef SEND_STRING_ASYNC_QUEUE
+#    ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#        define SEND_STRING_ASYNC_BUFFER_SIZE 64
+#    endif
+#    if SEND_STRING_ASYNC_BUFFER_SIZE > 255
+#        error "SEND_STRING_ASYNC_BUFFER_SIZE must not exceed 255"
+#    endif
+
+/* The async queue is a ring buffer of segments. Each segment starts
+ * with a header of 0, the segment type and the interval, since 0
+ * never occurs inside a string. Inline segments are followed by their
+ * characters, PROGMEM and EEPROM segments by a pointer to the string.
+ */
+enum async_segment_type {
+    ASYNC_SEGMENT_INLINE = 1,
+    ASYNC_SEGMENT_PROGMEM,
+    ASYNC_SEGMENT_EEPROM_MACRO,
+};
+
+enum async_op_type {
+    ASYNC_OP_REGISTER,
+    ASYNC_OP_UNREGISTER,
+    ASYNC_OP_DELAY,
+};
+
+typedef struct {
+    uint8_t  type;
+    uint16_t arg;
+} async_op_t;
+
+static uint8_t async_buffer[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint8_t async_head  = 0;
+static uint8_t async_tail  = 0;
+static uint8_t async_count = 0;
+
+// Segment currently being typed
+static uint8_t     async_source   = ASYNC_SEGMENT_INLINE;
+static uint8_t     async_interval = 0;
+static const char *async_cursor   = NULL;
+static uint8_t     async_eeprom_pending_code = 0;
+static bool        async_eeprom_raw_next     = false;
+
+// Reports still to be sent for the current character, one per task call
+static async_op_t async_ops[12];
+static uint8_t    async_op_count = 0;
+static uint8_t    async_op_index = 0;
+static uint8_t    async_op_hold  = 0; // key events wait until this many ops of the character were sent
+
+static uint16_t async_delay_start = 0;
+static uint16_t async_delay_ms    = 0;
+
+static void async_push(uint8_t data) {
+    async_buffer[async_head] = data;
+    async_head               = (async_head + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    async_count++;
+}
+
+static uint8_t async_pop(void) {
+    uint8_t data = async_buffer[async_tail];
+    async_tail   = (async_tail + 1) % SEND_STRING_ASYNC_BUFFER_SIZE;
+    async_count--;
+    return data;
+}
+
+static bool async_push_segment(uint8_t type, uint8_t interval, const void *pointer, size_t length) {
+    size_t needed = 3 + (pointer ? sizeof(pointer) : length);
+    if (needed > SEND_STRING_ASYNC_BUFFER_SIZE - async_count) {
+        dprintf("send_string_async: queue full\n");
+        return false;
+    }
+    async_push(0);
+    async_push(type);
+    async_push(interval);
+    if (pointer) {
+        for (uint8_t i = 0; i < sizeof(pointer); i++) {
+            async_push(((uintptr_t)pointer >> (i * 8)) & 0xFF);
+        }
+    }
+    return true;
+}
+
+bool send_string_async_with_delay(const char *string, uint8_t interval) {
+    size_t length = strlen(string);
+    if (!async_push_segment(ASYNC_SEGMENT_INLINE, interval, NULL, length)) {
+        return false;
+    }
+    while (*string) {
+        async_push(*string++);
+    }
+    return true;
+}
+
+bool send_string_async(const char *string) {
+    return send_string_async_with_delay(string, 0);
+}
+
+bool send_string_async_with_delay_P(const char *string, uint8_t interval) {
+    return async_push_segment(ASYNC_SEGMENT_PROGMEM, interval, string, 0);
+}
+
+bool send_string_async_P(const char *string) {
+    return send_string_async_with_delay_P(string, 0);
+}
+
+bool send_string_async_eeprom_macro(const void *macro, uint8_t interval) {
+    return async_push_segment(ASYNC_SEGMENT_EEPROM_MACRO, interval, macro, 0);
+}
+
+static bool async_segment_done(void) {
+    switch (async_source) {
+        case ASYNC_SEGMENT_PROGMEM:
+            return pgm_read_byte(async_cursor) == 0;
+        case ASYNC_SEGMENT_EEPROM_MACRO:
+            return !async_eeprom_pending_code && eeprom_read_byte((const uint8_t *)async_cursor) == 0;
+        default:
+            return true;
+    }
+}
+
+bool send_string_async_typing(void) {
+    return async_op_index < async_op_hold;
+}
+
+bool send_string_async_busy(void) {
+    return async_count > 0 || !async_segment_done() || async_op_index < async_op_count || async_delay_ms > 0;
+}
+
+void send_string_async_clear(void) {
+    async_head = async_tail = async_count = 0;
+    async_source                          = ASYNC_SEGMENT_INLINE;
+    async_op_count = async_op_index = async_op_hold = 0;
+    async_delay_ms                                  = 0;
+}
+
+/** \brief Reads the next byte of the queued strings, in send_string encoding. */
+static bool async_next_byte(uint8_t *data) {
+    while (true) {
+        switch (async_source) {
+            case ASYNC_SEGMENT_PROGMEM:
+                *data = pgm_read_byte(async_cursor++);
+                if (*data) {
+                    return true;
+                }
+                async_source = ASYNC_SEGMENT_INLINE;
+                break;
+
+            case ASYNC_SEGMENT_EEPROM_MACRO:
+                // Dynamic keymap macros store tap, down and up codes without the SS_QMK_PREFIX
+                if (async_eeprom_pending_code) {
+                    *data                     = async_eeprom_pending_code;
+                    async_eeprom_pending_code = 0;
+                    async_eeprom_raw_next     = true;
+                    return true;
+                }
+                *data = eeprom_read_byte((const uint8_t *)async_cursor++);
+                if (*data == 0) {
+                    async_source = ASYNC_SEGMENT_INLINE;
+                    break;
+                }
+                if (!async_eeprom_raw_next && (*data == SS_TAP_CODE || *data == SS_DOWN_CODE || *data == SS_UP_CODE)) {
+                    async_eeprom_pending_code = *data;
+                    *data                     = SS_QMK_PREFIX;
+                }
+                async_eeprom_raw_next = false;
+                return true;
+
+            default:
+                if (async_count == 0) {
+                    return false;
+                }
+                *data = async_pop();
+                if (*data) {
+                    return true;
+                }
+                // Segment header
+                async_source   = async_pop();
+                async_interval = async_pop();
+                if (async_source != ASYNC_SEGMENT_INLINE) {
+                    uintptr_t pointer = 0;
+                    for (uint8_t i = 0; i < sizeof(async_cursor); i++) {
+                        pointer |= (uintptr_t)async_pop() << (i * 8);
+                    }
+                    async_cursor              = (const char *)pointer;
+                    async_eeprom_pending_code = 0;
+                    async_eeprom_raw_next     = false;
+                }
+                break;
+        }
+    }
+}
+
+static void async_add_op(uint8_t type, uint16_t arg) {
+    async_ops[async_op_count].type = type;
+    async_ops[async_op_count].arg  = arg;
+    async_op_count++;
+}
+
+static void async_add_tap(uint8_t keycode) {
+    uint16_t delay = keycode == KC_CAPS_LOCK ? TAP_HOLD_CAPS_DELAY : TAP_CODE_DELAY;
+
+    async_add_op(ASYNC_OP_REGISTER, keycode);
+    if (delay > 0) {
+        async_add_op(ASYNC_OP_DELAY, delay);
+    }
+    async_add_op(ASYNC_OP_UNREGISTER, keycode);
+}
+
+/** \brief Turns the next queued character or keycode injection into reports.
+ *
+ * Produces the same reports as send_string_with_delay(), to be sent one per call of send_string_task().
+ */
+static bool async_decode_next(void) {
+    uint8_t ascii_code;
+
+    async_op_count = async_op_index = async_op_hold = 0;
+
+    if (!async_next_byte(&ascii_code)) {
+        return false;
+    }
+
+    if (ascii_code == SS_QMK_PREFIX) {
+        uint8_t code, keycode;
+        if (!async_next_byte(&code) || !async_next_byte(&keycode)) {
+            return false;
+        }
+        if (code == SS_TAP_CODE) {
+            async_add_tap(keycode);
+        } else if (code == SS_DOWN_CODE) {
+            async_add_op(ASYNC_OP_REGISTER, keycode);
+        } else if (code == SS_UP_CODE) {
+            async_add_op(ASYNC_OP_UNREGISTER, keycode);
+        } else if (code == SS_DELAY_CODE) {
+            uint16_t ms = 0;
+            while (isdigit(keycode)) {
+                ms *= 10;
+                ms += keycode - '0';
+                if (!async_next_byte(&keycode)) {
+                    break;
+                }
+            }
+            async_add_op(ASYNC_OP_DELAY, ms);
+        }
+    } else {
+        uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[ascii_code]);
+
+        if (keycode == KC_NO) {
+            // Nothing to type, but may ring the bell
+            send_char(ascii_code);
+        } else {
+            bool is_shifted = PGM_LOADBIT(ascii_to_shift_lut, ascii_code);
+            bool is_altgred = PGM_LOADBIT(ascii_to_altgr_lut, ascii_code);
+
+            if (is_shifted) {
+                async_add_op(ASYNC_OP_REGISTER, KC_LEFT_SHIFT);
+            }
+            if (is_altgred) {
+                async_add_op(ASYNC_OP_REGISTER, KC_RIGHT_ALT);
+            }
+            async_add_tap(keycode);
+            if (is_altgred) {
+                async_add_op(ASYNC_OP_UNREGISTER, KC_RIGHT_ALT);
+            }
+            if (is_shifted) {
+                async_add_op(ASYNC_OP_UNREGISTER, KC_LEFT_SHIFT);
+            }
+            if (PGM_LOADBIT(ascii_to_dead_lut, ascii_code)) {
+                async_add_tap(KC_SPACE);
+            }
+        }
+    }
+
+    // A character may hold down modifiers, or hold its key down for TAP_CODE_DELAY. Explicit delays and the interval
+    // between characters leave nothing held down, so key events don't need to wait for them.
+    if (async_op_count != 1 || async_ops[0].type != ASYNC_OP_DELAY) {
+        async_op_hold = async_op_count;
+    }
+
+    if (async_interval > 0) {
+        async_add_op(ASYNC_OP_DELAY, async_interval);
+    }
+
+    return true;
+}
+
+void send_string_task(void) {
+    if (async_delay_ms > 0) {
+        if (timer_elapsed(async_delay_start) < async_delay_ms) {
+            return;
+        }
+        async_delay_ms = 0;
+    }
+
+    if (async_op_index == async_op_count && !async_decode_next()) {
+        return;
+    }
+
+    if (async_op_index < async_op_count) {
+        async_op_t *op = &async_ops[async_op_index++];
+        switch (op->type) {
+            case ASYNC_OP_REGISTER:
+                register_code(op->arg);
+                break;
+            case ASYNC_OP_UNREGISTER:
+                unregister_code(op->arg);
+                break;
+            case ASYNC_OP_DELAY:
+                async_delay_start = timer_read();
+                async_delay_ms    = op->arg;
+                break;
+        }
+    }
+}
+#endif
+
 void send_dword(uint32_t number) {
     send_word(number >> 16);
     send_word(number & 0xFFFFUL);
@@ -282,8 +715,12 @@ void send_string_P(const char *string) {
 void send_string_with_delay_P(const char *string, uint8_t interval) {
     while (1) {
         char ascii_code = pgm_read_byte(string);
-        if (!ascii_code) break;
+        if (!ascii_code) {
+            send_string_batch_flush();
+            break;
+        }
         if (ascii_code == SS_QMK_PREFIX) {
+            send_string_batch_flush();
             ascii_code = pgm_read_byte(++string);
             if (ascii_code == SS_TAP_CODE) {
                 // tap
@@ -309,7 +746,7 @@ void send_string_with_delay_P(const char *string, uint8_t interval) {
                 while (ms--)
                     wait_ms(1);
             }
-        } else {
+        } else if (!send_char_batched(ascii_code, interval)) {
             send_char(ascii_code);
         }
         ++string;
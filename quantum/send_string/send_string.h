@@ -135,6 +135,54 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
 #    define send_string_with_delay_P(string, interval) send_string_with_delay(string, interval)
 #endif
 
+#ifdef SEND_STRING_ASYNC_QUEUE
+/**
+ * \brief Queue a string to be typed out without blocking.
+ *
+ * The string is copied into the queue and typed out from `keyboard_task()`, one report per call.
+ *
+ * \return false if the queue does not have enough room for the string.
+ */
+bool send_string_async(const char *string);
+
+bool send_string_async_with_delay(const char *string, uint8_t interval);
+
+/**
+ * \brief Queue a PROGMEM string to be typed out without blocking.
+ *
+ * Only a pointer to the string is queued, so the string must stay valid until it was typed out.
+ */
+bool send_string_async_P(const char *string);
+
+bool send_string_async_with_delay_P(const char *string, uint8_t interval);
+
+/**
+ * \brief Queue a macro stored in EEPROM in the dynamic keymap macro format.
+ */
+bool send_string_async_eeprom_macro(const void *macro, uint8_t interval);
+
+/**
+ * \brief Whether there are queued strings that were not fully typed out yet.
+ */
+bool send_string_async_busy(void);
+
+/**
+ * \brief Whether a queued character is partway through being typed.
+ *
+ * Key events are held back until it was typed out, so that the modifiers it holds down do not apply to them.
+ */
+bool send_string_async_typing(void);
+
+/**
+ * \brief Drop all queued strings.
+ */
+void send_string_async_clear(void);
+
+void send_string_task(void);
+
+#    define SEND_STRING_ASYNC(string) send_string_async_with_delay_P(PSTR(string), 0)
+#endif
+
 /**
  * \brief Shortcut macro for send_string_with_delay_P(PSTR(string), 0).
  *
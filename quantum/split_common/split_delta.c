@@ -0,0 +1,41 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "split_delta.h"
+
+size_t split_delta_encode(uint8_t *dest, const uint8_t *base, const uint8_t *current, size_t length) {
+    uint8_t *header  = dest;
+    uint8_t *payload = dest + SPLIT_DELTA_HEADER_SIZE(length);
+
+    memset(header, 0, SPLIT_DELTA_HEADER_SIZE(length));
+    for (size_t i = 0; i < length; ++i) {
+        if (!base || base[i] != current[i]) {
+            header[i / 8] |= 1 << (i % 8);
+            *payload++ = current[i];
+        }
+    }
+
+    return payload - dest;
+}
+
+size_t split_delta_payload_size(const uint8_t *header, size_t length) {
+    size_t count = 0;
+    for (size_t i = 0; i < SPLIT_DELTA_HEADER_SIZE(length); ++i) {
+        count += __builtin_popcount(header[i]);
+    }
+
+    // Bits past the end of the buffer don't describe anything
+    if (length % 8) {
+        count -= __builtin_popcount(header[length / 8] & ~((1 << (length % 8)) - 1));
+    }
+    return count;
+}
+
+void split_delta_apply(uint8_t *base, const uint8_t *header, const uint8_t *payload, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (header[i / 8] & (1 << (i % 8))) {
+            base[i] = *payload++;
+        }
+    }
+}
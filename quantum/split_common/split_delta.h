@@ -0,0 +1,36 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Delta encoding of split transaction buffers.
+ *
+ * An encoded buffer starts with a bitmap header holding one bit per byte of the buffer, LSB first, which is set if
+ * that byte has changed. The changed bytes follow the header, in order. The receiving side works out how many bytes
+ * follow from the header alone, so both sides can agree on the length of a transfer without any extra round-trip.
+ */
+
+#define SPLIT_DELTA_HEADER_SIZE(length) (((length) + 7) / 8)
+#define SPLIT_DELTA_MAX_SIZE(length) (SPLIT_DELTA_HEADER_SIZE(length) + (length))
+
+/**
+ * Encodes `current` against `base`, returning the number of bytes written to `dest`.
+ * A NULL `base` encodes the whole buffer, for when the other side's copy can't be trusted.
+ *
+ * `dest` must be able to hold SPLIT_DELTA_MAX_SIZE(length) bytes.
+ */
+size_t split_delta_encode(uint8_t *dest, const uint8_t *base, const uint8_t *current, size_t length);
+
+/**
+ * Returns the number of changed bytes which follow the supplied header.
+ */
+size_t split_delta_payload_size(const uint8_t *header, size_t length);
+
+/**
+ * Applies the changed bytes in `payload` to `base`, as described by the supplied header.
+ */
+void split_delta_apply(uint8_t *base, const uint8_t *header, const uint8_t *payload, size_t length);
@@ -0,0 +1,25 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* Just enough of ChibiOS for serial_protocol.c to run on the host, with threads backed by pthreads. */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define likely(x) __builtin_expect(!!(x), 1)
+#define unlikely(x) __builtin_expect(!!(x), 0)
+
+#define HIGHPRIO 255
+
+typedef void (*tfunc_t)(void *arg);
+typedef struct thread_t thread_t;
+
+#define THD_WORKING_AREA(s, n) uint8_t s[n]
+#define THD_FUNCTION(tname, arg) void tname(void *arg)
+
+#define chRegSetThreadName(name) (void)(name)
+
+thread_t *chThdCreateStatic(void *wsp, size_t size, uint8_t prio, tfunc_t pf, void *arg);
@@ -0,0 +1,17 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#define MATRIX_ROWS 8
+#define MATRIX_COLS 8
+
+#define SPLIT_KEYBOARD
+#define SPLIT_TRANSPORT_MIRROR
+#define SPLIT_LAYER_STATE_ENABLE
+#define SPLIT_LED_STATE_ENABLE
+#define SPLIT_MODS_ENABLE
+#define SPLIT_TRANSACTION_IDS_USER USER_SYNC_ECHO, USER_SYNC_STREAM
+
+#define SPLIT_RPC_STREAM_ENABLE
+#define RPC_STREAM_BUFFER_SIZE 1024
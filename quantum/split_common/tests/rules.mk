@@ -0,0 +1,49 @@
+split_delta_INC := \
+	$(QUANTUM_PATH)/split_common
+
+split_delta_SRC := \
+	$(QUANTUM_PATH)/split_common/split_delta.c \
+	$(QUANTUM_PATH)/split_common/tests/split_delta_tests.cpp
+
+split_transport_DEFS := -DNO_DEBUG
+split_transport_INC := \
+	$(QUANTUM_PATH)/split_common \
+	$(QUANTUM_PATH)/split_common/tests
+split_transport_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_loopback.h
+
+split_transport_SRC := \
+	platforms/test/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/tests/transport_loopback.c \
+	$(QUANTUM_PATH)/split_common/tests/split_transport_tests.cpp
+
+split_transport_batch_DEFS := $(split_transport_DEFS) -DSPLIT_TRANSPORT_BATCH
+split_transport_batch_INC := $(split_transport_INC)
+split_transport_batch_CONFIG := $(split_transport_CONFIG)
+split_transport_batch_SRC := $(split_transport_SRC)
+
+split_transport_async_DEFS := $(split_transport_DEFS) -DSPLIT_TRANSPORT_ASYNC
+split_transport_async_INC := $(split_transport_INC)
+split_transport_async_CONFIG := $(split_transport_CONFIG)
+split_transport_async_SRC := $(split_transport_SRC)
+
+serial_protocol_DEFS := -DNO_DEBUG -DSPLIT_TRANSPORT_DELTA -DSPLIT_TRANSPORT_STATS
+serial_protocol_INC := \
+	$(QUANTUM_PATH)/split_common \
+	$(QUANTUM_PATH)/split_common/tests \
+	$(PLATFORM_PATH)/chibios/drivers
+serial_protocol_CONFIG := $(QUANTUM_PATH)/split_common/tests/config_loopback.h
+
+serial_protocol_SRC := \
+	$(QUANTUM_PATH)/split_common/split_delta.c \
+	$(PLATFORM_PATH)/chibios/drivers/serial_protocol.c \
+	$(QUANTUM_PATH)/split_common/tests/serial_protocol_target.c \
+	$(QUANTUM_PATH)/split_common/tests/serial_loopback.c \
+	$(QUANTUM_PATH)/split_common/tests/serial_protocol_tests.cpp
+
+split_transport_delta_DEFS := $(split_transport_DEFS) -DSPLIT_TRANSPORT_DELTA
+split_transport_delta_INC := $(split_transport_INC)
+split_transport_delta_CONFIG := $(split_transport_CONFIG)
+split_transport_delta_SRC := $(split_transport_SRC)
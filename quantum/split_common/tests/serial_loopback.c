@@ -0,0 +1,199 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+#include "ch.h"
+#include "serial_loopback.h"
+#include "serial.h"
+#include "serial_protocol.h"
+
+#define sizeof_member(type, member) sizeof(((type *)NULL)->member)
+
+// How long a receive waits for the other half before giving up, in milliseconds
+#define LOOPBACK_TIMEOUT_MS 50
+#define LOOPBACK_QUEUE_SIZE 1024
+
+static split_shared_memory_t initiator_memory;
+static split_shared_memory_t target_memory;
+split_shared_memory_t *const split_shmem                  = &initiator_memory;
+split_shared_memory_t *const serial_loopback_target_shmem = &target_memory;
+
+// The transactions exercised by the tests, registered as transactions.c does
+split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
+    [GET_SLAVE_MATRIX_CHECKSUM] = {0, 0, sizeof_member(split_shared_memory_t, smatrix.checksum), offsetof(split_shared_memory_t, smatrix.checksum), NULL},
+    [GET_SLAVE_MATRIX_DATA]     = {0, 0, sizeof_member(split_shared_memory_t, smatrix.matrix), offsetof(split_shared_memory_t, smatrix.matrix), NULL, true},
+    [PUT_MASTER_MATRIX]         = {sizeof_member(split_shared_memory_t, mmatrix.matrix), offsetof(split_shared_memory_t, mmatrix.matrix), 0, 0, NULL, true},
+    [PUT_LAYER_STATE]           = {sizeof_member(split_shared_memory_t, layers.layer_state), offsetof(split_shared_memory_t, layers.layer_state), 0, 0, NULL},
+};
+
+typedef struct {
+    uint8_t data[LOOPBACK_QUEUE_SIZE];
+    size_t  head;
+    size_t  count;
+} loopback_queue_t;
+
+static pthread_mutex_t  link_lock    = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t   link_changed = PTHREAD_COND_INITIALIZER;
+static loopback_queue_t to_target;
+static loopback_queue_t to_initiator;
+static int              sends_until_drop[2] = {-1, -1}; // indexed by whether it's the target's send
+static bool             target_waiting;
+
+static void deadline_after_ms(struct timespec *deadline, uint32_t ms) {
+    clock_gettime(CLOCK_REALTIME, deadline);
+    deadline->tv_sec += ms / 1000;
+    deadline->tv_nsec += (long)(ms % 1000) * 1000000;
+    if (deadline->tv_nsec >= 1000000000) {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+static bool loopback_send(loopback_queue_t *queue, bool target, const uint8_t *source, size_t size) {
+    pthread_mutex_lock(&link_lock);
+    if (sends_until_drop[target] >= 0 && sends_until_drop[target]-- == 0 && size > 0) {
+        size--;
+    }
+    for (size_t i = 0; i < size && queue->count < LOOPBACK_QUEUE_SIZE; ++i) {
+        queue->data[(queue->head + queue->count++) % LOOPBACK_QUEUE_SIZE] = source[i];
+    }
+    pthread_cond_broadcast(&link_changed);
+    pthread_mutex_unlock(&link_lock);
+    return true;
+}
+
+static bool loopback_receive(loopback_queue_t *queue, bool target, uint8_t *destination, size_t size, bool blocking) {
+    struct timespec deadline;
+    deadline_after_ms(&deadline, LOOPBACK_TIMEOUT_MS);
+
+    pthread_mutex_lock(&link_lock);
+    while (queue->count < size) {
+        if (blocking) {
+            target_waiting |= target;
+            pthread_cond_broadcast(&link_changed);
+            pthread_cond_wait(&link_changed, &link_lock);
+        } else if (pthread_cond_timedwait(&link_changed, &link_lock, &deadline) != 0) {
+            pthread_mutex_unlock(&link_lock);
+            return false;
+        }
+    }
+    if (target) {
+        target_waiting = false;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        destination[i] = queue->data[queue->head];
+        queue->head    = (queue->head + 1) % LOOPBACK_QUEUE_SIZE;
+        queue->count--;
+    }
+    pthread_mutex_unlock(&link_lock);
+    return true;
+}
+
+static void loopback_clear(loopback_queue_t *queue) {
+    pthread_mutex_lock(&link_lock);
+    queue->head  = 0;
+    queue->count = 0;
+    pthread_mutex_unlock(&link_lock);
+}
+
+// Initiator's end of the link
+
+void serial_transport_driver_clear(void) {
+    loopback_clear(&to_initiator);
+}
+
+void serial_transport_driver_slave_init(void) {}
+void serial_transport_driver_master_init(void) {}
+
+bool serial_transport_receive(uint8_t *destination, const size_t size) {
+    return loopback_receive(&to_initiator, false, destination, size, false);
+}
+
+bool serial_transport_receive_blocking(uint8_t *destination, const size_t size) {
+    return loopback_receive(&to_initiator, false, destination, size, true);
+}
+
+bool serial_transport_send(const uint8_t *source, const size_t size) {
+    return loopback_send(&to_target, false, source, size);
+}
+
+// Target's end of the link
+
+void target_serial_transport_driver_clear(void) {
+    loopback_clear(&to_target);
+}
+
+void target_serial_transport_driver_slave_init(void) {}
+void target_serial_transport_driver_master_init(void) {}
+
+bool target_serial_transport_receive(uint8_t *destination, const size_t size) {
+    return loopback_receive(&to_target, true, destination, size, false);
+}
+
+bool target_serial_transport_receive_blocking(uint8_t *destination, const size_t size) {
+    return loopback_receive(&to_target, true, destination, size, true);
+}
+
+bool target_serial_transport_send(const uint8_t *source, const size_t size) {
+    return loopback_send(&to_initiator, true, source, size);
+}
+
+// Threads
+
+typedef struct {
+    tfunc_t pf;
+    void   *arg;
+} loopback_thread_t;
+
+static void *loopback_thread_entry(void *arg) {
+    loopback_thread_t *thread = arg;
+    thread->pf(thread->arg);
+    return NULL;
+}
+
+thread_t *chThdCreateStatic(void *wsp, size_t size, uint8_t prio, tfunc_t pf, void *arg) {
+    static loopback_thread_t threads[4];
+    static size_t            thread_count = 0;
+
+    loopback_thread_t *thread = &threads[thread_count++];
+    thread->pf                = pf;
+    thread->arg               = arg;
+
+    pthread_t handle;
+    pthread_create(&handle, NULL, loopback_thread_entry, thread);
+    pthread_detach(handle);
+    return (thread_t *)wsp;
+}
+
+// Test API
+
+void serial_loopback_init(void) {
+    static bool started = false;
+    if (!started) {
+        soft_serial_initiator_init();
+        target_soft_serial_target_init();
+        started = true;
+    }
+}
+
+void serial_loopback_wait_idle(void) {
+    pthread_mutex_lock(&link_lock);
+    while (!target_waiting || to_target.count > 0) {
+        pthread_cond_wait(&link_changed, &link_lock);
+    }
+    pthread_mutex_unlock(&link_lock);
+}
+
+void serial_loopback_drop_send(bool target, uint8_t skip) {
+    pthread_mutex_lock(&link_lock);
+    sends_until_drop[target] = skip;
+    pthread_mutex_unlock(&link_lock);
+}
+
+split_shared_memory_t *serial_loopback_target_memory(void) {
+    return &target_memory;
+}
@@ -0,0 +1,32 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "transactions.h"
+
+/* Host-side loopback for the serial transport of serial_protocol.c.
+ *
+ * The protocol is built twice: once as the initiator, against split_shmem, and once as the target, against its own
+ * copy of the shared memory, with every exported symbol renamed (see serial_protocol_target.c). The target's thread
+ * runs for real, and each direction of the link is a byte queue between the two. Receives give up after a short
+ * timeout, as they would on hardware.
+ */
+
+// Starts both halves of the protocol, the first time it's called
+void serial_loopback_init(void);
+
+// Waits until the target has finished with the last transaction, and is waiting for the next one
+void serial_loopback_wait_idle(void);
+
+// Drops the last byte of a send made by the supplied half, as if it was lost on the wire, after letting skip sends through
+void serial_loopback_drop_send(bool target, uint8_t skip);
+
+// The target half's view of the shared memory; only to be used while the target is idle
+split_shared_memory_t *serial_loopback_target_memory(void);
+
+// Target-side entry points, as renamed in serial_protocol_target.c
+void target_soft_serial_target_init(void);
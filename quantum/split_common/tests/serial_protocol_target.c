@@ -0,0 +1,26 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+/* Builds serial_protocol.c a second time as the target half of serial_loopback.c, with its own shared memory and its
+ * own end of the link. */
+
+#define split_shmem serial_loopback_target_shmem
+
+#define soft_serial_initiator_init target_soft_serial_initiator_init
+#define soft_serial_target_init target_soft_serial_target_init
+#define soft_serial_transaction target_soft_serial_transaction
+#define soft_serial_batch target_soft_serial_batch
+#define soft_serial_transaction_start target_soft_serial_transaction_start
+#define soft_serial_transaction_poll target_soft_serial_transaction_poll
+#define soft_serial_resync target_soft_serial_resync
+#define soft_serial_get_stats target_soft_serial_get_stats
+#define soft_serial_clear_stats target_soft_serial_clear_stats
+
+#define serial_transport_driver_clear target_serial_transport_driver_clear
+#define serial_transport_driver_slave_init target_serial_transport_driver_slave_init
+#define serial_transport_driver_master_init target_serial_transport_driver_master_init
+#define serial_transport_receive target_serial_transport_receive
+#define serial_transport_receive_blocking target_serial_transport_receive_blocking
+#define serial_transport_send target_serial_transport_send
+
+#include "serial_protocol.c"
@@ -0,0 +1,140 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "serial.h"
+#include "serial_loopback.h"
+}
+
+/* Configuration (see config_loopback.h and rules.mk):
+ *   8x8 matrix, so each half's matrix is 4 bytes, delta-encoded behind a 1-byte header
+ *   SPLIT_TRANSPORT_STATS, which counts the transaction ID and handshake as 2 bytes
+ */
+
+namespace {
+constexpr uint32_t HANDSHAKE_SIZE = 2;
+constexpr uint32_t HEADER_SIZE    = 1;
+constexpr uint32_t MATRIX_SIZE    = sizeof(split_shmem->smatrix.matrix);
+} // namespace
+
+class SerialProtocolTest : public ::testing::Test {
+   protected:
+    split_shared_memory_t *target;
+
+    void SetUp() override {
+        serial_loopback_init();
+        serial_loopback_wait_idle();
+        target = serial_loopback_target_memory();
+        memset(split_shmem, 0, sizeof(*split_shmem));
+        memset(target, 0, sizeof(*target));
+
+        // Start from full transfers, whatever the previous test left behind
+        for (int id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+            soft_serial_resync(id);
+        }
+    }
+
+    // Runs the transaction through to the target being idle again, and returns the number of bytes put on the wire
+    uint32_t exchange(int id, bool expected = true) {
+        split_transaction_stats_t before, after;
+        soft_serial_get_stats(id, &before);
+        EXPECT_EQ(soft_serial_transaction(id), expected) << "Transaction returned incorrect status";
+        serial_loopback_wait_idle();
+        soft_serial_get_stats(id, &after);
+        return after.bytes - before.bytes;
+    }
+};
+
+/**
+ * This test verifies that the slave matrix is sent in full the first time, and then only the bytes that changed.
+ */
+TEST_F(SerialProtocolTest, SlaveMatrixSendsChangedBytes) {
+    const uint8_t matrix[] = {0x01, 0x02, 0x03, 0x04};
+    memcpy(target->smatrix.matrix, matrix, sizeof(matrix));
+    EXPECT_EQ(exchange(GET_SLAVE_MATRIX_DATA), HANDSHAKE_SIZE + HEADER_SIZE + MATRIX_SIZE);
+    EXPECT_EQ(memcmp(split_shmem->smatrix.matrix, matrix, sizeof(matrix)), 0) << "Matrix not received";
+
+    target->smatrix.matrix[2] = 0x30;
+    EXPECT_EQ(exchange(GET_SLAVE_MATRIX_DATA), HANDSHAKE_SIZE + HEADER_SIZE + 1);
+    EXPECT_EQ(memcmp(split_shmem->smatrix.matrix, target->smatrix.matrix, MATRIX_SIZE), 0) << "Change not received";
+
+    EXPECT_EQ(exchange(GET_SLAVE_MATRIX_DATA), HANDSHAKE_SIZE + HEADER_SIZE);
+    EXPECT_EQ(memcmp(split_shmem->smatrix.matrix, target->smatrix.matrix, MATRIX_SIZE), 0) << "Matrix changed";
+}
+
+/**
+ * This test verifies the same for the mirrored master matrix, which the slave applies to its own copy.
+ */
+TEST_F(SerialProtocolTest, MasterMatrixSendsChangedBytes) {
+    const uint8_t matrix[] = {0x10, 0x20, 0x30, 0x40};
+    memcpy(split_shmem->mmatrix.matrix, matrix, sizeof(matrix));
+    EXPECT_EQ(exchange(PUT_MASTER_MATRIX), HANDSHAKE_SIZE + HEADER_SIZE + MATRIX_SIZE);
+    EXPECT_EQ(memcmp(target->mmatrix.matrix, matrix, sizeof(matrix)), 0) << "Matrix not received";
+
+    split_shmem->mmatrix.matrix[0] = 0x11;
+    split_shmem->mmatrix.matrix[3] = 0x44;
+    EXPECT_EQ(exchange(PUT_MASTER_MATRIX), HANDSHAKE_SIZE + HEADER_SIZE + 2);
+    EXPECT_EQ(memcmp(target->mmatrix.matrix, split_shmem->mmatrix.matrix, MATRIX_SIZE), 0) << "Change not received";
+}
+
+/**
+ * This test verifies that a resync makes the next exchange carry the whole buffer, in either direction.
+ */
+TEST_F(SerialProtocolTest, ResyncSendsWholeBuffer) {
+    EXPECT_EQ(exchange(GET_SLAVE_MATRIX_DATA), HANDSHAKE_SIZE + HEADER_SIZE + MATRIX_SIZE);
+    EXPECT_EQ(exchange(PUT_MASTER_MATRIX), HANDSHAKE_SIZE + HEADER_SIZE + MATRIX_SIZE);
+    EXPECT_EQ(exchange(GET_SLAVE_MATRIX_DATA), HANDSHAKE_SIZE + HEADER_SIZE);
+    EXPECT_EQ(exchange(PUT_MASTER_MATRIX), HANDSHAKE_SIZE + HEADER_SIZE);
+
+    soft_serial_resync(GET_SLAVE_MATRIX_DATA);
+    soft_serial_resync(PUT_MASTER_MATRIX);
+    EXPECT_EQ(exchange(GET_SLAVE_MATRIX_DATA), HANDSHAKE_SIZE + HEADER_SIZE + MATRIX_SIZE);
+    EXPECT_EQ(exchange(PUT_MASTER_MATRIX), HANDSHAKE_SIZE + HEADER_SIZE + MATRIX_SIZE);
+}
+
+/**
+ * This test verifies that if the slave's response is lost, the master asks for the whole buffer next time, even
+ * though the slave believes it was delivered.
+ */
+TEST_F(SerialProtocolTest, LostResponseIsFollowedByFullTransfer) {
+    EXPECT_EQ(exchange(GET_SLAVE_MATRIX_DATA), HANDSHAKE_SIZE + HEADER_SIZE + MATRIX_SIZE);
+
+    // The handshake gets through, the matrix doesn't
+    target->smatrix.matrix[1] = 0x22;
+    serial_loopback_drop_send(true, 1);
+    exchange(GET_SLAVE_MATRIX_DATA, false);
+
+    target->smatrix.matrix[3] = 0x44;
+    EXPECT_EQ(exchange(GET_SLAVE_MATRIX_DATA), HANDSHAKE_SIZE + HEADER_SIZE + MATRIX_SIZE);
+    EXPECT_EQ(memcmp(split_shmem->smatrix.matrix, target->smatrix.matrix, MATRIX_SIZE), 0) << "Matrix not recovered";
+}
+
+/**
+ * This test verifies that if the master's buffer is lost, the slave asks for the whole buffer next time, even though
+ * the master had no way of telling.
+ */
+TEST_F(SerialProtocolTest, LostRequestIsFollowedByFullTransfer) {
+    EXPECT_EQ(exchange(PUT_MASTER_MATRIX), HANDSHAKE_SIZE + HEADER_SIZE + MATRIX_SIZE);
+
+    // The transaction ID gets through, the matrix doesn't
+    split_shmem->mmatrix.matrix[1] = 0x22;
+    serial_loopback_drop_send(false, 1);
+    exchange(PUT_MASTER_MATRIX);
+    EXPECT_EQ(target->mmatrix.matrix[1], 0) << "Matrix should not have been received";
+
+    EXPECT_EQ(exchange(PUT_MASTER_MATRIX), HANDSHAKE_SIZE + HEADER_SIZE + MATRIX_SIZE);
+    EXPECT_EQ(memcmp(target->mmatrix.matrix, split_shmem->mmatrix.matrix, MATRIX_SIZE), 0) << "Matrix not recovered";
+}
+
+/**
+ * This test verifies that buffers which aren't delta-encoded are always sent in full.
+ */
+TEST_F(SerialProtocolTest, PlainBuffersAreSentInFull) {
+    split_shmem->layers.layer_state = 0x04;
+    EXPECT_EQ(exchange(PUT_LAYER_STATE), HANDSHAKE_SIZE + sizeof(layer_state_t));
+    EXPECT_EQ(exchange(PUT_LAYER_STATE), HANDSHAKE_SIZE + sizeof(layer_state_t));
+    EXPECT_EQ(target->layers.layer_state, 0x04) << "Layer state not received";
+}
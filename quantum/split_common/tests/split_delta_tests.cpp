@@ -0,0 +1,75 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "split_delta.h"
+}
+
+class SplitDeltaTest : public ::testing::Test {
+   protected:
+    // Encodes current against base, then decodes it the way the receiving half would
+    size_t round_trip(uint8_t *remote, const uint8_t *base, const uint8_t *current, size_t length) {
+        uint8_t encoded[SPLIT_DELTA_MAX_SIZE(32)];
+        size_t  size = split_delta_encode(encoded, base, current, length);
+
+        size_t payload = split_delta_payload_size(encoded, length);
+        EXPECT_EQ(size, SPLIT_DELTA_HEADER_SIZE(length) + payload) << "Header doesn't describe the encoded length";
+        split_delta_apply(remote, encoded, encoded + SPLIT_DELTA_HEADER_SIZE(length), length);
+        return size;
+    }
+};
+
+TEST_F(SplitDeltaTest, UnchangedBufferIsJustTheHeader) {
+    std::array<uint8_t, 20> base{}, current{}, remote{};
+    for (size_t i = 0; i < current.size(); ++i) {
+        base[i] = current[i] = remote[i] = i * 3;
+    }
+
+    EXPECT_EQ(round_trip(remote.data(), base.data(), current.data(), current.size()), 3);
+    EXPECT_EQ(remote, current);
+}
+
+TEST_F(SplitDeltaTest, OnlyChangedBytesAreSent) {
+    std::array<uint8_t, 20> base{}, current{}, remote{};
+    current[0]  = 1;
+    current[9]  = 2;
+    current[19] = 3;
+
+    EXPECT_EQ(round_trip(remote.data(), base.data(), current.data(), current.size()), 3 + 3);
+    EXPECT_EQ(remote, current);
+}
+
+TEST_F(SplitDeltaTest, NullBaseSendsEverything) {
+    std::array<uint8_t, 13> current{}, remote{};
+    remote.fill(0xAA);
+    for (size_t i = 0; i < current.size(); ++i) {
+        current[i] = i;
+    }
+
+    // Unchanged bytes are included too, so a stale remote copy is brought back in step
+    EXPECT_EQ(round_trip(remote.data(), NULL, current.data(), current.size()), 2 + 13);
+    EXPECT_EQ(remote, current);
+}
+
+TEST_F(SplitDeltaTest, PaddingBitsAreIgnored) {
+    // A corrupt header shouldn't have the receiver read past the end of the buffer
+    uint8_t header[2] = {0xFF, 0xFF};
+    EXPECT_EQ(split_delta_payload_size(header, 10), 10);
+}
+
+TEST_F(SplitDeltaTest, RepeatedUpdatesStayInStep) {
+    std::array<uint8_t, 32> base{}, current{}, remote{};
+    uint32_t                seed = 42;
+
+    for (int i = 0; i < 200; ++i) {
+        seed = seed * 1103515245 + 12345;
+        current[(seed >> 8) % current.size()] ^= (seed >> 16) & 0xFF;
+
+        round_trip(remote.data(), base.data(), current.data(), current.size());
+        base = current;
+        ASSERT_EQ(remote, current) << "Diverged on iteration " << i;
+    }
+}
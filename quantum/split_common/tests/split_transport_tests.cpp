@@ -0,0 +1,518 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "transactions.h"
+#include "transport_loopback.h"
+#include "timer.h"
+#include "crc.h"
+}
+
+/* Configuration (see config_loopback.h):
+ *   8x8 matrix, mirrored to the slave, with layer, LED and mod sync, a user RPC that echoes its argument, and a user
+ *   RPC stream of up to 1024 bytes
+ */
+
+namespace {
+struct {
+    uint8_t mods, weak_mods, oneshot_mods, leds;
+} master_state, slave_state;
+} // namespace
+
+extern "C" {
+layer_state_t layer_state;
+layer_state_t default_layer_state;
+
+bool is_keyboard_master(void) {
+    return !transport_loopback_is_target();
+}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+uint8_t get_mods(void) {
+    return master_state.mods;
+}
+uint8_t get_weak_mods(void) {
+    return master_state.weak_mods;
+}
+uint8_t get_oneshot_mods(void) {
+    return master_state.oneshot_mods;
+}
+uint8_t host_keyboard_leds(void) {
+    return master_state.leds;
+}
+
+void set_mods(uint8_t mods) {
+    slave_state.mods = mods;
+}
+void set_weak_mods(uint8_t mods) {
+    slave_state.weak_mods = mods;
+}
+void set_oneshot_mods(uint8_t mods) {
+    slave_state.oneshot_mods = mods;
+}
+void set_split_host_keyboard_leds(uint8_t led_state) {
+    slave_state.leds = led_state;
+}
+}
+
+static void echo_rpc(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
+    memcpy(out_data, in_data, in_buflen < out_buflen ? in_buflen : out_buflen);
+}
+
+namespace {
+std::vector<uint8_t> streamed;
+uint32_t             streams_received;
+} // namespace
+
+static void stream_rpc(uint16_t length, const void *data) {
+    streamed.assign((const uint8_t *)data, (const uint8_t *)data + length);
+    ++streams_received;
+}
+
+class SplitTransportTest : public ::testing::Test {
+   protected:
+    static constexpr uint8_t ROWS_PER_HAND = MATRIX_ROWS / 2;
+
+    // Matrices as seen by each half
+    matrix_row_t master_matrix[ROWS_PER_HAND];
+    matrix_row_t master_view_of_slave[ROWS_PER_HAND];
+    matrix_row_t slave_matrix[ROWS_PER_HAND];
+    matrix_row_t slave_view_of_master[ROWS_PER_HAND];
+
+    // What the master should be seeing of the slave matrix after the latest scan
+    matrix_row_t expected_view_of_slave[ROWS_PER_HAND];
+#ifdef SPLIT_TRANSPORT_ASYNC
+    matrix_row_t slave_matrix_in_flight[ROWS_PER_HAND];
+
+    // Time taken by the rest of the scan, while the slave matrix is being read in the background
+    static constexpr uint32_t SCAN_PROCESSING_US = 2000;
+#endif // SPLIT_TRANSPORT_ASYNC
+
+    uint32_t rng = 0x1234;
+
+    void SetUp() override {
+        configure(1000000, 0, 0);
+        memset(master_matrix, 0, sizeof(master_matrix));
+        memset(master_view_of_slave, 0, sizeof(master_view_of_slave));
+        memset(slave_matrix, 0, sizeof(slave_matrix));
+        memset(slave_view_of_master, 0, sizeof(slave_view_of_master));
+        memset(expected_view_of_slave, 0, sizeof(expected_view_of_slave));
+#ifdef SPLIT_TRANSPORT_ASYNC
+        memset(slave_matrix_in_flight, 0, sizeof(slave_matrix_in_flight));
+#endif // SPLIT_TRANSPORT_ASYNC
+        master_state = {};
+        slave_state  = {};
+        layer_state = default_layer_state = 0;
+        transaction_register_rpc(USER_SYNC_ECHO, echo_rpc);
+        transaction_register_rpc_stream(USER_SYNC_STREAM, stream_rpc);
+        streamed.clear();
+        streams_received = 0;
+
+        // Bring the handlers' own state in line with the cleared matrices, whatever the previous test left behind
+        scan();
+        scan();
+        transport_loopback_clear_stats();
+    }
+
+    void configure(uint32_t baud_rate, uint32_t latency_us, uint16_t error_rate) {
+        transport_loopback_config_t config = {
+            .baud_rate  = baud_rate,
+            .latency_us = latency_us,
+            .timeout_us = 20000,
+            .error_rate = error_rate,
+            .seed       = 0xC0FFEE,
+        };
+        transport_loopback_reset(&config);
+    }
+
+    bool scan() {
+        transport_slave(slave_view_of_master, slave_matrix);
+        bool okay = transport_master(master_matrix, master_view_of_slave);
+#ifdef SPLIT_TRANSPORT_ASYNC
+        // The slave matrix read started at the end of the scan is picked up by the next one
+        memcpy(expected_view_of_slave, slave_matrix_in_flight, sizeof(expected_view_of_slave));
+        memcpy(slave_matrix_in_flight, slave_matrix, sizeof(slave_matrix_in_flight));
+        transport_loopback_idle(SCAN_PROCESSING_US);
+#else  // SPLIT_TRANSPORT_ASYNC
+        memcpy(expected_view_of_slave, slave_matrix, sizeof(expected_view_of_slave));
+#endif // SPLIT_TRANSPORT_ASYNC
+        return okay;
+    }
+
+    // Presses or releases a random key on either half, and occasionally changes the layer, mods or LEDs
+    void type() {
+        rng = rng * 1103515245 + 12345;
+        uint8_t row = (rng >> 8) % ROWS_PER_HAND;
+        uint8_t col = (rng >> 12) % MATRIX_COLS;
+        if ((rng >> 16) & 1) {
+            master_matrix[row] ^= (matrix_row_t)1 << col;
+        } else {
+            slave_matrix[row] ^= (matrix_row_t)1 << col;
+        }
+        switch ((rng >> 20) % 16) {
+            case 0:
+                layer_state = 1UL << ((rng >> 24) % 4);
+                break;
+            case 1:
+                master_state.mods = (rng >> 24) & 0xFF;
+                break;
+            case 2:
+                master_state.leds = (rng >> 24) & 0x1F;
+                break;
+        }
+    }
+
+    void expect_in_sync() {
+        const split_shared_memory_t *target = transport_loopback_target_memory();
+        EXPECT_EQ(memcmp(master_view_of_slave, expected_view_of_slave, sizeof(expected_view_of_slave)), 0) << "Slave matrix not synced";
+        EXPECT_EQ(memcmp(slave_view_of_master, master_matrix, sizeof(master_matrix)), 0) << "Master matrix not mirrored";
+        EXPECT_EQ(target->layers.layer_state, layer_state) << "Layer state not synced";
+        EXPECT_EQ(slave_state.mods, master_state.mods) << "Mods not synced";
+        EXPECT_EQ(slave_state.leds, master_state.leds) << "LED state not synced";
+    }
+};
+
+TEST_F(SplitTransportTest, StateReachesTheOtherHalf) {
+    master_matrix[1]  = 0x42;
+    slave_matrix[3]   = 0x81;
+    layer_state       = 1UL << 2;
+    master_state.mods = 0x05;
+    master_state.leds = 0x02;
+
+    // The slave only picks up the mirrored matrix on its next scan
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(scan());
+    expect_in_sync();
+
+    uint8_t request[4] = {1, 2, 3, 4}, response[4] = {0};
+    EXPECT_TRUE(transaction_rpc_exec(USER_SYNC_ECHO, sizeof(request), request, sizeof(response), response));
+    EXPECT_EQ(memcmp(request, response, sizeof(request)), 0) << "RPC response not received";
+}
+
+#ifndef SPLIT_TRANSPORT_ASYNC
+TEST_F(SplitTransportTest, WireTimeMatchesTheLinkModel) {
+    configure(1000000, 25, 0);
+    EXPECT_TRUE(scan());
+
+    // ID, handshake and the one-byte checksum: three segments, each with the turnaround latency
+    const transport_loopback_stats_t *checksum = transport_loopback_get_stats(GET_SLAVE_MATRIX_CHECKSUM);
+    EXPECT_EQ(checksum->count, 1);
+    EXPECT_EQ(checksum->bytes, 3);
+    EXPECT_EQ(checksum->time_us, 3 * (25 + 10));
+
+    // Nothing else is sent unless the data changes, or the forced sync is due
+    uint64_t elapsed = transport_loopback_get_link_stats()->elapsed_us;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(transport_loopback_get_link_stats()->elapsed_us - elapsed, checksum->time_us / checksum->count);
+}
+
+TEST_F(SplitTransportTest, RetriesHideOccasionalErrors) {
+    configure(1000000, 10, 3277); // 5% of transactions fail
+
+    for (int i = 0; i < 5000; ++i) {
+        if (i % 10 == 0) {
+            type();
+        }
+        EXPECT_TRUE(scan()) << "Scan " << i;
+        EXPECT_EQ(memcmp(master_view_of_slave, expected_view_of_slave, sizeof(expected_view_of_slave)), 0) << "Scan " << i;
+    }
+
+    uint32_t failures = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        failures += transport_loopback_get_stats(id)->failures;
+    }
+    EXPECT_GT(failures, 0) << "No errors were injected";
+    expect_in_sync();
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
+TEST_F(SplitTransportTest, RecoversFromFailedScans) {
+    configure(1000000, 10, 49152); // 75% of transactions fail
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    // A failed background read holds the link for the full timeout, i.e. for several scans
+    const size_t history_length = 1024;
+#else  // SPLIT_TRANSPORT_ASYNC
+    const size_t history_length = 64;
+#endif // SPLIT_TRANSPORT_ASYNC
+    std::deque<std::array<matrix_row_t, ROWS_PER_HAND>> history;
+    for (int i = 0; i < 2000; ++i) {
+        if (i % 10 == 0) {
+            type();
+        }
+        history.emplace_front();
+        memcpy(history.front().data(), slave_matrix, sizeof(slave_matrix));
+        history.resize(std::min(history.size(), history_length));
+
+        // Whatever happens, the master only ever sees a matrix the slave actually had, and never a torn one
+        bool okay  = scan();
+        bool seen  = std::any_of(history.begin(), history.end(), [&](auto &m) { return memcmp(master_view_of_slave, m.data(), sizeof(slave_matrix)) == 0; });
+        bool fresh = memcmp(master_view_of_slave, expected_view_of_slave, sizeof(expected_view_of_slave)) == 0;
+        EXPECT_TRUE(seen) << "Scan " << i;
+#ifndef SPLIT_TRANSPORT_ASYNC
+        // A background read can still be in progress, otherwise success means the latest matrix was read
+        EXPECT_TRUE(!okay || fresh) << "Scan " << i;
+#else  // SPLIT_TRANSPORT_ASYNC
+        (void)okay;
+        (void)fresh;
+#endif // SPLIT_TRANSPORT_ASYNC
+    }
+    EXPECT_GT(transport_loopback_get_link_stats()->failed_scans, 0) << "No scans failed";
+
+    // Once the link is clean again, everything catches up
+    configure(1000000, 10, 0);
+    for (int i = 0; i < 3; ++i) {
+        scan();
+    }
+    EXPECT_TRUE(scan());
+    expect_in_sync();
+}
+
+/**
+ * Host benchmark of the split link, with typing activity, at a few link speeds.
+ *
+ * Reports per-transaction wire bytes and round-trip times, and the resulting time spent in the transport per scan.
+ */
+TEST_F(SplitTransportTest, LinkBenchmark) {
+    struct {
+        uint32_t baud_rate, latency_us;
+        uint16_t error_rate;
+    } links[] = {{115200, 20, 0}, {460800, 20, 0}, {1000000, 5, 0}, {1000000, 5, 655}};
+
+    for (auto &link : links) {
+        configure(link.baud_rate, link.latency_us, link.error_rate);
+        for (int i = 0; i < 2000; ++i) {
+            if (i % 5 == 0) {
+                type();
+            }
+            scan();
+        }
+
+        const transport_loopback_link_stats_t *link_stats = transport_loopback_get_link_stats();
+        std::cout << link.baud_rate << " baud, " << link.latency_us << "us turnaround, " << std::fixed << std::setprecision(1) << (link.error_rate * 100.0 / 65536) << "% errors: " << std::setprecision(2) << (double)link_stats->elapsed_us / link_stats->scans << "us/scan avg, " << link_stats->max_scan_us << "us max, " << link_stats->failed_scans << " failed scans, longest failed run " << link_stats->max_failed_run << std::endl;
+        std::cout << "    id | count | fails | bytes/txn | us/txn avg | us max" << std::endl;
+        for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+            const transport_loopback_stats_t *s = transport_loopback_get_stats(id);
+            if (s->count == 0) {
+                continue;
+            }
+            uint32_t ok = s->count - s->failures;
+            std::cout << std::setw(6) << (int)id << " | " << std::setw(5) << s->count << " | " << std::setw(5) << s->failures << " | " << std::setw(9) << std::setprecision(1) << (ok ? (double)s->bytes / ok : 0.0) << " | " << std::setw(10) << (double)s->time_us / s->count << " | " << std::setw(6) << s->max_us << std::endl;
+        }
+
+        EXPECT_EQ(link_stats->scans, 2000);
+        if (link.error_rate == 0) {
+            EXPECT_EQ(link_stats->failed_scans, 0);
+        }
+    }
+}
+
+TEST_F(SplitTransportTest, StreamsAreReassembledInOrder) {
+    configure(1000000, 10, 6554); // 10% of transactions fail
+
+    std::vector<uint8_t> payload(1000);
+    for (int round = 0; round < 20; ++round) {
+        for (size_t i = 0; i < payload.size(); ++i) {
+            payload[i] = (uint8_t)(i * 31 + round);
+        }
+        EXPECT_TRUE(transaction_rpc_stream_send(USER_SYNC_STREAM, payload.size() - round, payload.data())) << "Round " << round;
+        EXPECT_EQ(streams_received, round + 1) << "Round " << round;
+        EXPECT_TRUE(streamed == std::vector<uint8_t>(payload.begin(), payload.end() - round)) << "Round " << round;
+    }
+    EXPECT_GT(transport_loopback_get_stats(PUT_RPC_STREAM_FRAGMENT)->failures, 0) << "No errors were injected";
+
+    // Oversized payloads are refused outright
+    EXPECT_FALSE(transaction_rpc_stream_send(USER_SYNC_STREAM, RPC_STREAM_BUFFER_SIZE + 1, payload.data()));
+    EXPECT_FALSE(transaction_rpc_stream_send(PUT_RPC_INFO, 10, payload.data()));
+}
+
+TEST_F(SplitTransportTest, StreamFragmentsMustKeepTheStreamLength) {
+    const rpc_stream_ack_t *ack = &transport_loopback_target_memory()->rpc_stream_ack;
+
+    auto send_fragment = [](uint8_t stream_id, uint8_t seq, uint16_t length) {
+        rpc_stream_fragment_t fragment = {.payload = {.length = length, .transaction_id = USER_SYNC_STREAM, .stream_id = stream_id, .seq = seq}};
+        memset(fragment.payload.data, seq + 1, sizeof(fragment.payload.data));
+        fragment.checksum = crc8(&fragment.payload, sizeof(fragment.payload));
+        EXPECT_TRUE(transport_execute_transaction(PUT_RPC_STREAM_FRAGMENT, &fragment, sizeof(fragment), NULL, 0));
+    };
+
+    const uint8_t  stream_id = ack->stream_id + 1;
+    const uint16_t length    = 3 * RPC_STREAM_FRAGMENT_SIZE;
+    send_fragment(stream_id, 0, length);
+    EXPECT_EQ(ack->next_seq, 1);
+
+    // A shorter length would put the fragment past the end of the stream
+    send_fragment(stream_id, 1, RPC_STREAM_FRAGMENT_SIZE / 2);
+    EXPECT_EQ(ack->next_seq, 1);
+    send_fragment(stream_id, 1, RPC_STREAM_BUFFER_SIZE);
+    EXPECT_EQ(ack->next_seq, 1);
+    EXPECT_EQ(streams_received, 0u);
+
+    send_fragment(stream_id, 1, length);
+    send_fragment(stream_id, 2, length);
+    EXPECT_EQ(ack->next_seq, 3);
+    ASSERT_EQ(streams_received, 1u);
+    ASSERT_EQ(streamed.size(), length);
+    EXPECT_EQ(streamed[0], 1);
+    EXPECT_EQ(streamed[RPC_STREAM_FRAGMENT_SIZE], 2);
+    EXPECT_EQ(streamed[length - 1], 3);
+}
+
+TEST_F(SplitTransportTest, StreamingGivesUpOnADeadLink) {
+    configure(1000000, 10, 65535);
+
+    // The slave may well have received everything, but the master can't know that without an acknowledgement
+    uint8_t payload[100] = {0};
+    EXPECT_FALSE(transaction_rpc_stream_send(USER_SYNC_STREAM, sizeof(payload), payload));
+    EXPECT_LE(transport_loopback_get_stats(GET_RPC_STREAM_ACK)->count, RPC_STREAM_MAX_STALLS + 1);
+}
+
+TEST_F(SplitTransportTest, StreamIdIsSyncedWithTheSlave) {
+    const rpc_stream_ack_t *ack         = &transport_loopback_target_memory()->rpc_stream_ack;
+    uint8_t                 payload[10] = {0};
+
+    // Giving up on a stream means the slave's ID has to be read again before the next one
+    configure(1000000, 10, 65535);
+    EXPECT_FALSE(transaction_rpc_stream_send(USER_SYNC_STREAM, sizeof(payload), payload));
+    configure(1000000, 10, 0);
+
+    // Without that read, there's no telling which IDs the slave has already acknowledged
+    transport_loopback_clear_stats();
+    transport_loopback_fail_next(RPC_STREAM_MAX_STALLS);
+    EXPECT_FALSE(transaction_rpc_stream_send(USER_SYNC_STREAM, sizeof(payload), payload));
+    EXPECT_EQ(transport_loopback_get_stats(GET_RPC_STREAM_ACK)->count, RPC_STREAM_MAX_STALLS);
+    EXPECT_EQ(transport_loopback_get_stats(PUT_RPC_STREAM_FRAGMENT)->count, 0u);
+
+    // The next stream picks up after the slave's last one
+    uint8_t last_id = ack->stream_id;
+    EXPECT_TRUE(transaction_rpc_stream_send(USER_SYNC_STREAM, sizeof(payload), payload));
+    EXPECT_EQ(ack->stream_id, (uint8_t)(last_id + 1));
+    EXPECT_EQ(streams_received, 1u);
+}
+
+/**
+ * Host benchmark of a large transfer to the slave: a stream, against the same data sent through one
+ * transaction_rpc_send() per RPC_M2S_BUFFER_SIZE chunk.
+ */
+TEST_F(SplitTransportTest, StreamBenchmark) {
+    configure(1000000, 5, 0);
+
+    std::vector<uint8_t> payload(RPC_STREAM_BUFFER_SIZE, 0xA5);
+    uint64_t             start = transport_loopback_get_link_stats()->elapsed_us;
+    for (size_t offset = 0; offset < payload.size(); offset += RPC_M2S_BUFFER_SIZE) {
+        EXPECT_TRUE(transaction_rpc_send(USER_SYNC_ECHO, std::min<size_t>(RPC_M2S_BUFFER_SIZE, payload.size() - offset), payload.data() + offset));
+    }
+    uint64_t chunked_us = transport_loopback_get_link_stats()->elapsed_us - start;
+
+    start = transport_loopback_get_link_stats()->elapsed_us;
+    EXPECT_TRUE(transaction_rpc_stream_send(USER_SYNC_STREAM, payload.size(), payload.data()));
+    uint64_t streamed_us = transport_loopback_get_link_stats()->elapsed_us - start;
+
+    std::cout << payload.size() << " bytes: " << chunked_us << "us through RPC calls, " << streamed_us << "us streamed (" << std::fixed << std::setprecision(1) << (double)payload.size() * 1000 / streamed_us << " bytes/ms)" << std::endl;
+    EXPECT_LT(streamed_us, chunked_us);
+}
+
+#ifdef SPLIT_TRANSPORT_BATCH
+TEST_F(SplitTransportTest, WritesAreBatched) {
+    master_matrix[0]  = 0x01;
+    layer_state       = 1UL << 1;
+    master_state.mods = 0x02;
+    master_state.leds = 0x04;
+    EXPECT_TRUE(scan());
+
+    // Every write that was due went out in the one exchange
+    EXPECT_EQ(transport_loopback_get_stats(EXECUTE_BATCH)->count, 1);
+    EXPECT_EQ(transport_loopback_get_stats(PUT_MASTER_MATRIX)->count, 0);
+    EXPECT_EQ(transport_loopback_get_stats(PUT_LAYER_STATE)->count, 0);
+    EXPECT_EQ(transport_loopback_get_stats(PUT_MODS)->count, 0);
+
+    EXPECT_TRUE(scan());
+    expect_in_sync();
+}
+#endif // SPLIT_TRANSPORT_BATCH
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+TEST_F(SplitTransportTest, SlaveMatrixIsReadInTheBackground) {
+    // Let the forced syncs go out, so that nothing but the slave matrix is due
+    for (int i = 0; i < 10; ++i) {
+        scan();
+    }
+    transport_loopback_clear_stats();
+
+    slave_matrix[2] = 0x24;
+    uint32_t before = timer_read32();
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(master_view_of_slave[2], 0) << "Read started before the change shouldn't have seen it";
+    EXPECT_LT(transaction_slave_matrix_timestamp(), before + 1) << "Stale data should carry its original timestamp";
+
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(master_view_of_slave[2], 0x24);
+    EXPECT_GE(transaction_slave_matrix_timestamp(), before) << "Fresh data should carry a newer timestamp";
+    EXPECT_LE(timer_elapsed32(transaction_slave_matrix_timestamp()), (2 * SCAN_PROCESSING_US) / 1000 + 1) << "Slave matrix should be at most a scan old";
+
+    // The master never waited on the wire
+    EXPECT_EQ(transport_loopback_get_link_stats()->elapsed_us, 0);
+    EXPECT_EQ(transport_loopback_get_stats(GET_SLAVE_MATRIX_ASYNC)->count, 2);
+    EXPECT_EQ(transport_loopback_get_stats(GET_SLAVE_MATRIX_CHECKSUM)->count, 0);
+}
+
+TEST_F(SplitTransportTest, FailedBackgroundReadFailsOneScan) {
+    for (int i = 0; i < 10; ++i) {
+        scan();
+    }
+    transport_loopback_clear_stats();
+
+    // The read started by this scan fails, and is only picked up once it has timed out
+    transport_loopback_fail_next(1);
+    EXPECT_TRUE(scan());
+    slave_matrix[1] = 0x42;
+    for (int i = 0; i < 20; ++i) {
+        scan();
+    }
+    EXPECT_EQ(transport_loopback_get_stats(GET_SLAVE_MATRIX_ASYNC)->failures, 1);
+    EXPECT_EQ(transport_loopback_get_link_stats()->failed_scans, 1) << "Failure should be reported by one scan only";
+    EXPECT_EQ(transport_loopback_get_link_stats()->polls, transport_loopback_get_link_stats()->scans) << "Background read shouldn't be retried";
+    EXPECT_EQ(master_view_of_slave[1], 0x42);
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
+#ifdef SPLIT_TRANSPORT_DELTA
+TEST_F(SplitTransportTest, ForcedSyncsSendWholeBuffers) {
+    // Ordinary changes go out as deltas
+    master_matrix[1] = 0x10;
+    slave_matrix[2]  = 0x20;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(transport_loopback_get_stats(GET_SLAVE_MATRIX_DATA)->resyncs, 0);
+    EXPECT_EQ(transport_loopback_get_stats(PUT_MASTER_MATRIX)->resyncs, 0);
+
+    // Past the default FORCED_SYNC_THROTTLE_MS
+    transport_loopback_idle(100 * 1000);
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(transport_loopback_get_stats(GET_SLAVE_MATRIX_DATA)->resyncs, 1);
+    EXPECT_EQ(transport_loopback_get_stats(PUT_MASTER_MATRIX)->resyncs, 1);
+    expect_in_sync();
+}
+
+TEST_F(SplitTransportTest, ChecksumMismatchSendsWholeBuffer) {
+    // The slave matrix arrives, but doesn't match the checksum sent ahead of it
+    slave_matrix[0] = 0x01;
+    transport_slave(slave_view_of_master, slave_matrix);
+    const_cast<split_shared_memory_t *>(transport_loopback_target_memory())->smatrix.matrix[0] ^= 0xFF;
+    EXPECT_FALSE(transport_master(master_matrix, master_view_of_slave));
+    EXPECT_GE(transport_loopback_get_stats(GET_SLAVE_MATRIX_DATA)->resyncs, 1);
+
+    EXPECT_TRUE(scan());
+    expect_in_sync();
+}
+#endif // SPLIT_TRANSPORT_DELTA
@@ -0,0 +1 @@
+TEST_LIST += split_delta split_transport split_transport_batch split_transport_async split_transport_delta serial_protocol
@@ -0,0 +1,304 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "transport_loopback.h"
+#include "transactions.h"
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+
+static split_shared_memory_t shared_memory;
+split_shared_memory_t *const split_shmem = &shared_memory;
+
+// Whichever half isn't running has its copy of the shared memory parked here
+static split_shared_memory_t parked_memory;
+static bool                  target_active = false;
+
+static transport_loopback_config_t     link_config;
+static transport_loopback_stats_t      stats[NUM_TOTAL_TRANSACTIONS];
+static transport_loopback_link_stats_t link_stats;
+static uint32_t                        rng_state;
+static uint32_t                        sub_ms;
+static uint32_t                        forced_failures;
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+static transport_async_status_t async_status = TRANSPORT_ASYNC_IDLE;
+static bool                     async_result;
+static uint64_t                 async_done_us;
+#endif // SPLIT_TRANSPORT_ASYNC
+
+static void swap_halves(void) {
+    split_shared_memory_t temp;
+    memcpy(&temp, &shared_memory, sizeof(temp));
+    memcpy(&shared_memory, &parked_memory, sizeof(temp));
+    memcpy(&parked_memory, &temp, sizeof(temp));
+    target_active = !target_active;
+}
+
+static uint32_t next_random(void) {
+    // xorshift32
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static void advance_clock(uint32_t us) {
+    link_stats.now_us += us;
+    sub_ms += us;
+    advance_time(sub_ms / 1000);
+    sub_ms %= 1000;
+}
+
+// Time the master spends blocked on the link
+static void spend(uint32_t us) {
+    link_stats.elapsed_us += us;
+    advance_clock(us);
+}
+
+// Time taken to send one run of bytes in a single direction
+static uint32_t segment_us(size_t length) {
+    return link_config.latency_us + (uint32_t)(((uint64_t)length * 10 * 1000000 + link_config.baud_rate - 1) / link_config.baud_rate);
+}
+
+#define for_each_transaction(ids, id) \
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) if ((ids) & (1UL << id))
+
+static void deliver_initiator2target(uint32_t ids) {
+    for_each_transaction(ids, id) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(((uint8_t *)&parked_memory) + trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    }
+}
+
+static void run_target_callbacks(uint32_t ids) {
+    swap_halves();
+    for_each_transaction(ids, id) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (trans->slave_callback) {
+            trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        }
+    }
+    swap_halves();
+}
+
+static void deliver_target2initiator(uint32_t ids) {
+    for_each_transaction(ids, id) {
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        memcpy(split_trans_target2initiator_buffer(trans), ((uint8_t *)&parked_memory) + trans->target2initiator_offset, trans->target2initiator_buffer_size);
+    }
+}
+
+/**
+ * Runs a single exchange over the link, made up of every transaction in ids, with a header of the supplied size.
+ * Statistics are accounted against stats_id, and the time it takes is returned in duration_us.
+ */
+static bool exchange(int8_t stats_id, uint32_t ids, size_t header_size, uint32_t *duration_us) {
+    size_t initiator2target_size = 0;
+    size_t target2initiator_size = 0;
+    for_each_transaction(ids, id) {
+        initiator2target_size += split_transaction_table[id].initiator2target_buffer_size;
+        target2initiator_size += split_transaction_table[id].target2initiator_buffer_size;
+    }
+
+    transport_loopback_stats_t *s = &stats[stats_id];
+    ++s->count;
+
+    bool fail = forced_failures > 0 || (link_config.error_rate > 0 && (next_random() & 0xFFFF) < link_config.error_rate);
+    if (forced_failures > 0) {
+        --forced_failures;
+    }
+    if (fail) {
+        // Either the request is lost on the way, or the target acts on it and the response is lost
+        if (next_random() & 1) {
+            deliver_initiator2target(ids);
+            run_target_callbacks(ids);
+        }
+        ++s->failures;
+        s->time_us += link_config.timeout_us;
+        if (link_config.timeout_us > s->max_us) {
+            s->max_us = link_config.timeout_us;
+        }
+        *duration_us = link_config.timeout_us;
+        return false;
+    }
+
+    uint32_t elapsed = segment_us(header_size) + segment_us(1);
+    if (initiator2target_size > 0) {
+        elapsed += segment_us(initiator2target_size);
+    }
+    if (target2initiator_size > 0) {
+        elapsed += segment_us(target2initiator_size);
+    }
+
+    deliver_initiator2target(ids);
+    run_target_callbacks(ids);
+    deliver_target2initiator(ids);
+
+    s->bytes += header_size + 1 + initiator2target_size + target2initiator_size;
+    s->time_us += elapsed;
+    if (elapsed > s->max_us) {
+        s->max_us = elapsed;
+    }
+    *duration_us = elapsed;
+    return true;
+}
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+// Brings the background exchange up to date with the clock, optionally waiting for it to complete
+static void async_update(bool wait) {
+    if (async_status != TRANSPORT_ASYNC_BUSY) {
+        return;
+    }
+    if (wait && link_stats.now_us < async_done_us) {
+        spend(async_done_us - link_stats.now_us);
+    }
+    if (link_stats.now_us >= async_done_us) {
+        async_status = async_result ? TRANSPORT_ASYNC_SUCCESS : TRANSPORT_ASYNC_FAILED;
+    }
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
+// Runs the exchange with the master waiting on it, once the link is free
+static bool exchange_blocking(int8_t stats_id, uint32_t ids, size_t header_size) {
+#ifdef SPLIT_TRANSPORT_ASYNC
+    async_update(true);
+#endif // SPLIT_TRANSPORT_ASYNC
+    uint32_t duration;
+    bool     okay = exchange(stats_id, ids, header_size, &duration);
+    spend(duration);
+    return okay;
+}
+
+void transport_loopback_reset(const transport_loopback_config_t *config) {
+    memcpy(&link_config, config, sizeof(link_config));
+    memset(&shared_memory, 0, sizeof(shared_memory));
+    memset(&parked_memory, 0, sizeof(parked_memory));
+    target_active   = false;
+    rng_state       = config->seed ? config->seed : 1;
+    sub_ms          = 0;
+    forced_failures = 0;
+#ifdef SPLIT_TRANSPORT_ASYNC
+    async_status = TRANSPORT_ASYNC_IDLE;
+#endif // SPLIT_TRANSPORT_ASYNC
+    transport_loopback_clear_stats();
+}
+
+void transport_loopback_clear_stats(void) {
+    uint64_t now = link_stats.now_us;
+    memset(stats, 0, sizeof(stats));
+    memset(&link_stats, 0, sizeof(link_stats));
+    link_stats.now_us = now;
+}
+
+void transport_loopback_fail_next(uint32_t count) {
+    forced_failures = count;
+}
+
+void transport_loopback_idle(uint32_t us) {
+    advance_clock(us);
+}
+
+const transport_loopback_stats_t *transport_loopback_get_stats(int8_t transaction_id) {
+    return &stats[transaction_id];
+}
+
+const transport_loopback_link_stats_t *transport_loopback_get_link_stats(void) {
+    return &link_stats;
+}
+
+bool transport_loopback_is_target(void) {
+    return target_active;
+}
+
+const split_shared_memory_t *transport_loopback_target_memory(void) {
+    return target_active ? &shared_memory : &parked_memory;
+}
+
+void transport_master_init(void) {}
+void transport_slave_init(void) {}
+
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    if (!exchange_blocking(id, 1UL << id, 1)) {
+        return false;
+    }
+
+    if (target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+    return true;
+}
+
+#ifdef SPLIT_TRANSPORT_DELTA
+void transport_resync_transaction(int8_t id) {
+    ++stats[id].resyncs;
+}
+#endif // SPLIT_TRANSPORT_DELTA
+
+#ifdef SPLIT_TRANSPORT_BATCH
+bool transport_execute_batch(uint32_t transaction_ids) {
+    // Transaction ID, then the table of contents and its complement, as sent by the serial protocol
+    return exchange_blocking(EXECUTE_BATCH, transaction_ids, 1 + 2 * ((NUM_TOTAL_TRANSACTIONS + 7) / 8));
+}
+#endif // SPLIT_TRANSPORT_BATCH
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+bool transport_start_transaction(int8_t id) {
+    async_update(false);
+    if (async_status != TRANSPORT_ASYNC_IDLE) {
+        return false;
+    }
+
+    // The target's data is captured as the exchange starts, but the master only sees it once the exchange completes
+    uint32_t duration;
+    async_result  = exchange(id, 1UL << id, 1, &duration);
+    async_done_us = link_stats.now_us + duration;
+    async_status  = TRANSPORT_ASYNC_BUSY;
+    return true;
+}
+
+transport_async_status_t transport_poll_transaction(void) {
+    ++link_stats.polls;
+    async_update(false);
+    transport_async_status_t status = async_status;
+    if (status != TRANSPORT_ASYNC_BUSY) {
+        async_status = TRANSPORT_ASYNC_IDLE;
+    }
+    return status;
+}
+#endif // SPLIT_TRANSPORT_ASYNC
+
+bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    uint64_t start = link_stats.elapsed_us;
+    bool     okay  = transactions_master(master_matrix, slave_matrix);
+
+    uint32_t elapsed = link_stats.elapsed_us - start;
+    if (elapsed > link_stats.max_scan_us) {
+        link_stats.max_scan_us = elapsed;
+    }
+    ++link_stats.scans;
+    if (okay) {
+        link_stats.failed_run = 0;
+    } else {
+        ++link_stats.failed_scans;
+        if (++link_stats.failed_run > link_stats.max_failed_run) {
+            link_stats.max_failed_run = link_stats.failed_run;
+        }
+    }
+    return okay;
+}
+
+void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    swap_halves();
+    transactions_slave(master_matrix, slave_matrix);
+    swap_halves();
+}
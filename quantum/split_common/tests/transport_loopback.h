@@ -0,0 +1,71 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "transport.h"
+
+/* Host-side loopback implementation of transport.h.
+ *
+ * Both halves run in the one process: the transport keeps a separate copy of split_shmem for the target, and swaps it
+ * in whenever target-side code runs, i.e. slave callbacks and transport_slave(). Wire time is accounted for on a
+ * simulated clock, which also drives the platform timer so that the throttled syncs behave as they would on hardware.
+ *
+ * Each transaction is modelled on the serial protocol: the transaction ID, a handshake back from the target, then the
+ * initiator-to-target and target-to-initiator buffers in full. Every change of direction costs the configured latency.
+ *
+ * With SPLIT_TRANSPORT_DELTA, buffers are still sent in full, but requests for a full transfer are counted.
+ *
+ * With SPLIT_TRANSPORT_ASYNC, a background transaction is carried out as soon as it's started, but its result is
+ * only reported once the simulated clock has passed its completion. The link is busy in the meantime.
+ */
+
+typedef struct {
+    uint32_t baud_rate;  // bits per second, at 10 bits per byte
+    uint32_t latency_us; // added each time the line turns around
+    uint32_t timeout_us; // time lost to a failed transaction
+    uint16_t error_rate; // chance of a transaction failing, out of 65536
+    uint32_t seed;       // for the error injection
+} transport_loopback_config_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t failures;
+    uint32_t bytes;   // on the wire, including the ID and handshake
+    uint64_t time_us; // total round-trip time, including failures
+    uint32_t max_us;  // longest round-trip
+    uint32_t resyncs; // full transfers requested, with SPLIT_TRANSPORT_DELTA
+} transport_loopback_stats_t;
+
+typedef struct {
+    uint32_t scans;
+    uint32_t failed_scans;
+    uint32_t max_failed_run;  // longest run of consecutive failed scans
+    uint32_t max_scan_us;     // longest time spent in transport_master()
+    uint32_t failed_run;      // current run of consecutive failed scans
+    uint64_t elapsed_us;      // total time the master spent waiting on the link
+    uint64_t now_us;          // simulated time, which carries on across resets
+    uint32_t polls;           // calls to transport_poll_transaction(), with SPLIT_TRANSPORT_ASYNC
+} transport_loopback_link_stats_t;
+
+// Clears both halves' shared memory and the statistics, and applies the supplied link configuration
+void transport_loopback_reset(const transport_loopback_config_t *config);
+void transport_loopback_clear_stats(void);
+
+// Makes the next count transactions fail, on top of the configured error rate
+void transport_loopback_fail_next(uint32_t count);
+
+// Lets simulated time pass without the master waiting on the link, e.g. while the rest of the scan is processed
+void transport_loopback_idle(uint32_t us);
+
+const transport_loopback_stats_t *     transport_loopback_get_stats(int8_t transaction_id);
+const transport_loopback_link_stats_t *transport_loopback_get_link_stats(void);
+
+// Whether the code currently running is on the target half
+bool transport_loopback_is_target(void);
+
+// The target half's view of the shared memory, for inspection
+const split_shared_memory_t *transport_loopback_target_memory(void);
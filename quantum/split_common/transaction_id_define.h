@@ -16,6 +16,10 @@
 
 #pragma once
 
+#ifdef __cplusplus
+#    define _Static_assert static_assert
+#endif
+
 enum serial_transaction_id {
 #ifdef USE_I2C
     I2C_EXECUTE_CALLBACK,
@@ -23,6 +27,9 @@ enum serial_transaction_id {
 
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
+#ifdef SPLIT_TRANSPORT_ASYNC
+    GET_SLAVE_MATRIX_ASYNC,
+#endif // SPLIT_TRANSPORT_ASYNC
 
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
@@ -84,11 +91,19 @@ enum serial_transaction_id {
     PUT_POINTING_CPI,
 #endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
+#ifdef SPLIT_TRANSPORT_BATCH
+    EXECUTE_BATCH,
+#endif // SPLIT_TRANSPORT_BATCH
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
     PUT_RPC_INFO,
     PUT_RPC_REQ_DATA,
     EXECUTE_RPC,
     GET_RPC_RESP_DATA,
+#    ifdef SPLIT_RPC_STREAM_ENABLE
+    PUT_RPC_STREAM_FRAGMENT,
+    GET_RPC_STREAM_ACK,
+#    endif // SPLIT_RPC_STREAM_ENABLE
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 // keyboard-specific
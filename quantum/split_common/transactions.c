@@ -43,15 +43,76 @@
     { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#ifdef SPLIT_TRANSPORT_DELTA
+#    define trans_initiator2target_initializer_delta(member) \
+        { sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), 0, 0, NULL, true }
+#    define trans_target2initiator_initializer_delta(member) \
+        { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), NULL, true }
+#else // SPLIT_TRANSPORT_DELTA
+#    define trans_initiator2target_initializer_delta(member) trans_initiator2target_initializer(member)
+#    define trans_target2initiator_initializer_delta(member) trans_target2initiator_initializer(member)
+#endif // SPLIT_TRANSPORT_DELTA
+
+#ifdef SPLIT_TRANSPORT_BATCH
+#    define transport_write(id, data, length) transport_write_batched(id, data, length)
+#else // SPLIT_TRANSPORT_BATCH
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#endif // SPLIT_TRANSPORT_BATCH
 #define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
 
+#ifdef SPLIT_TRANSPORT_DELTA
+#    define transport_resync(id) transport_resync_transaction(id)
+#else // SPLIT_TRANSPORT_DELTA
+#    define transport_resync(id)
+#endif // SPLIT_TRANSPORT_DELTA
+
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
 void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+#    ifdef SPLIT_RPC_STREAM_ENABLE
+void slave_rpc_stream_fragment_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
+#        define LAST_CORE_TRANSACTION_ID GET_RPC_STREAM_ACK
+#    else // SPLIT_RPC_STREAM_ENABLE
+#        define LAST_CORE_TRANSACTION_ID GET_RPC_RESP_DATA
+#    endif // SPLIT_RPC_STREAM_ENABLE
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+////////////////////////////////////////////////////
+// Batching
+
+#ifdef SPLIT_TRANSPORT_BATCH
+
+static bool     batch_active  = false;
+static uint32_t batch_pending = 0;
+
+// While the master handlers run, writes are queued up in split_shmem and sent together once they've all had a chance to run
+static bool transport_write_batched(int8_t id, const void *data, uint16_t length) {
+    if (!batch_active) {
+        return transport_execute_transaction(id, data, length, NULL, 0);
+    }
+
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    size_t                    len   = trans->initiator2target_buffer_size < length ? trans->initiator2target_buffer_size : length;
+    memcpy(split_trans_initiator2target_buffer(trans), data, len);
+    batch_pending |= (1UL << id);
+    return true;
+}
+
+// Anything left pending after a failure is sent again along with the next batch
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    if (batch_pending == 0) {
+        return true;
+    }
+    if (!transport_execute_batch(batch_pending)) {
+        return false;
+    }
+    batch_pending = 0;
+    return true;
+}
+
+#endif // SPLIT_TRANSPORT_BATCH
+
 ////////////////////////////////////////////////////
 // Helpers
 
@@ -85,12 +146,19 @@ static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_
 
 inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t trans_id_retrieve, uint32_t *last_update, void *destination, const void *equiv_shmem, size_t length) {
     uint8_t curr_checksum;
-    bool    okay = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
-    if (okay && (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || curr_checksum != crc8(equiv_shmem, length))) {
+    bool    okay   = transport_read(trans_id_checksum, &curr_checksum, sizeof(curr_checksum));
+    bool    forced = timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS;
+    if (okay && (forced || curr_checksum != crc8(equiv_shmem, length))) {
+        // A forced sync fetches the whole buffer, so that a delta-encoded copy can't stay out of step indefinitely
+        if (forced) {
+            transport_resync(trans_id_retrieve);
+        }
         okay &= transport_read(trans_id_retrieve, destination, length);
         okay &= curr_checksum == crc8(equiv_shmem, length);
         if (okay) {
             *last_update = timer_read32();
+        } else {
+            transport_resync(trans_id_retrieve);
         }
     } else {
         memcpy(destination, equiv_shmem, length);
@@ -99,8 +167,13 @@ inline static bool read_if_checksum_mismatch(int8_t trans_id_checksum, int8_t tr
 }
 
 inline static bool send_if_condition(int8_t trans_id, uint32_t *last_update, bool condition, void *source, size_t length) {
-    bool okay = true;
-    if (timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS || condition) {
+    bool okay   = true;
+    bool forced = timer_elapsed32(*last_update) >= FORCED_SYNC_THROTTLE_MS;
+    if (forced || condition) {
+        // A forced sync sends the whole buffer, so that a delta-encoded copy can't stay out of step indefinitely
+        if (forced) {
+            transport_resync(trans_id);
+        }
         okay &= transport_write(trans_id, source, length);
         if (okay) {
             *last_update = timer_read32();
@@ -117,32 +190,92 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+static matrix_row_t last_slave_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
+static uint32_t     slave_matrix_timestamp               = 0;
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+
+// The slave matrix is read in the background, started at the end of each scan and picked up at the start of the next
+static uint32_t slave_matrix_async_started = 0;
+
+// Only the scan that picks up a failed read reports it
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    bool okay = true;
+    switch (transport_poll_transaction()) {
+        case TRANSPORT_ASYNC_SUCCESS:
+            // The checksum and matrix are read together, so they can be checked against each other
+            okay = split_shmem->smatrix.checksum == crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+            if (okay) {
+                memcpy(last_slave_matrix, split_shmem->smatrix.matrix, sizeof(last_slave_matrix));
+                slave_matrix_timestamp = slave_matrix_async_started;
+            }
+            break;
+        case TRANSPORT_ASYNC_FAILED:
+            okay = false;
+            break;
+        default:
+            // Still in progress, or nothing was started -- carry on with what we had
+            break;
+    }
+    // Copy out the last-known-good matrix state to the slave matrix
+    memcpy(slave_matrix, last_slave_matrix, sizeof(last_slave_matrix));
+    return okay;
+}
+
+static void slave_matrix_start_async(void) {
+    if (transport_start_transaction(GET_SLAVE_MATRIX_ASYNC)) {
+        slave_matrix_async_started = timer_read32();
+    }
+}
+
+// Retrying would only poll the same background read again, so the handler is run once per scan
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER()                                \
+        do {                                                                  \
+            if (!slave_matrix_handlers_master(master_matrix, slave_matrix)) { \
+                dprintf("Failed to execute slave_matrix\n");                  \
+                return false;                                                 \
+            }                                                                 \
+        } while (0)
+#    define TRANSACTIONS_SLAVE_MATRIX_ASYNC_REGISTRATIONS [GET_SLAVE_MATRIX_ASYNC] = trans_target2initiator_initializer(smatrix),
+
+#else // SPLIT_TRANSPORT_ASYNC
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
-    static uint32_t     last_update                    = 0;
-    static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
-    matrix_row_t        temp_matrix[(MATRIX_ROWS) / 2];       // holding area while we test whether or not checksum is correct
+    static uint32_t last_update = 0;
+    matrix_row_t    temp_matrix[(MATRIX_ROWS) / 2]; // holding area while we test whether or not checksum is correct
+    uint32_t        now = timer_read32();
 
     bool okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
     if (okay) {
         // Checksum matches the received data, save as the last matrix state
-        memcpy(last_matrix, temp_matrix, sizeof(temp_matrix));
+        memcpy(last_slave_matrix, temp_matrix, sizeof(temp_matrix));
+        slave_matrix_timestamp = now;
     }
     // Copy out the last-known-good matrix state to the slave matrix
-    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    memcpy(slave_matrix, last_slave_matrix, sizeof(last_slave_matrix));
     return okay;
 }
 
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_ASYNC_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_ASYNC
+
 static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
     split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
 }
 
+uint32_t transaction_slave_matrix_timestamp(void) {
+    return slave_matrix_timestamp;
+}
+
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(slave_matrix)
 #define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
-    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
+    [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer_delta(smatrix.matrix), \
+    TRANSACTIONS_SLAVE_MATRIX_ASYNC_REGISTRATIONS
 // clang-format on
 
 ////////////////////////////////////////////////////
@@ -162,7 +295,7 @@ static void master_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_ro
 
 #    define TRANSACTIONS_MASTER_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(master_matrix)
 #    define TRANSACTIONS_MASTER_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(master_matrix)
-#    define TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS [PUT_MASTER_MATRIX] = trans_initiator2target_initializer(mmatrix.matrix),
+#    define TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS [PUT_MASTER_MATRIX] = trans_initiator2target_initializer_delta(mmatrix.matrix),
 
 #else // SPLIT_TRANSPORT_MIRROR
 
@@ -200,7 +333,7 @@ static void encoder_handlers_slave(matrix_row_t master_matrix[], matrix_row_t sl
 #    define TRANSACTIONS_ENCODERS_SLAVE() TRANSACTION_HANDLER_SLAVE(encoder)
 #    define TRANSACTIONS_ENCODERS_REGISTRATIONS \
     [GET_ENCODERS_CHECKSUM] = trans_target2initiator_initializer(encoders.checksum), \
-    [GET_ENCODERS_DATA]     = trans_target2initiator_initializer(encoders.state),
+    [GET_ENCODERS_DATA]     = trans_target2initiator_initializer_delta(encoders.state),
 // clang-format on
 
 #else // ENCODER_ENABLE
@@ -426,7 +559,7 @@ static void rgblight_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 
 #    define TRANSACTIONS_RGBLIGHT_MASTER() TRANSACTION_HANDLER_MASTER(rgblight)
 #    define TRANSACTIONS_RGBLIGHT_SLAVE() TRANSACTION_HANDLER_SLAVE(rgblight)
-#    define TRANSACTIONS_RGBLIGHT_REGISTRATIONS [PUT_RGBLIGHT] = trans_initiator2target_initializer(rgblight_sync),
+#    define TRANSACTIONS_RGBLIGHT_REGISTRATIONS [PUT_RGBLIGHT] = trans_initiator2target_initializer_delta(rgblight_sync),
 
 #else // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
 
@@ -456,7 +589,7 @@ static void led_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #    define TRANSACTIONS_LED_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(led_matrix)
 #    define TRANSACTIONS_LED_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(led_matrix)
-#    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer(led_matrix_sync),
+#    define TRANSACTIONS_LED_MATRIX_REGISTRATIONS [PUT_LED_MATRIX] = trans_initiator2target_initializer_delta(led_matrix_sync),
 
 #else // defined(LED_MATRIX_ENABLE) && defined(LED_MATRIX_SPLIT)
 
@@ -486,7 +619,7 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #    define TRANSACTIONS_RGB_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix)
 #    define TRANSACTIONS_RGB_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix)
-#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer(rgb_matrix_sync),
+#    define TRANSACTIONS_RGB_MATRIX_REGISTRATIONS [PUT_RGB_MATRIX] = trans_initiator2target_initializer_delta(rgb_matrix_sync),
 
 #else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
@@ -653,7 +786,7 @@ static void pointing_handlers_slave(matrix_row_t master_matrix[], matrix_row_t s
 
 #    define TRANSACTIONS_POINTING_MASTER() TRANSACTION_HANDLER_MASTER(pointing)
 #    define TRANSACTIONS_POINTING_SLAVE() TRANSACTION_HANDLER_SLAVE(pointing)
-#    define TRANSACTIONS_POINTING_REGISTRATIONS [GET_POINTING_CHECKSUM] = trans_target2initiator_initializer(pointing.checksum), [GET_POINTING_DATA] = trans_target2initiator_initializer(pointing.report), [PUT_POINTING_CPI] = trans_initiator2target_initializer(pointing.cpi),
+#    define TRANSACTIONS_POINTING_REGISTRATIONS [GET_POINTING_CHECKSUM] = trans_target2initiator_initializer(pointing.checksum), [GET_POINTING_DATA] = trans_target2initiator_initializer_delta(pointing.report), [PUT_POINTING_CPI] = trans_initiator2target_initializer(pointing.cpi),
 
 #else // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
 
@@ -696,10 +829,14 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     [PUT_RPC_REQ_DATA]  = trans_initiator2target_initializer(rpc_m2s_buffer),
     [EXECUTE_RPC]       = trans_initiator2target_initializer_cb(rpc_info.payload.transaction_id, slave_rpc_exec_callback),
     [GET_RPC_RESP_DATA] = trans_target2initiator_initializer(rpc_s2m_buffer),
+#    ifdef SPLIT_RPC_STREAM_ENABLE
+    [PUT_RPC_STREAM_FRAGMENT] = trans_initiator2target_initializer_cb(rpc_stream_fragment, slave_rpc_stream_fragment_callback),
+    [GET_RPC_STREAM_ACK]      = trans_target2initiator_initializer(rpc_stream_ack),
+#    endif // SPLIT_RPC_STREAM_ENABLE
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
-bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+static bool transactions_master_handlers(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
     TRANSACTIONS_ENCODERS_MASTER();
@@ -718,6 +855,23 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     return true;
 }
 
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+#ifdef SPLIT_TRANSPORT_BATCH
+    batch_active = true;
+    bool okay    = transactions_master_handlers(master_matrix, slave_matrix);
+    batch_active = false;
+    okay         = okay && transaction_handler_master(master_matrix, slave_matrix, "batch", &batch_handlers_master);
+#else  // SPLIT_TRANSPORT_BATCH
+    bool okay = transactions_master_handlers(master_matrix, slave_matrix);
+#endif // SPLIT_TRANSPORT_BATCH
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+    // Leave the slave matrix read running while the rest of the scan is processed, whether or not this scan succeeded
+    slave_matrix_start_async();
+#endif // SPLIT_TRANSPORT_ASYNC
+    return okay;
+}
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
@@ -740,7 +894,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
 
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback) {
     // Prevent invoking RPC on QMK core sync data
-    if (transaction_id <= GET_RPC_RESP_DATA) return;
+    if (transaction_id <= LAST_CORE_TRANSACTION_ID) return;
 
     // Set the callback
     split_transaction_table[transaction_id].slave_callback          = callback;
@@ -754,7 +908,7 @@ bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer
         return false;
     }
     // Prevent invoking RPC on QMK core sync data
-    if (transaction_id <= GET_RPC_RESP_DATA) return false;
+    if (transaction_id <= LAST_CORE_TRANSACTION_ID) return false;
     // Prevent sizing issues
     if (initiator2target_buffer_size > RPC_M2S_BUFFER_SIZE) return false;
     if (target2initiator_buffer_size > RPC_S2M_BUFFER_SIZE) return false;
@@ -813,4 +967,125 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
     }
 }
 
+#    ifdef SPLIT_RPC_STREAM_ENABLE
+
+_Static_assert(sizeof(rpc_stream_fragment_t) <= UINT8_MAX, "RPC_STREAM_FRAGMENT_SIZE is too large");
+_Static_assert(RPC_STREAM_BUFFER_SIZE <= UINT8_MAX * RPC_STREAM_FRAGMENT_SIZE, "RPC_STREAM_BUFFER_SIZE needs more fragments than can be numbered");
+
+static rpc_stream_callback_t rpc_stream_callbacks[NUM_TOTAL_TRANSACTIONS - (LAST_CORE_TRANSACTION_ID + 1)] = {NULL};
+
+void transaction_register_rpc_stream(int8_t transaction_id, rpc_stream_callback_t callback) {
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id <= LAST_CORE_TRANSACTION_ID || transaction_id >= NUM_TOTAL_TRANSACTIONS) return;
+
+    rpc_stream_callbacks[transaction_id - (LAST_CORE_TRANSACTION_ID + 1)] = callback;
+}
+
+bool transaction_rpc_stream_send(int8_t transaction_id, uint16_t length, const void *data) {
+    static uint8_t stream_id        = 0;
+    static bool    stream_id_synced = false;
+
+    // Prevent transaction attempts while transport is disconnected
+    if (!is_transport_connected()) {
+        return false;
+    }
+    // Prevent invoking RPC on QMK core sync data
+    if (transaction_id <= LAST_CORE_TRANSACTION_ID || transaction_id >= NUM_TOTAL_TRANSACTIONS) return false;
+    // Prevent sizing issues
+    if (length == 0 || length > RPC_STREAM_BUFFER_SIZE) return false;
+
+    // A fresh stream ID per call, so that stragglers from an abandoned stream can't be mistaken for this one. The first
+    // time round, and after giving up on a stream, start after whatever the slave saw last, as it may have outlived a
+    // previous master session. Guessing instead could reuse the ID the slave has already acknowledged.
+    rpc_stream_ack_t ack;
+    uint8_t          stalls = 0;
+    while (!stream_id_synced) {
+        if (transport_read(GET_RPC_STREAM_ACK, &ack, sizeof(ack))) {
+            stream_id        = ack.stream_id;
+            stream_id_synced = true;
+        } else if (++stalls >= RPC_STREAM_MAX_STALLS) {
+            dprintf("Failed to sync RPC stream %d\n", (int)transaction_id);
+            return false;
+        }
+    }
+    ++stream_id;
+
+    uint8_t fragments = (length + RPC_STREAM_FRAGMENT_SIZE - 1) / RPC_STREAM_FRAGMENT_SIZE;
+    uint8_t acked     = 0;
+    stalls            = 0;
+    while (acked < fragments) {
+        // Send a window's worth of fragments back to back. Any that go missing show up in the acknowledgement, as the
+        // slave only takes fragments in order, and the window is resent from there (go-back-N).
+        uint8_t window_end = (fragments - acked > RPC_STREAM_WINDOW) ? acked + RPC_STREAM_WINDOW : fragments;
+        for (uint8_t seq = acked; seq < window_end; ++seq) {
+            uint16_t              offset   = (uint16_t)seq * RPC_STREAM_FRAGMENT_SIZE;
+            uint16_t              size     = (length - offset > RPC_STREAM_FRAGMENT_SIZE) ? RPC_STREAM_FRAGMENT_SIZE : length - offset;
+            rpc_stream_fragment_t fragment = {.payload = {.length = length, .transaction_id = transaction_id, .stream_id = stream_id, .seq = seq}};
+            memcpy(fragment.payload.data, ((const uint8_t *)data) + offset, size);
+            fragment.checksum = crc8(&fragment.payload, sizeof(fragment.payload));
+            transport_write(PUT_RPC_STREAM_FRAGMENT, &fragment, sizeof(fragment));
+        }
+
+        if (transport_read(GET_RPC_STREAM_ACK, &ack, sizeof(ack)) && ack.stream_id == stream_id && ack.next_seq > acked && ack.next_seq <= fragments) {
+            acked  = ack.next_seq;
+            stalls = 0;
+        } else if (++stalls >= RPC_STREAM_MAX_STALLS) {
+            dprintf("Failed to stream RPC %d\n", (int)transaction_id);
+            stream_id_synced = false;
+            return false;
+        }
+    }
+    return true;
+}
+
+void slave_rpc_stream_fragment_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    static uint8_t  buffer[RPC_STREAM_BUFFER_SIZE];
+    static uint16_t length   = 0;
+    static bool     complete = false;
+
+    const rpc_stream_fragment_t *fragment = &split_shmem->rpc_stream_fragment;
+    rpc_stream_ack_t *           ack      = &split_shmem->rpc_stream_ack;
+    if (crc8(&fragment->payload, sizeof(fragment->payload)) != fragment->checksum) {
+        return;
+    }
+
+    // The first fragment of a new stream resets reassembly; anything else from another stream is a straggler
+    if (fragment->payload.stream_id != ack->stream_id) {
+        if (fragment->payload.seq != 0 || fragment->payload.length > RPC_STREAM_BUFFER_SIZE) {
+            return;
+        }
+        ack->stream_id = fragment->payload.stream_id;
+        ack->next_seq  = 0;
+        length         = fragment->payload.length;
+        complete       = false;
+    }
+
+    // Duplicates and fragments that arrive after a gap are dropped, and the master resends from the acknowledged point.
+    // Every fragment of a stream carries its length, which must not change halfway through.
+    if (complete || fragment->payload.seq != ack->next_seq || fragment->payload.length != length) {
+        return;
+    }
+
+    uint16_t offset = (uint16_t)fragment->payload.seq * RPC_STREAM_FRAGMENT_SIZE;
+    if (offset >= length) {
+        return;
+    }
+    uint16_t size = (length - offset > RPC_STREAM_FRAGMENT_SIZE) ? RPC_STREAM_FRAGMENT_SIZE : length - offset;
+    memcpy(buffer + offset, fragment->payload.data, size);
+    ++ack->next_seq;
+
+    if (offset + size == length) {
+        complete              = true;
+        int8_t transaction_id = fragment->payload.transaction_id;
+        if (transaction_id > LAST_CORE_TRANSACTION_ID && transaction_id < NUM_TOTAL_TRANSACTIONS) {
+            rpc_stream_callback_t callback = rpc_stream_callbacks[transaction_id - (LAST_CORE_TRANSACTION_ID + 1)];
+            if (callback) {
+                callback(length, buffer);
+            }
+        }
+    }
+}
+
+#    endif // SPLIT_RPC_STREAM_ENABLE
+
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
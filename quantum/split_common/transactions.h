@@ -32,6 +32,9 @@ typedef struct _split_transaction_desc_t {
     uint8_t          target2initiator_buffer_size;
     uint16_t         target2initiator_offset;
     slave_callback_t slave_callback;
+#ifdef SPLIT_TRANSPORT_DELTA
+    bool delta_encoded;
+#endif // SPLIT_TRANSPORT_DELTA
 } split_transaction_desc_t;
 
 // Forward declaration for the split transactions
@@ -45,9 +48,22 @@ extern split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS];
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
+// Time at which the slave matrix last given out by transactions_master() was known to be current
+uint32_t transaction_slave_matrix_timestamp(void);
+
 void transaction_register_rpc(int8_t transaction_id, slave_callback_t callback);
 
 bool transaction_rpc_exec(int8_t transaction_id, uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 
 #define transaction_rpc_send(transaction_id, initiator2target_buffer_size, initiator2target_buffer) transaction_rpc_exec(transaction_id, initiator2target_buffer_size, initiator2target_buffer, 0, NULL)
 #define transaction_rpc_recv(transaction_id, target2initiator_buffer_size, target2initiator_buffer) transaction_rpc_exec(transaction_id, 0, NULL, target2initiator_buffer_size, target2initiator_buffer)
+
+#ifdef SPLIT_RPC_STREAM_ENABLE
+typedef void (*rpc_stream_callback_t)(uint16_t length, const void *data);
+
+// Registers a slave-side callback for streams sent to transaction_id, which is invoked once the whole payload has arrived
+void transaction_register_rpc_stream(int8_t transaction_id, rpc_stream_callback_t callback);
+
+// Sends a payload of up to RPC_STREAM_BUFFER_SIZE bytes to the slave, in fragments; returns false if it couldn't be delivered
+bool transaction_rpc_stream_send(int8_t transaction_id, uint16_t length, const void *data);
+#endif // SPLIT_RPC_STREAM_ENABLE
@@ -86,6 +86,35 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    if defined(SPLIT_TRANSPORT_BATCH) || defined(SPLIT_TRANSPORT_ASYNC)
+// Executes the transaction using the data already in split_shmem
+static bool transport_execute_shmem(int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (trans->initiator2target_buffer_size > 0 && i2c_writeReg(SLAVE_I2C_ADDRESS, trans->initiator2target_offset, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, SLAVE_I2C_TIMEOUT) < 0) {
+        return false;
+    }
+    if (transport_trigger_callback(id) < 0) {
+        return false;
+    }
+    if (trans->target2initiator_buffer_size > 0 && i2c_readReg(SLAVE_I2C_ADDRESS, trans->target2initiator_offset, split_trans_target2initiator_buffer(trans), trans->target2initiator_buffer_size, SLAVE_I2C_TIMEOUT) < 0) {
+        return false;
+    }
+    return true;
+}
+#    endif // defined(SPLIT_TRANSPORT_BATCH) || defined(SPLIT_TRANSPORT_ASYNC)
+
+#    ifdef SPLIT_TRANSPORT_BATCH
+bool transport_execute_batch(uint32_t transaction_ids) {
+    // Each transaction is a separate register access regardless, so there's nothing to gain from framing them together
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if ((transaction_ids & (1UL << id)) && !transport_execute_shmem(id)) {
+            return false;
+        }
+    }
+    return true;
+}
+#    endif // SPLIT_TRANSPORT_BATCH
+
 #else // USE_I2C
 
 #    include "serial.h"
@@ -119,8 +148,70 @@ bool transport_execute_transaction(int8_t id, const void *initiator2target_buf,
     return true;
 }
 
+#    if defined(SERIAL_DRIVER_BITBANG) && (defined(SPLIT_TRANSPORT_BATCH) || defined(SPLIT_TRANSPORT_ASYNC))
+static bool transport_execute_shmem(int8_t id) {
+    return soft_serial_transaction(id);
+}
+#    endif // defined(SERIAL_DRIVER_BITBANG) && (defined(SPLIT_TRANSPORT_BATCH) || defined(SPLIT_TRANSPORT_ASYNC))
+
+#    ifdef SPLIT_TRANSPORT_BATCH
+bool transport_execute_batch(uint32_t transaction_ids) {
+#        ifdef SERIAL_DRIVER_BITBANG
+    // The bitbang driver has no framing support, so fall back to a transaction at a time
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if ((transaction_ids & (1UL << id)) && !transport_execute_shmem(id)) {
+            return false;
+        }
+    }
+    return true;
+#        else  // SERIAL_DRIVER_BITBANG
+    return soft_serial_batch(transaction_ids);
+#        endif // SERIAL_DRIVER_BITBANG
+}
+#    endif // SPLIT_TRANSPORT_BATCH
+
+#    if defined(SPLIT_TRANSPORT_DELTA) && !defined(SERIAL_DRIVER_BITBANG)
+void transport_resync_transaction(int8_t id) {
+    soft_serial_resync(id);
+}
+#    endif // defined(SPLIT_TRANSPORT_DELTA) && !defined(SERIAL_DRIVER_BITBANG)
+
+#    if defined(SPLIT_TRANSPORT_ASYNC) && !defined(SERIAL_DRIVER_BITBANG)
+bool transport_start_transaction(int8_t id) {
+    return soft_serial_transaction_start(id);
+}
+
+transport_async_status_t transport_poll_transaction(void) {
+    return soft_serial_transaction_poll();
+}
+#    endif // defined(SPLIT_TRANSPORT_ASYNC) && !defined(SERIAL_DRIVER_BITBANG)
+
 #endif // USE_I2C
 
+#if defined(SPLIT_TRANSPORT_DELTA) && (defined(USE_I2C) || defined(SERIAL_DRIVER_BITBANG))
+// Neither transport delta-encodes, so every exchange already carries the whole buffer
+void transport_resync_transaction(int8_t id) {}
+#endif // defined(SPLIT_TRANSPORT_DELTA) && (defined(USE_I2C) || defined(SERIAL_DRIVER_BITBANG))
+
+#if defined(SPLIT_TRANSPORT_ASYNC) && (defined(USE_I2C) || defined(SERIAL_DRIVER_BITBANG))
+// Neither transport can transfer in the background, so the transaction runs as soon as it's started, and its result is reported on the next poll
+static transport_async_status_t async_status = TRANSPORT_ASYNC_IDLE;
+
+bool transport_start_transaction(int8_t id) {
+    if (async_status != TRANSPORT_ASYNC_IDLE) {
+        return false;
+    }
+    async_status = transport_execute_shmem(id) ? TRANSPORT_ASYNC_SUCCESS : TRANSPORT_ASYNC_FAILED;
+    return true;
+}
+
+transport_async_status_t transport_poll_transaction(void) {
+    transport_async_status_t status = async_status;
+    async_status                    = TRANSPORT_ASYNC_IDLE;
+    return status;
+}
+#endif // defined(SPLIT_TRANSPORT_ASYNC) && (defined(USE_I2C) || defined(SERIAL_DRIVER_BITBANG))
+
 bool transport_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     return transactions_master(master_matrix, slave_matrix);
 }
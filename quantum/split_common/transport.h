@@ -31,6 +31,25 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifdef SPLIT_RPC_STREAM_ENABLE
+#    ifndef RPC_STREAM_FRAGMENT_SIZE
+#        define RPC_STREAM_FRAGMENT_SIZE 32
+#    endif // RPC_STREAM_FRAGMENT_SIZE
+
+#    ifndef RPC_STREAM_WINDOW
+#        define RPC_STREAM_WINDOW 4
+#    endif // RPC_STREAM_WINDOW
+
+#    ifndef RPC_STREAM_BUFFER_SIZE
+#        define RPC_STREAM_BUFFER_SIZE 256
+#    endif // RPC_STREAM_BUFFER_SIZE
+
+// Consecutive windows without progress before a stream is abandoned
+#    ifndef RPC_STREAM_MAX_STALLS
+#        define RPC_STREAM_MAX_STALLS 5
+#    endif // RPC_STREAM_MAX_STALLS
+#endif // SPLIT_RPC_STREAM_ENABLE
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -40,6 +59,30 @@ void transport_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
 
 bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length);
 
+#ifdef SPLIT_TRANSPORT_BATCH
+// Executes the transactions in the supplied bitmask, using the data already in split_shmem, in a single exchange where the transport supports it
+bool transport_execute_batch(uint32_t transaction_ids);
+#endif // SPLIT_TRANSPORT_BATCH
+
+#ifdef SPLIT_TRANSPORT_DELTA
+// Makes the next exchange of a delta-encoded transaction carry the whole buffer, rather than the changes since the last one
+void transport_resync_transaction(int8_t id);
+#endif // SPLIT_TRANSPORT_DELTA
+
+#ifdef SPLIT_TRANSPORT_ASYNC
+typedef enum {
+    TRANSPORT_ASYNC_IDLE,    // nothing has been started since the last result was collected
+    TRANSPORT_ASYNC_BUSY,    // still in progress
+    TRANSPORT_ASYNC_SUCCESS, // completed, with the result in split_shmem
+    TRANSPORT_ASYNC_FAILED,
+} transport_async_status_t;
+
+// Starts the transaction in the background, using the data already in split_shmem. Returns false if one is already in progress
+bool transport_start_transaction(int8_t id);
+// Returns the state of the background transaction without waiting, collecting its result once it has completed
+transport_async_status_t transport_poll_transaction(void);
+#endif // SPLIT_TRANSPORT_ASYNC
+
 #ifdef ENCODER_ENABLE
 #    include "encoder.h"
 #endif // ENCODER_ENABLE
@@ -123,6 +166,24 @@ typedef struct _rpc_sync_info_t {
         uint8_t s2m_length;
     } payload;
 } rpc_sync_info_t;
+
+#    ifdef SPLIT_RPC_STREAM_ENABLE
+typedef struct _rpc_stream_fragment_t {
+    uint8_t checksum;
+    struct {
+        uint16_t length; // of the whole stream
+        int8_t   transaction_id;
+        uint8_t  stream_id;
+        uint8_t  seq;
+        uint8_t  data[RPC_STREAM_FRAGMENT_SIZE];
+    } payload;
+} rpc_stream_fragment_t;
+
+typedef struct _rpc_stream_ack_t {
+    uint8_t stream_id;
+    uint8_t next_seq; // all fragments before this one have been received
+} rpc_stream_ack_t;
+#    endif // SPLIT_RPC_STREAM_ENABLE
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
 typedef struct _split_shared_memory_t {
@@ -192,6 +253,10 @@ typedef struct _split_shared_memory_t {
     rpc_sync_info_t rpc_info;
     uint8_t         rpc_m2s_buffer[RPC_M2S_BUFFER_SIZE];
     uint8_t         rpc_s2m_buffer[RPC_S2M_BUFFER_SIZE];
+#    ifdef SPLIT_RPC_STREAM_ENABLE
+    rpc_stream_fragment_t rpc_stream_fragment;
+    rpc_stream_ack_t      rpc_stream_ack;
+#    endif // SPLIT_RPC_STREAM_ENABLE
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 } split_shared_memory_t;
 
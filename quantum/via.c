@@ -374,6 +374,11 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         case id_dynamic_keymap_macro_set_buffer: {
             uint16_t offset = (command_data[0] << 8) | command_data[1];
             uint16_t size   = command_data[2]; // size <= 28
+#ifdef DYNAMIC_KEYMAP_BULK_TRANSFER
+            if (dynamic_keymap_bulk_write(DYNAMIC_KEYMAP_BULK_MACROS, offset, size, &command_data[3])) {
+                break;
+            }
+#endif
             dynamic_keymap_macro_set_buffer(offset, size, &command_data[3]);
             break;
         }
@@ -394,9 +399,28 @@ void raw_hid_receive(uint8_t *data, uint8_t length) {
         case id_dynamic_keymap_set_buffer: {
             uint16_t offset = (command_data[0] << 8) | command_data[1];
             uint16_t size   = command_data[2]; // size <= 28
+#ifdef DYNAMIC_KEYMAP_BULK_TRANSFER
+            if (dynamic_keymap_bulk_write(DYNAMIC_KEYMAP_BULK_KEYMAP, offset, size, &command_data[3])) {
+                break;
+            }
+#endif
             dynamic_keymap_set_buffer(offset, size, &command_data[3]);
             break;
         }
+#ifdef DYNAMIC_KEYMAP_BULK_TRANSFER
+        case id_dynamic_keymap_bulk_begin: {
+            // command_data[0] is the target, DYNAMIC_KEYMAP_BULK_NONE aborts the session
+            command_data[1] = dynamic_keymap_bulk_begin(command_data[0]);
+            break;
+        }
+        case id_dynamic_keymap_bulk_commit: {
+            uint16_t checksum = 0;
+            command_data[0]   = dynamic_keymap_bulk_commit(&checksum);
+            command_data[1]   = checksum >> 8;
+            command_data[2]   = checksum & 0xFF;
+            break;
+        }
+#endif
 #ifdef ENCODER_MAP_ENABLE
         case id_dynamic_keymap_get_encoder: {
             uint16_t keycode = dynamic_keymap_get_encoder(command_data[0], command_data[1], command_data[2] != 0);
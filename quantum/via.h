@@ -82,6 +82,8 @@ enum via_command_id {
     id_dynamic_keymap_set_buffer            = 0x13,
     id_dynamic_keymap_get_encoder           = 0x14,
     id_dynamic_keymap_set_encoder           = 0x15,
+    id_dynamic_keymap_bulk_begin            = 0x16,
+    id_dynamic_keymap_bulk_commit           = 0x17,
     id_unhandled                            = 0xFF,
 };
 
@@ -0,0 +1,242 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <array>
+#include <limits>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+/* Configuration (see rules.mk):
+ *   two 64-byte banks, each with 16 bytes of logical data, a 16-byte header and 16 log slots
+ *   16-byte erase units, 4-byte copy chunks
+ */
+
+using BANK_SIZE = std::integral_constant<std::size_t, (WEAR_LEVELING_BACKING_SIZE / 2)>;
+
+class WearLevelingIncremental : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    // Fills the first half of the write log, which kicks off consolidation
+    void start_consolidation() {
+        for (std::uint8_t i = 0; i < 8; ++i) {
+            std::uint8_t value = 0x10 + i;
+            EXPECT_EQ(wear_leveling_write(i, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        }
+    }
+
+    void expect_contents(const std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>& expected) {
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        for (std::size_t i = 0; i < actual.size(); ++i) {
+            EXPECT_EQ(actual[i], expected[i]) << "Invalid readback at " << i;
+        }
+    }
+};
+
+/**
+ * This test verifies that consolidation is split into bounded slices, none of which erases the live bank.
+ */
+TEST_F(WearLevelingIncremental, ConsolidationIsSpreadAcrossTasks) {
+    auto& inst = MockBackingStore::Instance();
+
+    start_consolidation();
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Writes should not have erased anything";
+
+    int tasks = 0;
+    while (true) {
+        std::uint64_t writes = inst.write_invoke_count();
+        std::uint64_t erases = inst.erase_invoke_count();
+
+        wear_leveling_status_t status = wear_leveling_task();
+        ++tasks;
+        ASSERT_NE(status, WEAR_LEVELING_FAILED) << "Task returned incorrect status";
+        ASSERT_LE(tasks, 100) << "Consolidation never completed";
+
+        // One chunk of data, plus the header on the final copy
+        EXPECT_LE(inst.write_invoke_count() - writes, (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE + 16) / BACKING_STORE_WRITE_SIZE) << "Too many writes in a single task";
+        EXPECT_LE(inst.erase_invoke_count() - erases, 1) << "Too many erases in a single task";
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            break;
+        }
+    }
+    EXPECT_GE(tasks, WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE) << "Copy should have been split into chunks";
+
+    // Retire the previous bank
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    }
+    for (auto it = inst.storage_begin(); it != inst.storage_begin() + (BANK_SIZE::value / BACKING_STORE_WRITE_SIZE); ++it) {
+        EXPECT_TRUE(it->is_erased()) << "Previous bank should have been erased";
+    }
+
+    // Re-init and make sure the consolidated data is picked up from the second bank
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17};
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    expect_contents(expected);
+}
+
+/**
+ * This test verifies that writes made while the spare bank is being populated are carried over, whether they land
+ * on data that has already been copied or not.
+ */
+TEST_F(WearLevelingIncremental, WritesDuringConsolidationAreKept) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17};
+
+    start_consolidation();
+
+    // Erase the four units of the spare bank, then copy the first chunk
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    }
+
+    for (std::uint8_t i = 0; i < 6; ++i) {
+        std::uint8_t address = (i * 3) % WEAR_LEVELING_LOGICAL_SIZE;
+        std::uint8_t value   = 0x80 + i;
+        expected[address]    = value;
+        EXPECT_NE(wear_leveling_write(address, &value, sizeof(value)), WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+        EXPECT_NE(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Task returned incorrect status";
+    }
+    expect_contents(expected);
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    expect_contents(expected);
+}
+
+/**
+ * This test verifies that if the task is never invoked, a full write log still forces consolidation in-line.
+ */
+TEST_F(WearLevelingIncremental, FullLogConsolidatesInline) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{};
+
+    int consolidations = 0;
+    for (int i = 0; i < 64; ++i) {
+        std::uint8_t address = (i * 7) % WEAR_LEVELING_LOGICAL_SIZE;
+        std::uint8_t value   = i + 1;
+        expected[address]    = value;
+
+        wear_leveling_status_t status = wear_leveling_write(address, &value, sizeof(value));
+        EXPECT_NE(status, WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            ++consolidations;
+        }
+    }
+    EXPECT_GE(consolidations, 3) << "Full write log should have been consolidated";
+    expect_contents(expected);
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    expect_contents(expected);
+}
+
+/**
+ * This test verifies that losing power before any backing store write or erase -- including part-way through an
+ * erase -- never loses acknowledged data.
+ */
+TEST_F(WearLevelingIncremental, PowerLossIsRecoverable) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::uint64_t total = std::numeric_limits<std::uint64_t>::max();
+    for (std::uint64_t cut = 0; cut <= total; ++cut) {
+        inst.reset_instance();
+        wear_leveling_init();
+
+        // Count each backing store write, and each element erased, failing everything past the cut
+        std::uint64_t ops   = 0;
+        std::uint64_t limit = (cut == 0) ? std::numeric_limits<std::uint64_t>::max() : cut;
+        inst.set_write_callback([&](std::uint64_t, std::uint32_t) { return ++ops <= limit; });
+        inst.set_erase_callback([&](std::uint64_t) { return ++ops <= limit; });
+
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{};
+        int                                                  pending_address = -1;
+        std::uint8_t                                         pending_value   = 0;
+        int                                                  consolidations  = 0;
+        for (int i = 0; i < 48; ++i) {
+            std::uint8_t           address = (i * 5) % WEAR_LEVELING_LOGICAL_SIZE;
+            std::uint8_t           value   = i + 1;
+            wear_leveling_status_t status  = wear_leveling_write(address, &value, sizeof(value));
+            if (status == WEAR_LEVELING_FAILED) {
+                pending_address = address;
+                pending_value   = value;
+                break;
+            }
+            expected[address] = value;
+
+            status = wear_leveling_task();
+            if (status == WEAR_LEVELING_FAILED) {
+                break;
+            }
+            if (status == WEAR_LEVELING_CONSOLIDATED) {
+                ++consolidations;
+            }
+        }
+
+        // The first pass runs without a cut, to work out how many operations the workload needs
+        if (cut == 0) {
+            total = ops;
+            EXPECT_GE(consolidations, 2) << "Workload should consolidate more than once";
+        }
+
+        // Power comes back
+        inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+        inst.set_erase_callback([](std::uint64_t) { return true; });
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status after cut " << cut;
+
+        std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        for (int i = 0; i < WEAR_LEVELING_LOGICAL_SIZE; ++i) {
+            if (i == pending_address) {
+                // The interrupted write may or may not have made it
+                EXPECT_THAT(actual[i], ::testing::AnyOf(expected[i], pending_value)) << "Invalid readback at " << i << " after cut " << cut;
+            } else {
+                EXPECT_EQ(actual[i], expected[i]) << "Invalid readback at " << i << " after cut " << cut;
+            }
+        }
+    }
+}
+
+/**
+ * This test verifies that a store written without incremental consolidation is picked up, including its write log,
+ * and rewritten in the two-bank layout.
+ */
+TEST_F(WearLevelingIncremental, SingleBankLayoutIsMigrated) {
+    auto& inst = MockBackingStore::Instance();
+    auto  data = inst.storage_begin();
+
+    // Consolidated data, followed by its FNV1a_64 hash
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10};
+    write_log_entry_t                                    hash = {.raw64 = fnv_64a_buf(expected.data(), expected.size(), FNV1A_64_INIT)};
+    for (std::size_t i = 0; i < WEAR_LEVELING_LOGICAL_SIZE / sizeof(backing_store_int_t); ++i) {
+        (data + i)->set(~(backing_store_int_t)(expected[2 * i] | (expected[2 * i + 1] << 8)));
+    }
+    auto logstart = data + (WEAR_LEVELING_LOGICAL_SIZE / sizeof(backing_store_int_t));
+    for (std::size_t i = 0; i < 4; ++i) {
+        (logstart + i)->set(~hash.raw16[i]);
+    }
+
+    // Write log straight after the hash, setting [0x11,0x12] at logical offset 0x0A
+    auto entry    = LOG_ENTRY_MAKE_MULTIBYTE(0x0A, 2);
+    entry.raw8[3] = 0x11;
+    entry.raw8[4] = 0x12;
+    (logstart + 4)->set(~entry.raw16[0]);
+    (logstart + 5)->set(~entry.raw16[1]);
+    (logstart + 6)->set(~entry.raw16[2]);
+    expected[0x0A] = 0x11;
+    expected[0x0B] = 0x12;
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Init should have consolidated into the two-bank layout";
+    expect_contents(expected);
+
+    // Retire the single-bank data
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Task returned incorrect status";
+    }
+    for (auto it = inst.storage_begin(); it != inst.storage_begin() + (BANK_SIZE::value / BACKING_STORE_WRITE_SIZE); ++it) {
+        EXPECT_TRUE(it->is_erased()) << "Single-bank data should have been erased";
+    }
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    expect_contents(expected);
+}
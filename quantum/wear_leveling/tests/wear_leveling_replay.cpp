@@ -0,0 +1,99 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+/* Configuration (see rules.mk):
+ *   2-byte writes, 8kB backing store, 1kB logical size -- the embedded flash defaults
+ */
+
+// Number of write log slots available before consolidation occurs
+using LOG_SLOT_COUNT = std::integral_constant<std::size_t, ((WEAR_LEVELING_BACKING_SIZE - WEAR_LEVELING_LOGICAL_SIZE - 8) / BACKING_STORE_WRITE_SIZE)>;
+// Number of write log slots fetched by each bulk read during playback
+using PLAYBACK_BLOCK_SLOTS = std::integral_constant<std::size_t, (WEAR_LEVELING_PLAYBACK_BLOCK_SIZE / BACKING_STORE_WRITE_SIZE)>;
+
+class WearLevelingReplay : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+/**
+ * This test verifies that entries spanning playback blocks are replayed intact.
+ */
+TEST_F(WearLevelingReplay, EntriesAcrossBlockBoundaries) {
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> expected{};
+    std::uint32_t                                        seed = 0x1234;
+
+    for (int i = 0; i < 600; ++i) {
+        seed                 = seed * 1103515245 + 12345;
+        std::uint32_t length = 1 + (seed >> 8) % 5;
+        std::uint32_t offset = (seed >> 16) % (WEAR_LEVELING_LOGICAL_SIZE - length);
+
+        std::uint8_t data[5];
+        for (std::uint32_t j = 0; j < length; ++j) {
+            // Mix in plenty of zeros to exercise the word-encoded 0/1 entries
+            data[j] = ((seed >> (j * 3)) & 3) == 0 ? (std::uint8_t)(i + j) : 0;
+        }
+        std::copy(data, data + length, expected.begin() + offset);
+        EXPECT_NE(wear_leveling_write(offset, data, length), WEAR_LEVELING_FAILED) << "Write returned incorrect status";
+    }
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> actual;
+    EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i], expected[i]) << "Invalid readback at " << i;
+    }
+}
+
+/**
+ * Host benchmark of boot replay against the fill level of the write log.
+ *
+ * Reports backing store read transactions and wall-clock time per init. The transaction count is what dominates on
+ * external flash, where each read is a separate bus transfer.
+ */
+TEST_F(WearLevelingReplay, BootReplayBenchmark) {
+    constexpr int ITERATIONS = 200;
+    auto&         inst       = MockBackingStore::Instance();
+
+    std::cout << "  fill | entries | reads/boot | us/boot" << std::endl;
+    for (int percent : {0, 25, 50, 75, 99}) {
+        inst.reset_instance();
+        wear_leveling_init();
+
+        // Single-byte writes to the first 64 bytes each take exactly one log slot
+        std::array<std::uint8_t, 64> expected{};
+        std::size_t                  entries = LOG_SLOT_COUNT::value * percent / 100;
+        for (std::size_t i = 0; i < entries; ++i) {
+            std::uint8_t address = i % expected.size();
+            std::uint8_t value   = 1 + (i / expected.size()) % 255;
+            expected[address]    = value;
+            ASSERT_EQ(wear_leveling_write(address, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+        }
+
+        std::uint64_t reads = inst.read_invoke_count();
+        auto          start = std::chrono::steady_clock::now();
+        for (int i = 0; i < ITERATIONS; ++i) {
+            ASSERT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Init returned incorrect status";
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+        // Consolidated data and checksum, then one bulk read per playback block up to and including the empty slot
+        std::uint64_t reads_per_boot = (inst.read_invoke_count() - reads) / ITERATIONS;
+        EXPECT_EQ(reads_per_boot, 2 + (entries / PLAYBACK_BLOCK_SLOTS::value) + 1) << "Unexpected number of reads at " << percent << "% fill";
+
+        std::array<std::uint8_t, 64> actual;
+        EXPECT_EQ(wear_leveling_read(0, actual.data(), actual.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        EXPECT_EQ(actual, expected) << "Invalid readback at " << percent << "% fill";
+
+        std::cout << std::setw(5) << percent << "% | " << std::setw(7) << entries << " | " << std::setw(10) << reads_per_boot << " | " << std::fixed << std::setprecision(2) << std::setw(7) << (elapsed / ITERATIONS) / 1000.0 << std::endl;
+    }
+}
@@ -61,12 +61,29 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_INCREMENTAL_CONSOLIDATION: Spreads consolidation across
+            multiple invocations of wear_leveling_task(), using two banks. The
+            backing size must then be at least four times the logical size.
+
+        - BACKING_STORE_ERASE_SIZE: The smallest number of bytes that
+            backing_store_erase_range() can erase. Defined by backing stores
+            that implement it; incremental consolidation requires it.
+
+        - WEAR_LEVELING_ERASE_SIZE: The number of bytes erased per task
+            invocation during incremental consolidation. Defaults to the
+            backing store's erase size.
+
+        - WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE: The number of logical bytes
+            copied per task invocation during incremental consolidation.
+
     General algorithm:
 
         During initialization:
             * The contents of the consolidated data section are read into cache.
             * The contents of the write log are "played back" and update the
-                cache accordingly.
+                cache accordingly. The log is fetched in blocks of
+                WEAR_LEVELING_PLAYBACK_BLOCK_SIZE bytes, rather than an entry
+                at a time, as each read is a bus transfer on external flash.
 
         During reads:
             * Logical data is served from the cache.
@@ -153,7 +170,45 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Incremental consolidation:
+
+        With WEAR_LEVELING_INCREMENTAL_CONSOLIDATION defined, the backing store
+        is split into two equally-sized banks, each with its own consolidated
+        data, header, and write log. The header holds the FNV1a_64 hash
+        followed by an 8-byte generation counter, which is included in the
+        hash. The backing store must implement backing_store_erase_range().
+
+        ╔ Bank ═════════════════════════════════════════════╗
+        ║ Consolidated data ║ FNV1a_64 ║ Generation ║ Log … ║
+        ╚═══════════════════╩══════════╩════════════╩═══════╝
+
+        Once the write log of the live bank is half full, consolidation is
+        started and then advanced by wear_leveling_task():
+            * The spare bank is erased, one erase unit at a time. The unit
+                holding the header goes first, so that a partially-erased bank
+                never passes its checksum.
+            * The cache is copied into the spare bank, one chunk at a time.
+                Any log entries appended in the meantime are mirrored into the
+                spare bank's write log.
+            * The generation, then the hash, are written to the spare bank.
+                Writing the hash commits the spare bank as the live bank.
+            * The previous bank is erased, one erase unit at a time.
+
+        If the live write log fills up before the copy completes, the remaining
+        steps are performed inline. The previous bank stays intact until the
+        spare bank has been committed, so power loss at any point leaves at
+        least one valid bank; if both are valid, the newer generation wins.
+
+        A store written before incremental consolidation was enabled has a
+        data-only hash, and its write log spans the rest of the backing store.
+        If neither bank is valid during initialization, the consolidated data
+        is checked against that layout instead. If it's valid, the write log is
+        replayed from there, and the cache is consolidated into the spare bank
+        straight away, as generation 1. Until that commit the old consolidated
+        data is left intact, though log entries held in the spare bank are lost
+        if power is removed part-way through. */
 
 /**
  * Storage area for the wear-leveling cache.
@@ -162,8 +217,51 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    uint32_t bank_base;     // Start of the live bank
+    uint32_t generation;    // Generation of the live bank
+    uint32_t progress;      // Erase units or logical bytes completed by the current phase
+    uint32_t spare_address; // Next write log location within the spare bank, while copying
+    uint64_t spare_hash;    // Running FNV1a_64 of the data copied into the spare bank
+    uint8_t  phase;         // Current consolidation phase
+    bool     spare_erased;  // Whether the spare bank is known to be erased
+    bool     migrating;     // Whether the data was loaded from the single-bank layout, and is yet to be consolidated
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 } wear_leveling;
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    define WEAR_LEVELING_HEADER_SIZE 16 // FNV1a_64 + generation
+#    define WEAR_LEVELING_LIVE_BANK (wear_leveling.bank_base)
+#    define WEAR_LEVELING_SPARE_BANK ((WEAR_LEVELING_BANK_SIZE) - wear_leveling.bank_base)
+
+/**
+ * Incremental consolidation phases.
+ */
+typedef enum wear_leveling_phase_t {
+    PHASE_IDLE,        //< Nothing pending
+    PHASE_ERASE_SPARE, //< Erasing the spare bank, ready for copying
+    PHASE_COPY,        //< Copying the cache into the spare bank
+    PHASE_RETIRE,      //< Erasing the previous bank after the spare bank was committed
+} wear_leveling_phase_t;
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+#    define WEAR_LEVELING_HEADER_SIZE 8 // FNV1a_64
+#    define WEAR_LEVELING_LIVE_BANK 0
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+#define WEAR_LEVELING_LOG_START(bank) ((bank) + (WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_HEADER_SIZE))
+#define WEAR_LEVELING_LOG_END(bank) ((bank) + (WEAR_LEVELING_BANK_SIZE))
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+// A store written without incremental consolidation has an 8-byte header, and a write log spanning the rest of the backing store
+#    define WEAR_LEVELING_PLAYBACK_START (wear_leveling.migrating ? (WEAR_LEVELING_LOGICAL_SIZE) + 8 : WEAR_LEVELING_LOG_START(WEAR_LEVELING_LIVE_BANK))
+#    define WEAR_LEVELING_PLAYBACK_END (wear_leveling.migrating ? (WEAR_LEVELING_BACKING_SIZE) : WEAR_LEVELING_LOG_END(WEAR_LEVELING_LIVE_BANK))
+#else
+#    define WEAR_LEVELING_PLAYBACK_START WEAR_LEVELING_LOG_START(WEAR_LEVELING_LIVE_BANK)
+#    define WEAR_LEVELING_PLAYBACK_END WEAR_LEVELING_LOG_END(WEAR_LEVELING_LIVE_BANK)
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 /**
  * Locking helper: status
  */
@@ -202,9 +300,11 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START(WEAR_LEVELING_LIVE_BANK);
 }
 
+#ifndef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 /**
  * Reads the consolidated data from the backing store into the cache.
  * Does not consider the write log.
@@ -316,11 +416,276 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START(0);
+
+    return status;
+}
+
+#else // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+#    define WEAR_LEVELING_ERASE_UNITS ((WEAR_LEVELING_BANK_SIZE) / (WEAR_LEVELING_ERASE_SIZE))
+#    define WEAR_LEVELING_HEADER_UNIT ((WEAR_LEVELING_LOGICAL_SIZE) / (WEAR_LEVELING_ERASE_SIZE))
+
+/**
+ * Reads a full 8-byte entry from the backing store, irrespective of the write size.
+ */
+static bool wear_leveling_read_entry(uint32_t address, write_log_entry_t *entry) {
+    return backing_store_read_bulk(address, (backing_store_int_t *)entry->raw8, sizeof(write_log_entry_t) / (BACKING_STORE_WRITE_SIZE));
+}
+
+/**
+ * Writes a full 8-byte entry to the backing store, irrespective of the write size.
+ */
+static bool wear_leveling_write_entry(uint32_t address, write_log_entry_t *entry) {
+    return backing_store_write_bulk(address, (backing_store_int_t *)entry->raw8, sizeof(write_log_entry_t) / (BACKING_STORE_WRITE_SIZE));
+}
+
+/**
+ * Reads the consolidated data of the supplied bank into the cache, and checks it against the bank's header.
+ */
+static wear_leveling_status_t wear_leveling_load_bank(uint32_t bank, bool *valid, uint32_t *generation) {
+    write_log_entry_t hash;
+    write_log_entry_t gen;
+
+    *valid      = false;
+    *generation = 0;
+    if (!backing_store_read_bulk(bank, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+        return WEAR_LEVELING_FAILED;
+    }
+    if (!wear_leveling_read_entry(bank + (WEAR_LEVELING_LOGICAL_SIZE), &hash) || !wear_leveling_read_entry(bank + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &gen)) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    uint64_t expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+    expected          = fnv_64a_buf(gen.raw8, sizeof(gen), expected);
+    *valid            = (hash.raw64 == expected);
+    *generation       = gen.raw32[0];
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Reads the consolidated data of a store written without incremental consolidation into the cache, and checks it against its header.
+ */
+static wear_leveling_status_t wear_leveling_load_single_bank(bool *valid) {
+    write_log_entry_t hash;
+
+    *valid = false;
+    if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t)) || !wear_leveling_read_entry((WEAR_LEVELING_LOGICAL_SIZE), &hash)) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    *valid = (hash.raw64 == fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT));
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Works out which bank is live, and reads its consolidated data into the cache.
+ * Does not consider the write log.
+ */
+static wear_leveling_status_t wear_leveling_read_consolidated(void) {
+    wl_dprintf("Reading consolidated data\n");
+
+    bool     valid[2];
+    uint32_t generation[2];
+    for (uint8_t i = 0; i < 2; ++i) {
+        if (wear_leveling_load_bank(i * (WEAR_LEVELING_BANK_SIZE), &valid[i], &generation[i]) != WEAR_LEVELING_SUCCESS) {
+            wl_dprintf("Failed to read from backing store\n");
+            wear_leveling_clear_cache();
+            return WEAR_LEVELING_FAILED;
+        }
+    }
+
+    // Both banks are valid if power was lost between committing the spare bank and retiring the previous one -- newest wins
+    uint8_t live = (valid[1] && (!valid[0] || (int32_t)(generation[1] - generation[0]) > 0)) ? 1 : 0;
+
+    wear_leveling.bank_base    = live * (WEAR_LEVELING_BANK_SIZE);
+    wear_leveling.generation   = valid[live] ? generation[live] : 0;
+    wear_leveling.phase        = PHASE_IDLE;
+    wear_leveling.spare_erased = false;
+    wear_leveling.migrating    = false;
+
+    if (!valid[live]) {
+        // A store written before incremental consolidation was enabled is picked up, and consolidated into the two-bank layout once its log is replayed
+        if (wear_leveling_load_single_bank(&wear_leveling.migrating) != WEAR_LEVELING_SUCCESS || !wear_leveling.migrating) {
+            // Cater for the completely clean MCU case, without flagging a failure
+            wl_dprintf("No valid bank, clearing cache\n");
+            wear_leveling_clear_cache();
+        } else {
+            wl_dprintf("Found single-bank layout, migrating\n");
+        }
+    } else if (live == 0) {
+        // The cache holds the contents of the last bank checked, reload the live one
+        wear_leveling_load_bank(0, &valid[0], &generation[0]);
+    }
+
+    wl_dprintf("Bank %d is live, generation %lu\n", (int)live, (unsigned long)wear_leveling.generation);
+    wear_leveling.write_address = WEAR_LEVELING_LOG_START(WEAR_LEVELING_LIVE_BANK);
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Prepares the next phase of consolidation, copying into the spare bank if it's already erased.
+ */
+static void wear_leveling_begin_copy(void) {
+    wear_leveling.phase         = PHASE_COPY;
+    wear_leveling.progress      = 0;
+    wear_leveling.spare_hash    = FNV1A_64_INIT;
+    wear_leveling.spare_address = WEAR_LEVELING_LOG_START(WEAR_LEVELING_SPARE_BANK);
+}
+
+/**
+ * Starts consolidation into the spare bank, unless it's already underway.
+ */
+static void wear_leveling_begin_consolidation(void) {
+    switch (wear_leveling.phase) {
+        case PHASE_IDLE:
+            wl_dprintf("Starting consolidation\n");
+            if (wear_leveling.spare_erased) {
+                wear_leveling_begin_copy();
+            } else {
+                wear_leveling.phase    = PHASE_ERASE_SPARE;
+                wear_leveling.progress = 0;
+            }
+            break;
+        case PHASE_RETIRE:
+            // Still erasing the previous bank, which is now the spare -- carry on from there
+            wear_leveling.phase = PHASE_ERASE_SPARE;
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Discards anything written to the spare bank, and starts consolidation again from the erase.
+ */
+static void wear_leveling_restart_consolidation(void) {
+    wear_leveling.phase        = PHASE_ERASE_SPARE;
+    wear_leveling.progress     = 0;
+    wear_leveling.spare_erased = false;
+}
+
+/**
+ * Erases the supplied unit of the spare bank, skipping it if it's already blank.
+ * The unit holding the header is always erased first, so that a partially-erased bank is never seen as valid.
+ */
+static bool wear_leveling_erase_spare_unit(uint32_t index) {
+    uint32_t unit    = (index == 0) ? (WEAR_LEVELING_HEADER_UNIT) : (index <= (WEAR_LEVELING_HEADER_UNIT) ? index - 1 : index);
+    uint32_t address = WEAR_LEVELING_SPARE_BANK + unit * (WEAR_LEVELING_ERASE_SIZE);
+
+    for (uint32_t offset = 0; offset < (WEAR_LEVELING_ERASE_SIZE); offset += (BACKING_STORE_WRITE_SIZE)) {
+        backing_store_int_t value;
+        if (!backing_store_read(address + offset, &value) || value != 0) {
+            wl_dprintf("Erasing spare bank unit %d\n", (int)unit);
+            return backing_store_erase_range(address, (WEAR_LEVELING_ERASE_SIZE));
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Writes the header of the spare bank, making it the live bank.
+ * The generation is written before the checksum, as the checksum is what marks the bank as valid.
+ */
+static wear_leveling_status_t wear_leveling_commit_spare(void) {
+    uint32_t          spare = WEAR_LEVELING_SPARE_BANK;
+    write_log_entry_t gen   = {.raw64 = 0};
+    write_log_entry_t hash;
+    gen.raw32[0] = wear_leveling.generation + 1;
+    hash.raw64   = fnv_64a_buf(gen.raw8, sizeof(gen), wear_leveling.spare_hash);
+
+    wl_dprintf("Committing spare bank\n");
+    if (!wear_leveling_write_entry(spare + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &gen) || !wear_leveling_write_entry(spare + (WEAR_LEVELING_LOGICAL_SIZE), &hash)) {
+        wl_dprintf("Failed to write spare bank header\n");
+        wear_leveling_restart_consolidation();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // The previous bank is now the spare, and needs to be erased before it can be used again
+    wear_leveling.bank_base     = spare;
+    wear_leveling.generation    = gen.raw32[0];
+    wear_leveling.write_address = wear_leveling.spare_address;
+    wear_leveling.phase         = PHASE_RETIRE;
+    wear_leveling.progress      = 0;
+    wear_leveling.spare_erased  = false;
+    return WEAR_LEVELING_CONSOLIDATED;
+}
+
+/**
+ * Performs a bounded slice of the current consolidation phase.
+ * Pre-condition: the backing store is unlocked.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED once the spare bank has been committed
+ */
+static wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    switch (wear_leveling.phase) {
+        case PHASE_ERASE_SPARE:
+        case PHASE_RETIRE: {
+            if (!wear_leveling_erase_spare_unit(wear_leveling.progress)) {
+                wl_dprintf("Failed to erase spare bank\n");
+                return WEAR_LEVELING_FAILED;
+            }
+            if (++wear_leveling.progress < (WEAR_LEVELING_ERASE_UNITS)) {
+                return WEAR_LEVELING_SUCCESS;
+            }
+
+            wear_leveling.spare_erased = true;
+            if (wear_leveling.phase == PHASE_RETIRE) {
+                wear_leveling.phase = PHASE_IDLE;
+            } else {
+                wear_leveling_begin_copy();
+            }
+        } break;
+
+        case PHASE_COPY: {
+            uint32_t offset = wear_leveling.progress;
+            uint32_t length = (WEAR_LEVELING_LOGICAL_SIZE) - offset;
+            if (length > (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE)) {
+                length = (WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE);
+            }
 
+            if (!backing_store_write_bulk(WEAR_LEVELING_SPARE_BANK + offset, (backing_store_int_t *)&wear_leveling.cache[offset], length / (BACKING_STORE_WRITE_SIZE))) {
+                wl_dprintf("Failed to write to spare bank\n");
+                wear_leveling_restart_consolidation();
+                return WEAR_LEVELING_FAILED;
+            }
+
+            wear_leveling.spare_hash = fnv_64a_buf(&wear_leveling.cache[offset], length, wear_leveling.spare_hash);
+            wear_leveling.progress += length;
+            if (wear_leveling.progress == (WEAR_LEVELING_LOGICAL_SIZE)) {
+                return wear_leveling_commit_spare();
+            }
+        } break;
+
+        default:
+            break;
+    }
+
+    return WEAR_LEVELING_SUCCESS;
+}
+
+/**
+ * Runs consolidation through to the commit of the spare bank, starting it if needed.
+ * The previous bank remains intact throughout, so a power loss does not lose data.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    wear_leveling_status_t      status;
+
+    wear_leveling_begin_consolidation();
+    do {
+        status = wear_leveling_consolidate_step();
+    } while (status == WEAR_LEVELING_SUCCESS);
+
+    if (lock_status == STATUS_SUCCESS) {
+        wear_leveling_lock();
+    }
     return status;
 }
 
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 /**
  * Potential write of the current cache to the backing store.
  * Skipped if the current write log position is not at the end of the backing store.
@@ -329,10 +694,17 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    if (wear_leveling.write_address >= WEAR_LEVELING_LOG_END(WEAR_LEVELING_LIVE_BANK)) {
         return wear_leveling_consolidate_force();
     }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Start once the write log is half full, leaving the rest as headroom while the spare bank is populated
+    if (wear_leveling.phase == PHASE_IDLE && wear_leveling.write_address >= WEAR_LEVELING_LOG_START(WEAR_LEVELING_LIVE_BANK) + ((WEAR_LEVELING_BANK_SIZE) - (WEAR_LEVELING_LOGICAL_SIZE) - (WEAR_LEVELING_HEADER_SIZE)) / 2) {
+        wear_leveling_begin_consolidation();
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     return WEAR_LEVELING_SUCCESS;
 }
 
@@ -348,6 +720,19 @@ static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value
         return WEAR_LEVELING_FAILED;
     }
     wear_leveling.write_address += (BACKING_STORE_WRITE_SIZE);
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Mirror the entry into the spare bank's write log, so that it's complete once the spare bank is committed
+    if (wear_leveling.phase == PHASE_COPY) {
+        if (wear_leveling.spare_address >= WEAR_LEVELING_LOG_END(WEAR_LEVELING_SPARE_BANK) || !backing_store_write(wear_leveling.spare_address, value)) {
+            wl_dprintf("Failed to mirror write log entry, restarting consolidation\n");
+            wear_leveling_restart_consolidation();
+        } else {
+            wear_leveling.spare_address += (BACKING_STORE_WRITE_SIZE);
+        }
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     return wear_leveling_consolidate_if_needed();
 }
 
@@ -469,18 +854,49 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+/**
+ * Buffered view of the write log, so that playback issues one bulk read per block rather than one read per entry.
+ */
+typedef struct wear_leveling_log_reader_t {
+    backing_store_int_t buffer[(WEAR_LEVELING_PLAYBACK_BLOCK_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+    uint32_t            start; // Backing store address of buffer[0]
+    uint32_t            count; // Number of valid items in the buffer
+} wear_leveling_log_reader_t;
+
+/**
+ * Reads a write log item, refilling the buffer from the backing store if required.
+ */
+static bool wear_leveling_log_read(wear_leveling_log_reader_t *reader, uint32_t address, backing_store_int_t *value) {
+    if (reader->count == 0 || address < reader->start || address >= reader->start + reader->count * (BACKING_STORE_WRITE_SIZE)) {
+        uint32_t count = (WEAR_LEVELING_PLAYBACK_END - address) / (BACKING_STORE_WRITE_SIZE);
+        if (count > sizeof(reader->buffer) / sizeof(reader->buffer[0])) {
+            count = sizeof(reader->buffer) / sizeof(reader->buffer[0]);
+        }
+        if (!backing_store_read_bulk(address, reader->buffer, count)) {
+            reader->count = 0;
+            return false;
+        }
+        reader->start = address;
+        reader->count = count;
+    }
+
+    *value = reader->buffer[(address - reader->start) / (BACKING_STORE_WRITE_SIZE)];
+    return true;
+}
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
 static wear_leveling_status_t wear_leveling_playback_log(void) {
     wl_dprintf("Playback write log\n");
 
-    wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
-    bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
+    wear_leveling_log_reader_t reader          = {.count = 0};
+    wear_leveling_status_t     status          = WEAR_LEVELING_SUCCESS;
+    bool                       cancel_playback = false;
+    uint32_t                   address         = WEAR_LEVELING_PLAYBACK_START;
+    while (!cancel_playback && address < WEAR_LEVELING_PLAYBACK_END) {
         backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
+        bool                ok = wear_leveling_log_read(&reader, address, &value);
         if (!ok) {
             wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
             cancel_playback = true;
@@ -509,7 +925,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = wear_leveling_log_read(&reader, address, &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -529,7 +945,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = wear_leveling_log_read(&reader, address, &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -539,7 +955,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = wear_leveling_log_read(&reader, address, &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -550,7 +966,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = wear_leveling_log_read(&reader, address, &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -600,6 +1016,15 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
     // We've reached the end of the log, so we're at the new write location
     wear_leveling.write_address = address;
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    if (wear_leveling.migrating) {
+        // Rewrite the single-bank layout as the first generation of the two-bank layout, before anything is appended to it
+        wl_dprintf("Migrating to two-bank layout\n");
+        wear_leveling.migrating = false;
+        return wear_leveling_consolidate_force();
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     if (status == WEAR_LEVELING_FAILED) {
         // If we had a failure during readback, assume we're corrupted -- force a consolidation with the data we already have
         status = wear_leveling_consolidate_force();
@@ -661,6 +1086,13 @@ wear_leveling_status_t wear_leveling_erase(void) {
 
     // Perform the erase
     bool ret = backing_store_erase();
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    wear_leveling.bank_base    = 0;
+    wear_leveling.generation   = 0;
+    wear_leveling.phase        = PHASE_IDLE;
+    wear_leveling.spare_erased = ret;
+    wear_leveling.migrating    = false;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
     wear_leveling_clear_cache();
 
     // Lock the backing store if we acquired the lock successfully
@@ -726,6 +1158,34 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Performs a bounded slice of any pending incremental consolidation.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+    if (wear_leveling.phase == PHASE_IDLE) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    // Unlock the backing store
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = wear_leveling_consolidate_step();
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 /**
  * Reads logical data from the cache.
  */
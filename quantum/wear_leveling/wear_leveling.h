@@ -52,3 +52,14 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Performs a bounded slice of any pending incremental consolidation.
+ *
+ * Each invocation erases at most one erase unit, or copies at most one chunk of logical data into the spare bank.
+ *
+ * @return Status of the request -- WEAR_LEVELING_CONSOLIDATED once the spare bank has been committed
+ */
+wear_leveling_status_t wear_leveling_task(void);
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
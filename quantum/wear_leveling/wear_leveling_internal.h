@@ -66,10 +66,41 @@ _Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "
 _Static_assert(WEAR_LEVELING_LOGICAL_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Logical size must be a multiple of write size");
 _Static_assert(WEAR_LEVELING_BACKING_SIZE % WEAR_LEVELING_LOGICAL_SIZE == 0, "Backing size must be a multiple of logical size");
 
+// Number of bytes of write log fetched per bulk read during playback
+#ifndef WEAR_LEVELING_PLAYBACK_BLOCK_SIZE
+#    define WEAR_LEVELING_PLAYBACK_BLOCK_SIZE 64
+#endif // WEAR_LEVELING_PLAYBACK_BLOCK_SIZE
+
+_Static_assert(WEAR_LEVELING_PLAYBACK_BLOCK_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Playback block size must be a multiple of write size");
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+// Number of logical bytes copied into the spare bank by each wear_leveling_task() invocation
+#    ifndef WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE
+#        define WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE 64
+#    endif // WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE
+
+// Set by backing stores implementing backing_store_erase_range(), to the smallest unit it can erase
+#    ifndef BACKING_STORE_ERASE_SIZE
+#        error "Incremental consolidation requires a backing store implementing backing_store_erase_range(), such as embedded_flash or spi_flash"
+#    endif // BACKING_STORE_ERASE_SIZE
+
+// Number of bytes erased by each wear_leveling_task() invocation -- one sector of the backing store
+#    ifndef WEAR_LEVELING_ERASE_SIZE
+#        define WEAR_LEVELING_ERASE_SIZE (BACKING_STORE_ERASE_SIZE)
+#    endif // WEAR_LEVELING_ERASE_SIZE
+
+_Static_assert(WEAR_LEVELING_BACKING_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 4), "Incremental consolidation requires two banks, each at least twice the size of the logical size");
+_Static_assert((WEAR_LEVELING_BACKING_SIZE / 2) % BACKING_STORE_WRITE_SIZE == 0, "Bank size must be a multiple of write size");
+_Static_assert((WEAR_LEVELING_BACKING_SIZE / 2) % WEAR_LEVELING_ERASE_SIZE == 0, "Bank size must be a multiple of erase size");
+_Static_assert(WEAR_LEVELING_ERASE_SIZE % BACKING_STORE_ERASE_SIZE == 0, "Erase size must be a multiple of the backing store's erase size");
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_CHUNK_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Consolidation chunk size must be a multiple of write size");
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 // Backing Store API, to be implemented elsewhere by flash driver etc.
 bool backing_store_init(void);
 bool backing_store_unlock(void);
 bool backing_store_erase(void);
+bool backing_store_erase_range(uint32_t address, size_t length); // only required for incremental consolidation, must erase whole sectors within the range
 bool backing_store_write(uint32_t address, backing_store_int_t value);
 bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
 bool backing_store_lock(void);
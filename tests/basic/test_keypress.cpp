@@ -43,6 +43,31 @@ TEST_F(KeyPress, CorrectKeyIsReportedWhenPressed) {
     keyboard_task();
 }
 
+TEST_F(KeyPress, UnchangedReportsAreNotSent) {
+    TestDriver driver;
+    auto       key = KeymapKey(0, 0, 0, KC_A);
+
+    set_keymap({key});
+
+    key.press();
+    EXPECT_REPORT(driver, (key.report_code));
+    keyboard_task();
+
+    // Repeated sends of the same state, such as clear_keyboard() bursts, don't reach the host
+    uint32_t suppressed = host_suppressed_report_count();
+    EXPECT_NO_REPORT(driver);
+    send_keyboard_report();
+    send_keyboard_report();
+    EXPECT_EQ(host_suppressed_report_count(), suppressed + 2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key.release();
+    EXPECT_EMPTY_REPORT(driver);
+    keyboard_task();
+    clear_keyboard();
+    EXPECT_EQ(host_suppressed_report_count(), suppressed + 3);
+}
+
 TEST_F(KeyPress, ANonMappedKeyDoesNothing) {
     TestDriver driver;
     auto       key = KeymapKey(0, 0, 0, KC_NO);
@@ -76,6 +101,65 @@ TEST_F(KeyPress, CorrectKeysAreReportedWhenTwoKeysArePressed) {
     keyboard_task();
 }
 
+TEST_F(KeyPress, SeventhKeyIsReportedOnceASlotFreesUp) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d = KeymapKey(0, 3, 0, KC_D);
+    auto       key_e = KeymapKey(0, 4, 0, KC_E);
+    auto       key_f = KeymapKey(0, 5, 0, KC_F);
+    auto       key_g = KeymapKey(0, 6, 0, KC_G);
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e, key_f, key_g});
+
+    // Press G first, so that its keycode isn't the lowest of the ones left over when A is released
+    key_g.press();
+    EXPECT_REPORT(driver, (KC_G));
+    run_one_scan_loop();
+    key_f.press();
+    EXPECT_REPORT(driver, (KC_G, KC_F));
+    run_one_scan_loop();
+    key_e.press();
+    EXPECT_REPORT(driver, (KC_G, KC_F, KC_E));
+    run_one_scan_loop();
+    key_d.press();
+    EXPECT_REPORT(driver, (KC_G, KC_F, KC_E, KC_D));
+    run_one_scan_loop();
+    key_c.press();
+    EXPECT_REPORT(driver, (KC_G, KC_F, KC_E, KC_D, KC_C));
+    run_one_scan_loop();
+    key_b.press();
+    EXPECT_REPORT(driver, (KC_G, KC_F, KC_E, KC_D, KC_C, KC_B));
+    run_one_scan_loop();
+
+    // The report is full, so the keys already in it stay put
+    key_a.press();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+
+    key_d.release();
+    EXPECT_REPORT(driver, (KC_G, KC_F, KC_E, KC_C, KC_B, KC_A));
+    run_one_scan_loop();
+
+    key_a.release();
+    EXPECT_REPORT(driver, (KC_G, KC_F, KC_E, KC_C, KC_B));
+    run_one_scan_loop();
+
+    key_b.release();
+    key_c.release();
+    key_e.release();
+    key_f.release();
+    key_g.release();
+    EXPECT_REPORT(driver, (KC_G, KC_F, KC_E, KC_C));
+    EXPECT_REPORT(driver, (KC_G, KC_F, KC_E));
+    EXPECT_REPORT(driver, (KC_G, KC_F));
+    EXPECT_REPORT(driver, (KC_G));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+}
+
 TEST_F(KeyPress, LeftShiftIsReportedCorrectly) {
     TestDriver driver;
     auto       key_a    = KeymapKey(0, 0, 0, KC_A);
@@ -0,0 +1,28 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Counts the EEPROM block writes, which is what bulk transfer saves on
+uint16_t eeprom_block_writes = 0;
+
+void eeprom_write_block(const void *buf, void *addr, size_t len);
+void eeprom_update_block(const void *buf, void *addr, size_t len);
+
+static void counted_eeprom_write_block(const void *buf, void *addr, size_t len) {
+    eeprom_block_writes++;
+    eeprom_write_block(buf, addr, len);
+}
+
+static void counted_eeprom_update_block(const void *buf, void *addr, size_t len) {
+    eeprom_block_writes++;
+    eeprom_update_block(buf, addr, len);
+}
+
+// The test fixture provides its own keymap_key_to_keycode(), so the one the dynamic keymap overrides it with is renamed
+#define keymap_key_to_keycode dynamic_keymap_key_to_keycode
+#include "eeprom.h"
+#define eeprom_write_block counted_eeprom_write_block
+#define eeprom_update_block counted_eeprom_update_block
+#include "dynamic_keymap.c"
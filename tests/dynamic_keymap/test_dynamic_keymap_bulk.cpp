@@ -0,0 +1,145 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+
+extern uint16_t eeprom_block_writes;
+
+/* The test keymap is not in flash, so the dynamic keymap resets to KC_TRNS */
+uint8_t keymap_layer_count(void) {
+    return 0;
+}
+}
+
+#define KEYMAP_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+#define CHUNK_SIZE 28
+
+/* Drives the functions behind the VIA bulk transfer commands the way
+ * raw_hid_receive() does: set_buffer chunks go to
+ * dynamic_keymap_bulk_write() first, and only fall back to
+ * dynamic_keymap_set_buffer() outside of a session.
+ */
+class DynamicKeymapBulk : public TestFixture {
+   public:
+    uint8_t keymap[KEYMAP_SIZE];
+
+    void SetUp() override {
+        dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_NONE);
+        dynamic_keymap_reset();
+        eeprom_block_writes = 0;
+        for (uint16_t i = 0; i < KEYMAP_SIZE; i += 2) {
+            keymap[i]     = 0;
+            keymap[i + 1] = KC_A + (i / 2) % 26;
+        }
+    }
+
+    void set_buffer(uint16_t offset) {
+        uint16_t size = offset + CHUNK_SIZE > KEYMAP_SIZE ? KEYMAP_SIZE - offset : CHUNK_SIZE;
+        if (!dynamic_keymap_bulk_write(DYNAMIC_KEYMAP_BULK_KEYMAP, offset, size, &keymap[offset])) {
+            dynamic_keymap_set_buffer(offset, size, &keymap[offset]);
+        }
+    }
+
+    uint16_t fletcher16(void) {
+        uint16_t sum1 = 0, sum2 = 0;
+        for (uint16_t i = 0; i < KEYMAP_SIZE; i++) {
+            sum1 = (sum1 + keymap[i]) % 255;
+            sum2 = (sum2 + sum1) % 255;
+        }
+        return (sum2 << 8) | sum1;
+    }
+};
+
+TEST_F(DynamicKeymapBulk, UploadIsCommittedAndVerified) {
+    EXPECT_TRUE(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_KEYMAP));
+
+    for (uint16_t offset = 0; offset < KEYMAP_SIZE; offset += CHUNK_SIZE) {
+        set_buffer(offset);
+    }
+
+    uint16_t checksum = 0;
+    EXPECT_TRUE(dynamic_keymap_bulk_commit(&checksum));
+    EXPECT_EQ(checksum, fletcher16());
+
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                uint16_t i = ((layer * MATRIX_ROWS + row) * MATRIX_COLS + col) * 2;
+                EXPECT_EQ(dynamic_keymap_get_keycode(layer, row, col), keymap[i] << 8 | keymap[i + 1]);
+            }
+        }
+    }
+}
+
+TEST_F(DynamicKeymapBulk, UploadTakesFewerEepromWrites) {
+    for (uint16_t offset = 0; offset < KEYMAP_SIZE; offset += CHUNK_SIZE) {
+        set_buffer(offset);
+    }
+    uint16_t chunked_writes = eeprom_block_writes;
+
+    dynamic_keymap_reset();
+    eeprom_block_writes = 0;
+    EXPECT_TRUE(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_KEYMAP));
+    for (uint16_t offset = 0; offset < KEYMAP_SIZE; offset += CHUNK_SIZE) {
+        set_buffer(offset);
+    }
+    uint16_t checksum = 0;
+    EXPECT_TRUE(dynamic_keymap_bulk_commit(&checksum));
+
+    /* One write per 28 byte chunk, against one per 128 byte staged run */
+    EXPECT_EQ(chunked_writes, 12);
+    EXPECT_EQ(eeprom_block_writes, 3);
+}
+
+TEST_F(DynamicKeymapBulk, ReadsReturnStagedChunks) {
+    EXPECT_TRUE(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_KEYMAP));
+    set_buffer(0);
+    set_buffer(CHUNK_SIZE);
+
+    /* Straddles the end of the staged run */
+    uint8_t data[CHUNK_SIZE];
+    dynamic_keymap_get_buffer(CHUNK_SIZE + 14, CHUNK_SIZE, data);
+    for (uint16_t i = 0; i < CHUNK_SIZE; i++) {
+        uint16_t offset = CHUNK_SIZE + 14 + i;
+        EXPECT_EQ(data[i], offset < 2 * CHUNK_SIZE ? keymap[offset] : (offset % 2 ? KC_TRNS : 0)) << "offset " << offset;
+    }
+    EXPECT_EQ(eeprom_block_writes, 0);
+}
+
+TEST_F(DynamicKeymapBulk, AbortWithinBufferWritesNothing) {
+    EXPECT_TRUE(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_KEYMAP));
+    set_buffer(0);
+    set_buffer(CHUNK_SIZE);
+
+    EXPECT_TRUE(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_NONE));
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_TRNS);
+    EXPECT_EQ(eeprom_block_writes, 0);
+}
+
+TEST_F(DynamicKeymapBulk, AbortDropsStagedChunksOnly) {
+    EXPECT_TRUE(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_KEYMAP));
+
+    /* The fifth chunk does not fit next to the first four in the staging buffer, so they are written */
+    for (uint16_t offset = 0; offset <= 4 * CHUNK_SIZE; offset += CHUNK_SIZE) {
+        set_buffer(offset);
+    }
+
+    EXPECT_TRUE(dynamic_keymap_bulk_begin(DYNAMIC_KEYMAP_BULK_NONE));
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_B);
+    /* Key 56, the first one of the fifth chunk */
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 1, 6), KC_TRNS);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 1, 5), keymap[110] << 8 | keymap[111]);
+
+    uint16_t checksum = 0;
+    EXPECT_FALSE(dynamic_keymap_bulk_commit(&checksum));
+}
+
+TEST_F(DynamicKeymapBulk, ChunksOutsideOfSessionAreWrittenStraightAway) {
+    EXPECT_FALSE(dynamic_keymap_bulk_begin(0x7F));
+
+    set_buffer(0);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 1), KC_B);
+}
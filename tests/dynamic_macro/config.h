@@ -0,0 +1,10 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DYNAMIC_MACRO_COMPACT
+#define DYNAMIC_MACRO_SIZE 8
+#define DYNAMIC_MACRO_EEPROM_ADDR 400
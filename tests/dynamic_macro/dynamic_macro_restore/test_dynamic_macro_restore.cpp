@@ -0,0 +1,46 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "eeprom.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacroRestore : public TestFixture {};
+
+/* The saved macros are only loaded once, on the first key event, so
+ * the EEPROM contents have to be in place before any key is pressed.
+ */
+TEST_F(DynamicMacroRestore, RestoresSavedMacrosAndStopsAtTruncatedEvents) {
+    TestDriver driver;
+    auto       play1 = KeymapKey{0, 0, 0, DYN_MACRO_PLAY1};
+    auto       play2 = KeymapKey{0, 1, 0, DYN_MACRO_PLAY2};
+    auto       key_a = KeymapKey{0, 2, 1, KC_A};
+
+    set_keymap({play1, play2, key_a});
+
+    /* Macro 1 taps A, macro 2 holds the first byte of an A press that needs a tap state byte too */
+    const uint8_t header[] = {0xAD, 0xD4, 0x11, MATRIX_ROWS, MATRIX_COLS, 1, 2, 0, 1, 0};
+    const uint8_t index_a  = 1 * MATRIX_COLS + 2;
+    const uint8_t macro1[] = {0x80 | index_a, index_a};
+    eeprom_update_block(header, (void*)400, sizeof(header));
+    eeprom_update_block(macro1, (void*)410, sizeof(macro1));
+    eeprom_update_byte((uint8_t*)(410 + DYNAMIC_MACRO_SIZE - 1), 0xC0 | index_a);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    tap_key(play1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    tap_key(play2);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
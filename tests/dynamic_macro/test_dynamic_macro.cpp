@@ -0,0 +1,106 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "eeprom.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+class DynamicMacro : public TestFixture {
+   public:
+    KeymapKey rec1  = KeymapKey{0, 0, 0, DYN_REC_START1};
+    KeymapKey play1 = KeymapKey{0, 1, 0, DYN_MACRO_PLAY1};
+    KeymapKey stop  = KeymapKey{0, 2, 0, DYN_REC_STOP};
+
+    void record(std::vector<KeymapKey*> keys) {
+        tap_key(rec1);
+        for (auto key : keys) {
+            tap_key(*key);
+        }
+        tap_key(stop);
+    }
+};
+
+TEST_F(DynamicMacro, RecordAndPlay) {
+    TestDriver driver;
+    auto       key_a = KeymapKey{0, 0, 1, KC_A};
+    auto       key_b = KeymapKey{0, 9, 3, KC_B};
+
+    set_keymap({rec1, play1, stop, key_a, key_b});
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    EXPECT_REPORT(driver, (KC_B)).Times(1);
+    record({&key_a, &key_b});
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+    }
+    tap_key(play1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* The recorded events are persisted: magic, format, matrix size, cell size, macro 1 length, macro 2 length */
+    EXPECT_EQ(eeprom_read_word((uint16_t*)400), 0xD4AD);
+    EXPECT_EQ(eeprom_read_byte((uint8_t*)402), 0x11);
+    EXPECT_EQ(eeprom_read_byte((uint8_t*)403), MATRIX_ROWS);
+    EXPECT_EQ(eeprom_read_byte((uint8_t*)404), MATRIX_COLS);
+    EXPECT_EQ(eeprom_read_byte((uint8_t*)405), 1);
+    EXPECT_EQ(eeprom_read_word((uint16_t*)406), 4);
+    EXPECT_EQ(eeprom_read_word((uint16_t*)408), 0);
+}
+
+TEST_F(DynamicMacro, OneBytePerEvent) {
+    TestDriver driver;
+    auto       key_a = KeymapKey{0, 0, 1, KC_A};
+    auto       key_b = KeymapKey{0, 1, 1, KC_B};
+    auto       key_c = KeymapKey{0, 2, 1, KC_C};
+    auto       key_d = KeymapKey{0, 3, 1, KC_D};
+    auto       key_e = KeymapKey{0, 4, 1, KC_E};
+
+    set_keymap({rec1, play1, stop, key_a, key_b, key_c, key_d, key_e});
+
+    /* Eight bytes hold four taps, the fifth one does not fit */
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    record({&key_a, &key_b, &key_c, &key_d, &key_e});
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_REPORT(driver, (KC_C));
+        EXPECT_REPORT(driver, (KC_D));
+    }
+    tap_key(play1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
+
+TEST_F(DynamicMacro, TapStateIsPreserved) {
+    TestDriver driver;
+    auto       mod_tap = KeymapKey{0, 5, 2, LSFT_T(KC_A)};
+
+    set_keymap({rec1, play1, stop, mod_tap});
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    record({&mod_tap});
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* Replaying the recorded tap must not turn into a hold */
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    EXPECT_REPORT(driver, (KC_A)).Times(1);
+    tap_key(play1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,9 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Small enough that the oversized override list exercises the linear fallback
+#define KEY_OVERRIDE_INDEX_SIZE 4
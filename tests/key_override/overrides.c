@@ -0,0 +1,43 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+// clang-format off
+
+static const key_override_t shift_bspc_override = ko_make_basic(MOD_MASK_SHIFT, KC_BSPC, KC_DEL);
+static const key_override_t ctrl_a_b_override   = ko_make_basic(MOD_MASK_CTRL, KC_A, KC_B);
+static const key_override_t ctrl_a_c_override   = ko_make_basic(MOD_MASK_CTRL, KC_A, KC_C);
+static const key_override_t shift_a_d_override  = ko_make_basic(MOD_MASK_SHIFT, KC_A, KC_D);
+static const key_override_t ctrl_z_x_override   = ko_make_basic(MOD_MASK_CTRL, KC_Z, KC_X);
+static const key_override_t ctrl_y_w_override   = ko_make_basic(MOD_MASK_CTRL, KC_Y, KC_W);
+
+// Declared out of trigger order on purpose, the index must still honour declaration order
+const key_override_t *indexed_override_list[] = {
+    &shift_bspc_override,
+    &ctrl_a_b_override,
+    &ctrl_a_c_override,
+    NULL
+};
+
+// Holds more overrides than KEY_OVERRIDE_INDEX_SIZE
+const key_override_t *oversized_override_list[] = {
+    &ctrl_z_x_override,
+    &ctrl_y_w_override,
+    &shift_a_d_override,
+    &ctrl_a_c_override,
+    &ctrl_a_b_override,
+    &shift_bspc_override,
+    NULL
+};
+
+// Entries are replaced at runtime
+const key_override_t *changing_override_list[] = {
+    &ctrl_a_b_override,
+    &ctrl_z_x_override,
+    NULL
+};
+
+const key_override_t *const shift_bspc_override_ptr = &shift_bspc_override;
+
+const key_override_t **key_overrides = (const key_override_t **)indexed_override_list;
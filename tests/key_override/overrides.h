@@ -0,0 +1,14 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+extern "C" {
+
+#include "process_key_override.h"
+
+extern const key_override_t *indexed_override_list[];
+extern const key_override_t *oversized_override_list[];
+extern const key_override_t *changing_override_list[];
+extern const key_override_t *const shift_bspc_override_ptr;
+}
@@ -0,0 +1,191 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+#include "overrides.h"
+
+using testing::_;
+using testing::InSequence;
+
+class KeyOverride : public TestFixture {
+   public:
+    void SetUp() override {
+        key_overrides = (const key_override_t **)indexed_override_list;
+    }
+};
+
+TEST_F(KeyOverride, ReplacesTriggerWithModsDown) {
+    TestDriver driver;
+    auto       key_lsft = KeymapKey{0, 0, 0, KC_LSFT};
+    auto       key_bspc = KeymapKey{0, 1, 0, KC_BSPC};
+
+    set_keymap({key_lsft, key_bspc});
+
+    key_lsft.press();
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_bspc.press();
+    EXPECT_REPORT(driver, (KC_DEL));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_bspc.release();
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_lsft.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+}
+
+TEST_F(KeyOverride, UnrelatedKeyPassesThrough) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_lctl = KeymapKey{0, 0, 0, KC_LCTL};
+    auto       key_z    = KeymapKey{0, 1, 0, KC_Z};
+
+    set_keymap({key_lctl, key_z});
+
+    key_lctl.press();
+    EXPECT_REPORT(driver, (KC_LCTL));
+    run_one_scan_loop();
+
+    key_z.press();
+    EXPECT_REPORT(driver, (KC_LCTL, KC_Z));
+    run_one_scan_loop();
+
+    key_z.release();
+    EXPECT_REPORT(driver, (KC_LCTL));
+    run_one_scan_loop();
+
+    key_lctl.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+}
+
+TEST_F(KeyOverride, FirstDeclaredOverrideWins) {
+    TestDriver driver;
+    auto       key_lctl = KeymapKey{0, 0, 0, KC_LCTL};
+    auto       key_a    = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({key_lctl, key_a});
+
+    key_lctl.press();
+    EXPECT_REPORT(driver, (KC_LCTL));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* ctrl + a -> b is declared before ctrl + a -> c */
+    key_a.press();
+    EXPECT_REPORT(driver, (KC_B));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_a.release();
+    EXPECT_REPORT(driver, (KC_LCTL));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_lctl.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+}
+
+TEST_F(KeyOverride, ReassignedListIsReindexed) {
+    TestDriver driver;
+    auto       key_lsft = KeymapKey{0, 0, 0, KC_LSFT};
+    auto       key_a    = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({key_lsft, key_a});
+
+    /* The oversized list exceeds the index and is scanned linearly */
+    key_overrides = (const key_override_t **)oversized_override_list;
+
+    key_lsft.press();
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_a.press();
+    EXPECT_REPORT(driver, (KC_D));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_a.release();
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_lsft.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+}
+
+TEST_F(KeyOverride, OversizedListKeepsDeclarationOrder) {
+    TestDriver driver;
+    auto       key_lctl = KeymapKey{0, 0, 0, KC_LCTL};
+    auto       key_a    = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({key_lctl, key_a});
+
+    key_overrides = (const key_override_t **)oversized_override_list;
+
+    key_lctl.press();
+    EXPECT_REPORT(driver, (KC_LCTL));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    /* ctrl + a -> c comes first in the oversized list */
+    key_a.press();
+    EXPECT_REPORT(driver, (KC_C));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_a.release();
+    EXPECT_REPORT(driver, (KC_LCTL));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_lctl.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+}
+
+TEST_F(KeyOverride, ChangedEntryIsReindexed) {
+    TestDriver driver;
+    auto       key_lsft = KeymapKey{0, 0, 0, KC_LSFT};
+    auto       key_bspc = KeymapKey{0, 1, 0, KC_BSPC};
+
+    set_keymap({key_lsft, key_bspc});
+
+    key_overrides = (const key_override_t **)changing_override_list;
+    key_override_init();
+
+    /* Replace ctrl + a -> b with shift + backspace -> delete in place, which moves it to the end of the index */
+    changing_override_list[0] = shift_bspc_override_ptr;
+
+    key_lsft.press();
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_bspc.press();
+    EXPECT_REPORT(driver, (KC_DEL));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_bspc.release();
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    key_lsft.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+}
@@ -0,0 +1,10 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define LEADER_TIMEOUT 300
+#define LEADER_PER_KEY_TIMING
+#define LEADER_SEQUENCE_COUNT 6
@@ -0,0 +1,67 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+uint8_t seq_a_count       = 0;
+uint8_t seq_a_b_count     = 0;
+uint8_t seq_a_c_count     = 0;
+uint8_t seq_long_count    = 0;
+uint8_t seq_a_z_count     = 0;
+uint8_t seq_b_b_count     = 0;
+uint8_t seq_b_b_dup_count = 0;
+uint8_t leader_end_count  = 0;
+
+static void seq_a(void) {
+    seq_a_count++;
+}
+
+static void seq_a_b(void) {
+    seq_a_b_count++;
+}
+
+static void seq_a_c(void) {
+    seq_a_c_count++;
+}
+
+static void seq_long(void) {
+    seq_long_count++;
+}
+
+static void seq_b_b(void) {
+    seq_b_b_count++;
+}
+
+static void seq_b_b_dup(void) {
+    seq_b_b_dup_count++;
+}
+
+void leader_end(void) {
+    leader_end_count++;
+}
+
+LEADER_EXTERNS();
+
+// What a keymap would run from matrix_scan_user, which the test matrix does not call. Sequences not in the table are only matched here.
+void check_leader_dictionary(void) {
+    LEADER_DICTIONARY() {
+        leading = false;
+        leader_end();
+
+        SEQ_TWO_KEYS(KC_A, KC_Z) {
+            seq_a_z_count++;
+        }
+    }
+}
+
+// Declared out of order on purpose, the table is sorted when leading starts
+// clang-format off
+const leader_sequence_t PROGMEM leader_sequences[LEADER_SEQUENCE_COUNT] = {
+    LEADER_SEQ(seq_long, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I),
+    LEADER_SEQ(seq_a_c, KC_A, KC_C),
+    LEADER_SEQ(seq_a, KC_A),
+    LEADER_SEQ(seq_a_b, KC_A, KC_B),
+    LEADER_SEQ(seq_b_b, KC_B, KC_B),
+    LEADER_SEQ(seq_b_b_dup, KC_B, KC_B),
+};
+// clang-format on
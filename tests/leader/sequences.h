@@ -0,0 +1,21 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+extern "C" {
+
+#include <stdint.h>
+
+extern uint8_t seq_a_count;
+extern uint8_t seq_a_b_count;
+extern uint8_t seq_a_c_count;
+extern uint8_t seq_long_count;
+extern uint8_t seq_a_z_count;
+extern uint8_t seq_b_b_count;
+extern uint8_t seq_b_b_dup_count;
+extern uint8_t leader_end_count;
+
+void check_leader_dictionary(void);
+void advance_time(uint32_t ms);
+}
@@ -0,0 +1,173 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+#include "sequences.h"
+
+using testing::_;
+
+class Leader : public TestFixture {
+   public:
+    void SetUp() override {
+        seq_a_count       = 0;
+        seq_a_b_count     = 0;
+        seq_a_c_count     = 0;
+        seq_long_count    = 0;
+        seq_a_z_count     = 0;
+        seq_b_b_count     = 0;
+        seq_b_b_dup_count = 0;
+        leader_end_count  = 0;
+    }
+};
+
+TEST_F(Leader, UnambiguousSequenceFiresWithoutTimeout) {
+    TestDriver driver;
+    auto       key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    auto       key_a    = KeymapKey{0, 1, 0, KC_A};
+    auto       key_b    = KeymapKey{0, 2, 0, KC_B};
+
+    set_keymap({key_lead, key_a, key_b});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_lead);
+    tap_key(key_a);
+    EXPECT_EQ(seq_a_count, 0);
+    tap_key(key_b);
+
+    EXPECT_EQ(seq_a_b_count, 1);
+    EXPECT_EQ(seq_a_count, 0);
+    EXPECT_EQ(leader_end_count, 1);
+}
+
+TEST_F(Leader, AmbiguousPrefixFiresOnTimeout) {
+    TestDriver driver;
+    auto       key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    auto       key_a    = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({key_lead, key_a});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_lead);
+    tap_key(key_a);
+    EXPECT_EQ(seq_a_count, 0);
+
+    idle_for(LEADER_TIMEOUT + 1);
+    EXPECT_EQ(seq_a_count, 1);
+    EXPECT_EQ(leader_end_count, 1);
+}
+
+TEST_F(Leader, SequenceLongerThanFiveKeys) {
+    TestDriver driver;
+    auto       key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    auto       key_c    = KeymapKey{0, 1, 0, KC_C};
+    auto       key_d    = KeymapKey{0, 2, 0, KC_D};
+    auto       key_e    = KeymapKey{0, 3, 0, KC_E};
+    auto       key_f    = KeymapKey{0, 4, 0, KC_F};
+    auto       key_g    = KeymapKey{0, 5, 0, KC_G};
+    auto       key_h    = KeymapKey{0, 6, 0, KC_H};
+    auto       key_i    = KeymapKey{0, 7, 0, KC_I};
+
+    set_keymap({key_lead, key_c, key_d, key_e, key_f, key_g, key_h, key_i});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_lead);
+    tap_keys(key_c, key_d, key_e, key_f, key_g, key_h);
+    EXPECT_EQ(seq_long_count, 0);
+    tap_key(key_i);
+
+    EXPECT_EQ(seq_long_count, 1);
+    EXPECT_EQ(leader_end_count, 1);
+}
+
+TEST_F(Leader, UnknownSequenceEndsLeaderOnTimeout) {
+    TestDriver driver;
+    auto       key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    auto       key_b    = KeymapKey{0, 1, 0, KC_B};
+    auto       key_z    = KeymapKey{0, 2, 0, KC_Z};
+
+    set_keymap({key_lead, key_b, key_z});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_lead);
+    tap_key(key_b);
+    tap_key(key_z);
+    EXPECT_EQ(leader_end_count, 0);
+
+    idle_for(LEADER_TIMEOUT + 1);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_EQ(seq_a_z_count, 0);
+    EXPECT_EQ(leader_end_count, 1);
+
+    /* Keys are sent normally again once the leader sequence ended */
+    key_z.press();
+    EXPECT_REPORT(driver, (KC_Z));
+    run_one_scan_loop();
+    key_z.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+}
+
+TEST_F(Leader, UnknownSequenceIsLeftToLeaderDictionary) {
+    TestDriver driver;
+    auto       key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    auto       key_a    = KeymapKey{0, 1, 0, KC_A};
+    auto       key_z    = KeymapKey{0, 2, 0, KC_Z};
+
+    set_keymap({key_lead, key_a, key_z});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_lead);
+    tap_key(key_a);
+    tap_key(key_z);
+
+    /* matrix_scan_user runs ahead of the leader task */
+    advance_time(LEADER_TIMEOUT + 1);
+    check_leader_dictionary();
+    run_one_scan_loop();
+
+    EXPECT_EQ(seq_a_z_count, 1);
+    EXPECT_EQ(seq_a_count, 0);
+    EXPECT_EQ(leader_end_count, 1);
+}
+
+TEST_F(Leader, TableMatchIsNotLeftToLeaderDictionary) {
+    TestDriver driver;
+    auto       key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    auto       key_a    = KeymapKey{0, 1, 0, KC_A};
+
+    set_keymap({key_lead, key_a});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_lead);
+    tap_key(key_a);
+
+    advance_time(LEADER_TIMEOUT + 1);
+    check_leader_dictionary();
+    run_one_scan_loop();
+
+    EXPECT_EQ(seq_a_count, 1);
+    EXPECT_EQ(leader_end_count, 1);
+}
+
+TEST_F(Leader, FirstOfDuplicateSequencesFiresOnTimeout) {
+    TestDriver driver;
+    auto       key_lead = KeymapKey{0, 0, 0, KC_LEAD};
+    auto       key_b    = KeymapKey{0, 1, 0, KC_B};
+
+    set_keymap({key_lead, key_b});
+
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_lead);
+    tap_key(key_b);
+    tap_key(key_b);
+    EXPECT_EQ(seq_b_b_count, 0);
+
+    idle_for(LEADER_TIMEOUT + 1);
+    EXPECT_EQ(seq_b_b_count, 1);
+    EXPECT_EQ(seq_b_b_dup_count, 0);
+    EXPECT_EQ(leader_end_count, 1);
+}
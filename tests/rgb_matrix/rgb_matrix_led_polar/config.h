@@ -0,0 +1,17 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DRIVER_LED_TOTAL (MATRIX_ROWS * MATRIX_COLS)
+
+#define RGB_MATRIX_LED_POLAR_CACHE
+#define RGB_MATRIX_LED_FLUSH_LIMIT 1
+
+#define ENABLE_RGB_MATRIX_BAND_PINWHEEL_SAT
+#define ENABLE_RGB_MATRIX_BAND_SPIRAL_VAL
+#define ENABLE_RGB_MATRIX_CYCLE_OUT_IN
+#define ENABLE_RGB_MATRIX_CYCLE_PINWHEEL
+#define ENABLE_RGB_MATRIX_CYCLE_SPIRAL
@@ -0,0 +1,142 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "eeconfig.h"
+#include "lib/lib8tion/lib8tion.h"
+
+void advance_time(uint32_t ms);
+}
+
+namespace {
+RGB      leds[DRIVER_LED_TOTAL];
+uint32_t frames;
+
+void driver_init(void) {}
+
+void driver_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    leds[index].r = r;
+    leds[index].g = g;
+    leds[index].b = b;
+}
+
+void driver_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
+        driver_set_color(i, r, g, b);
+    }
+}
+
+void driver_flush(void) {
+    ++frames;
+}
+
+// What each effect worked out from atan2_8() and sqrt16() before the polar coordinates were cached
+HSV cycle_pinwheel(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    hsv.h = atan2_8(dy, dx) + time;
+    return hsv;
+}
+
+HSV cycle_spiral(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    hsv.h = sqrt16(dx * dx + dy * dy) - time - atan2_8(dy, dx);
+    return hsv;
+}
+
+HSV band_spiral_val(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    hsv.v = scale8(hsv.v + sqrt16(dx * dx + dy * dy) - time - atan2_8(dy, dx), hsv.v);
+    return hsv;
+}
+
+HSV band_pinwheel_sat(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    hsv.s = scale8(hsv.s - time - atan2_8(dy, dx) * 3, hsv.s);
+    return hsv;
+}
+
+HSV cycle_out_in(HSV hsv, int16_t dx, int16_t dy, uint8_t time) {
+    hsv.h = 3 * sqrt16(dx * dx + dy * dy) / 2 + time;
+    return hsv;
+}
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = driver_init,
+    .set_color     = driver_set_color,
+    .set_color_all = driver_set_color_all,
+    .flush         = driver_flush,
+};
+
+// Scattered around the centre, so that every quadrant and a good range of distances is covered
+led_config_t g_led_config = [] {
+    led_config_t config;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t i                  = row * MATRIX_COLS + col;
+            config.matrix_co[row][col] = i;
+            config.point[i]            = {.x = (uint8_t)(col * 224 / (MATRIX_COLS - 1) + row * 7), .y = (uint8_t)(row * 64 / (MATRIX_ROWS - 1) + col * 3)};
+            config.flags[i]            = LED_FLAG_KEYLIGHT;
+        }
+    }
+    return config;
+}();
+}
+
+struct PolarEffect {
+    uint8_t     mode;
+    const char *name;
+    HSV (*reference)(HSV hsv, int16_t dx, int16_t dy, uint8_t time);
+};
+
+class RgbMatrixLedPolar : public testing::TestWithParam<PolarEffect> {
+   protected:
+    static void SetUpTestSuite() {
+        eeconfig_init();
+        rgb_matrix_init();
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(50, 200, 255);
+        rgb_matrix_set_speed_noeeprom(UINT8_MAX / 2);
+    }
+
+    void render_frame() {
+        uint32_t start = frames;
+        advance_time(7);
+        while (frames == start) {
+            rgb_matrix_task();
+        }
+    }
+};
+
+TEST_P(RgbMatrixLedPolar, MatchesDirectCalculation) {
+    rgb_matrix_mode_noeeprom(GetParam().mode);
+
+    for (int frame = 0; frame < 50; frame++) {
+        render_frame();
+
+        uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+        for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+            int16_t dx       = g_led_config.point[i].x - 112;
+            int16_t dy       = g_led_config.point[i].y - 32;
+            RGB     expected = hsv_to_rgb(GetParam().reference(rgb_matrix_config.hsv, dx, dy, time));
+            ASSERT_EQ(leds[i].r, expected.r) << "LED " << (int)i << " in frame " << frame;
+            ASSERT_EQ(leds[i].g, expected.g) << "LED " << (int)i << " in frame " << frame;
+            ASSERT_EQ(leds[i].b, expected.b) << "LED " << (int)i << " in frame " << frame;
+        }
+    }
+}
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    Effects,
+    RgbMatrixLedPolar,
+    testing::Values(
+        PolarEffect{RGB_MATRIX_CYCLE_PINWHEEL, "CyclePinwheel", cycle_pinwheel},
+        PolarEffect{RGB_MATRIX_CYCLE_SPIRAL, "CycleSpiral", cycle_spiral},
+        PolarEffect{RGB_MATRIX_BAND_SPIRAL_VAL, "BandSpiralVal", band_spiral_val},
+        PolarEffect{RGB_MATRIX_BAND_PINWHEEL_SAT, "BandPinwheelSat", band_pinwheel_sat},
+        PolarEffect{RGB_MATRIX_CYCLE_OUT_IN, "CycleOutIn", cycle_out_in}
+    ),
+    [](const testing::TestParamInfo<PolarEffect> &info) { return std::string(info.param.name); }
+);
+// clang-format on
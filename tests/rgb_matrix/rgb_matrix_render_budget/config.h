@@ -0,0 +1,10 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DRIVER_LED_TOTAL (MATRIX_ROWS * MATRIX_COLS)
+
+#define RGB_MATRIX_RENDER_BUDGET 200
@@ -0,0 +1,147 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "eeconfig.h"
+#include "timer.h"
+
+void advance_time_us(uint32_t us);
+}
+
+namespace {
+// Simulated cost of rendering each LED, and of the rest of each keyboard loop
+uint32_t led_cost_us  = 25;
+uint32_t scan_cost_us = 300;
+
+uint8_t  rendered[DRIVER_LED_TOTAL];
+uint32_t frames;
+uint32_t incomplete_frames;
+
+void driver_init(void) {}
+void driver_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {}
+void driver_set_color_all(uint8_t r, uint8_t g, uint8_t b) {}
+
+void driver_flush(void) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
+        if (rendered[i] != 1) {
+            ++incomplete_frames;
+            break;
+        }
+    }
+    memset(rendered, 0, sizeof(rendered));
+    ++frames;
+}
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = driver_init,
+    .set_color     = driver_set_color,
+    .set_color_all = driver_set_color_all,
+    .flush         = driver_flush,
+};
+
+led_config_t g_led_config = [] {
+    led_config_t config;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t i                  = row * MATRIX_COLS + col;
+            config.matrix_co[row][col] = i;
+            config.point[i]            = {.x = (uint8_t)(col * 224 / (MATRIX_COLS - 1)), .y = (uint8_t)(row * 64 / (MATRIX_ROWS - 1))};
+            config.flags[i]            = LED_FLAG_KEYLIGHT;
+        }
+    }
+    return config;
+}();
+
+// Called with each iteration's LEDs, so stands in for an expensive effect
+void rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max) {
+    for (uint8_t i = led_min; i < led_max; i++) {
+        ++rendered[i];
+    }
+    advance_time_us((led_max - led_min) * led_cost_us);
+}
+}
+
+class RgbMatrixRenderBudget : public testing::Test {
+   protected:
+    uint32_t max_task_us;
+
+    static void SetUpTestSuite() {
+        eeconfig_init();
+        rgb_matrix_init();
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    }
+
+    void SetUp() override {
+        led_cost_us  = 25;
+        scan_cost_us = 300;
+        run_for(1000);
+        frames            = 0;
+        incomplete_frames = 0;
+    }
+
+    // Runs the keyboard loop for the given simulated time, tracking the longest rgb_matrix_task() call
+    void run_for(uint32_t ms) {
+        max_task_us  = 0;
+        uint32_t end = timer_read32() + ms;
+        while (!timer_expired32(timer_read32(), end)) {
+            uint32_t start = timer_read_us();
+            rgb_matrix_task();
+            max_task_us = MAX(max_task_us, timer_read_us() - start);
+            advance_time_us(scan_cost_us);
+        }
+    }
+};
+
+TEST_F(RgbMatrixRenderBudget, IterationsFitTheBudget) {
+    run_for(2000);
+    EXPECT_EQ(rgb_matrix_get_render_stats()->chunk, RGB_MATRIX_RENDER_BUDGET / led_cost_us);
+    EXPECT_LE(max_task_us, RGB_MATRIX_RENDER_BUDGET);
+    EXPECT_LE(rgb_matrix_get_render_stats()->max_us, RGB_MATRIX_RENDER_BUDGET);
+    EXPECT_GT(frames, 0);
+    EXPECT_EQ(incomplete_frames, 0);
+}
+
+TEST_F(RgbMatrixRenderBudget, AdaptsToTheCostOfTheEffect) {
+    led_cost_us = 10;
+    run_for(1000);
+    EXPECT_EQ(rgb_matrix_get_render_stats()->chunk, RGB_MATRIX_RENDER_BUDGET / led_cost_us);
+    EXPECT_LE(max_task_us, RGB_MATRIX_RENDER_BUDGET);
+
+    led_cost_us = 50;
+    run_for(1000);
+    EXPECT_EQ(rgb_matrix_get_render_stats()->chunk, RGB_MATRIX_RENDER_BUDGET / led_cost_us);
+
+    // Only the first few iterations after the change can go over
+    run_for(1000);
+    EXPECT_LE(max_task_us, RGB_MATRIX_RENDER_BUDGET);
+    EXPECT_EQ(incomplete_frames, 0);
+}
+
+TEST_F(RgbMatrixRenderBudget, SingleLedsOverBudgetStillRender) {
+    led_cost_us = RGB_MATRIX_RENDER_BUDGET * 2;
+    run_for(2000);
+    EXPECT_EQ(rgb_matrix_get_render_stats()->chunk, 1);
+    EXPECT_GT(frames, 0);
+    EXPECT_EQ(incomplete_frames, 0);
+}
+
+TEST_F(RgbMatrixRenderBudget, ReportsFramerateAndLoad) {
+    run_for(3000);
+
+    const rgb_matrix_render_stats_t *stats = rgb_matrix_get_render_stats();
+    uint32_t                         fps   = 1000 / RGB_MATRIX_LED_FLUSH_LIMIT;
+    EXPECT_GE(stats->fps, fps - 3);
+    EXPECT_LE(stats->fps, fps + 1);
+
+    // Every LED costs led_cost_us once per frame
+    uint32_t load = stats->fps * DRIVER_LED_TOTAL * led_cost_us / 1000;
+    EXPECT_GE(stats->load, load - 5);
+    EXPECT_LE(stats->load, load + 5);
+    printf("%u fps, %u/1000 of the time rendering, %u us at most, %u LEDs at a time\n", stats->fps, stats->load, stats->max_us, stats->chunk);
+}
@@ -0,0 +1,14 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DRIVER_LED_TOTAL (MATRIX_ROWS * MATRIX_COLS)
+
+#define RGB_MATRIX_SPARSE_UPDATES
+#define RGB_MATRIX_KEYPRESSES
+#define RGB_MATRIX_LED_FLUSH_LIMIT 1
+
+#define ENABLE_RGB_MATRIX_SOLID_REACTIVE_SIMPLE
@@ -0,0 +1,130 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "eeconfig.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+struct led_state_t {
+    uint8_t  r, g, b;
+    uint32_t writes;
+};
+
+led_state_t leds[DRIVER_LED_TOTAL];
+uint32_t    frames;
+
+void driver_init(void) {}
+
+void driver_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    leds[index] = {r, g, b, leds[index].writes + 1};
+}
+
+void driver_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
+        driver_set_color(i, r, g, b);
+    }
+}
+
+void driver_flush(void) {
+    ++frames;
+}
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = driver_init,
+    .set_color     = driver_set_color,
+    .set_color_all = driver_set_color_all,
+    .flush         = driver_flush,
+};
+
+led_config_t g_led_config = [] {
+    led_config_t config;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t i                  = row * MATRIX_COLS + col;
+            config.matrix_co[row][col] = i;
+            config.point[i]            = {.x = (uint8_t)(col * 224 / (MATRIX_COLS - 1)), .y = (uint8_t)(row * 64 / (MATRIX_ROWS - 1))};
+            config.flags[i]            = LED_FLAG_KEYLIGHT;
+        }
+    }
+    return config;
+}();
+}
+
+class SparseUpdates : public testing::Test {
+   protected:
+    void SetUp() override {
+        set_time(0);
+        eeconfig_init();
+        rgb_matrix_init();
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_REACTIVE_SIMPLE);
+        // The first frame after a mode change draws every LED
+        render_frame();
+        unlit = leds[0];
+        clear_writes();
+    }
+
+    void render_frame(uint32_t ms = 1) {
+        uint32_t start = frames;
+        advance_time(ms);
+        while (frames == start) {
+            rgb_matrix_task();
+        }
+    }
+
+    void press(uint8_t led) {
+        process_rgb_matrix(led / MATRIX_COLS, led % MATRIX_COLS, true);
+    }
+
+    void clear_writes() {
+        for (auto& led : leds) {
+            led.writes = 0;
+        }
+    }
+
+    void expect_unlit(uint8_t led) {
+        EXPECT_EQ(leds[led].r, unlit.r);
+        EXPECT_EQ(leds[led].g, unlit.g);
+        EXPECT_EQ(leds[led].b, unlit.b);
+    }
+
+    led_state_t unlit;
+};
+
+TEST_F(SparseUpdates, OnlyHitLedsAreDrawn) {
+    press(5);
+    render_frame();
+    render_frame();
+
+    EXPECT_EQ(leds[5].writes, 2);
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        if (i != 5) {
+            EXPECT_EQ(leds[i].writes, 0) << "LED " << +i;
+        }
+    }
+}
+
+TEST_F(SparseUpdates, ExpiredHitIsDrawnAtItsFinalValue) {
+    uint16_t max_tick = 65535 / (rgb_matrix_get_speed() + 1);
+
+    press(5);
+    render_frame();
+    // The last frame drawn for the hit is part way through it, so the LED is still lit
+    render_frame(max_tick / 2);
+    EXPECT_NE(leds[5].r, unlit.r);
+    render_frame(max_tick);
+    expect_unlit(5);
+
+    clear_writes();
+    render_frame();
+    EXPECT_EQ(leds[5].writes, 0);
+}
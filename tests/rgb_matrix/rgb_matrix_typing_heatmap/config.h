@@ -0,0 +1,17 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define DRIVER_LED_TOTAL (MATRIX_ROWS * MATRIX_COLS)
+
+#define RGB_MATRIX_SPARSE_UPDATES
+#define RGB_MATRIX_LED_FLUSH_LIMIT 1
+
+#define RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS 25
+#define RGB_MATRIX_TYPING_HEATMAP_SPREAD 40
+#define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
+
+#define ENABLE_RGB_MATRIX_TYPING_HEATMAP
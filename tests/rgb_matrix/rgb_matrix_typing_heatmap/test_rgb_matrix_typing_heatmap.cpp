@@ -0,0 +1,240 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "eeconfig.h"
+#include "lib/lib8tion/lib8tion.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+namespace {
+RGB      leds[DRIVER_LED_TOTAL];
+uint32_t frames;
+uint32_t writes;
+
+void driver_init(void) {}
+
+void driver_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    leds[index].r = r;
+    leds[index].g = g;
+    leds[index].b = b;
+    ++writes;
+}
+
+void driver_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
+        driver_set_color(i, r, g, b);
+    }
+}
+
+void driver_flush(void) {
+    ++frames;
+}
+
+// The heatmap as it was kept before: every key pressed warms up all the keys in reach, and every key cools down on
+// each step of the decrease delay
+struct Reference {
+    uint8_t  heat[DRIVER_LED_TOTAL];
+    uint32_t tick;
+
+    void reset(uint32_t now) {
+        memset(heat, 0, sizeof(heat));
+        tick = now / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS;
+    }
+
+    void advance_to(uint32_t now) {
+        for (; tick < now / RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS; tick++) {
+            for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+                heat[i] = qsub8(heat[i], 1);
+            }
+        }
+    }
+
+    void press(uint8_t row, uint8_t col) {
+        uint8_t led = g_led_config.matrix_co[row][col];
+        if (led == NO_LED) {
+            return;
+        }
+        for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
+            for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+                uint8_t target = g_led_config.matrix_co[i_row][i_col];
+                if (target == NO_LED) {
+                    continue;
+                }
+                if (target == led) {
+                    heat[target] = qadd8(heat[target], 32);
+                    continue;
+                }
+                int16_t dx       = g_led_config.point[led].x - g_led_config.point[target].x;
+                int16_t dy       = g_led_config.point[led].y - g_led_config.point[target].y;
+                uint8_t distance = sqrt16(dx * dx + dy * dy);
+                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+                    }
+                    heat[target] = qadd8(heat[target], amount);
+                }
+            }
+        }
+    }
+
+    RGB colour(uint8_t led) const {
+        uint8_t val = heat[led];
+        return hsv_to_rgb({(uint8_t)(170 - qsub8(val, 85)), rgb_matrix_config.hsv.s, scale8((qadd8(170, val) - 170) * 3, rgb_matrix_config.hsv.v)});
+    }
+} reference;
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = driver_init,
+    .set_color     = driver_set_color,
+    .set_color_all = driver_set_color_all,
+    .flush         = driver_flush,
+};
+
+// One LED per key, except the last key, whose LED sits in the middle of the board without being part of the matrix
+led_config_t g_led_config = [] {
+    led_config_t config;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t i                  = row * MATRIX_COLS + col;
+            config.matrix_co[row][col] = i;
+            config.point[i]            = {.x = (uint8_t)(col * 224 / (MATRIX_COLS - 1)), .y = (uint8_t)(row * 64 / (MATRIX_ROWS - 1))};
+            config.flags[i]            = LED_FLAG_KEYLIGHT;
+        }
+    }
+    config.matrix_co[MATRIX_ROWS - 1][MATRIX_COLS - 1] = NO_LED;
+    config.point[DRIVER_LED_TOTAL - 1]                 = {.x = 112, .y = 32};
+    config.flags[DRIVER_LED_TOTAL - 1]                 = LED_FLAG_UNDERGLOW;
+    return config;
+}();
+}
+
+class TypingHeatmap : public testing::Test {
+   protected:
+    uint32_t now;
+
+    static void SetUpTestSuite() {
+        set_time(0);
+        eeconfig_init();
+        rgb_matrix_init();
+    }
+
+    void SetUp() override {
+        // Start from a cold heatmap, by having the effect start over
+        rgb_matrix_disable_noeeprom();
+        render_frame(1);
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_TYPING_HEATMAP);
+        rgb_matrix_sethsv_noeeprom(HSV_RED);
+        render_frame(1);
+        now = timer_read32();
+        reference.reset(now);
+    }
+
+    // Runs the task until the next frame has been flushed
+    void render_frame(uint32_t ms) {
+        uint32_t start = frames;
+        advance_time(ms);
+        while (frames == start) {
+            rgb_matrix_task();
+        }
+    }
+
+    void step(uint32_t ms) {
+        render_frame(ms);
+        now = timer_read32();
+        reference.advance_to(now);
+    }
+
+    void press(uint8_t row, uint8_t col) {
+        process_rgb_matrix(row, col, true);
+        reference.press(row, col);
+    }
+
+    void expect_matches_reference() {
+        for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+            RGB expected = reference.colour(i);
+            ASSERT_EQ(leds[i].r, expected.r) << "LED " << (int)i << " at " << now << "ms, heat " << (int)reference.heat[i];
+            ASSERT_EQ(leds[i].g, expected.g) << "LED " << (int)i << " at " << now << "ms, heat " << (int)reference.heat[i];
+            ASSERT_EQ(leds[i].b, expected.b) << "LED " << (int)i << " at " << now << "ms, heat " << (int)reference.heat[i];
+        }
+    }
+};
+
+TEST_F(TypingHeatmap, MatchesDecayingEveryKey) {
+    uint32_t rng    = 1;
+    auto     random = [&rng]() {
+        // xorshift32
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+
+    for (int i = 0; i < 20000; i++) {
+        uint32_t choice = random();
+        // Bursts of typing, with pauses long enough for everything to cool down in between
+        if (i % 4000 < 2500 && choice % 4 == 0) {
+            press(choice / 4 % MATRIX_ROWS, choice / 16 % MATRIX_COLS);
+        }
+        step(1 + choice / 256 % 9);
+        expect_matches_reference();
+        if (HasFailure()) {
+            FAIL() << "Heatmap went wrong after " << i + 1 << " frames";
+        }
+    }
+}
+
+TEST_F(TypingHeatmap, CoolsDownOneStepAtATime) {
+    press(1, 4);
+    for (int i = 0; i < 40; i++) {
+        step(RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS);
+        expect_matches_reference();
+    }
+    EXPECT_EQ(reference.heat[1 * MATRIX_COLS + 4], 0);
+}
+
+TEST_F(TypingHeatmap, StaysColdAfterALongPause) {
+    press(2, 2);
+    press(2, 2);
+    // Far longer than the 255 steps it takes for the step counter to come back round
+    for (int i = 0; i < 20000; i++) {
+        step(1);
+    }
+    expect_matches_reference();
+    press(0, 0);
+    step(1);
+    expect_matches_reference();
+}
+
+TEST_F(TypingHeatmap, IdleFramesDrawNothing) {
+    press(1, 1);
+    for (int i = 0; i < 40; i++) {
+        step(RGB_MATRIX_TYPING_HEATMAP_DECREASE_DELAY_MS);
+    }
+    expect_matches_reference();
+
+    writes = 0;
+    for (int i = 0; i < 100; i++) {
+        step(1);
+    }
+    EXPECT_EQ(writes, 0);
+
+    // Only the keys warmed up by a key press need to be drawn
+    press(0, 0);
+    step(1);
+    uint32_t warm = 0;
+    for (uint8_t i = 0; i < DRIVER_LED_TOTAL; i++) {
+        warm += reference.heat[i] > 0;
+    }
+    EXPECT_EQ(writes, warm);
+    expect_matches_reference();
+}
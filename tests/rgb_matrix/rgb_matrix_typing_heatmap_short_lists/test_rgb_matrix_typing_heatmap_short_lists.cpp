@@ -0,0 +1,5 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// The same tests, with neighbour lists that only fit some of the keys
+#include "../rgb_matrix_typing_heatmap/test_rgb_matrix_typing_heatmap.cpp"
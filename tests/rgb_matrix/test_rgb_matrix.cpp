@@ -0,0 +1,172 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "eeconfig.h"
+
+void advance_time(uint32_t ms);
+}
+
+namespace {
+RGB      leds[DRIVER_LED_TOTAL];
+uint32_t frames;
+
+void driver_init(void) {}
+
+void driver_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    leds[index].r = r;
+    leds[index].g = g;
+    leds[index].b = b;
+}
+
+void driver_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (int i = 0; i < DRIVER_LED_TOTAL; i++) {
+        driver_set_color(i, r, g, b);
+    }
+}
+
+void driver_flush(void) {
+    ++frames;
+}
+
+struct effect_t {
+    uint8_t     mode;
+    const char *name;
+};
+
+// clang-format off
+const effect_t effects[] = {
+#define RGB_MATRIX_EFFECT(name, ...) {RGB_MATRIX_##name, #name},
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+};
+// clang-format on
+} // namespace
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = driver_init,
+    .set_color     = driver_set_color,
+    .set_color_all = driver_set_color_all,
+    .flush         = driver_flush,
+};
+
+// One LED per key, spread over the usual 224x64 area, with the outer columns as modifiers
+led_config_t g_led_config = [] {
+    led_config_t config;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint8_t i                  = row * MATRIX_COLS + col;
+            config.matrix_co[row][col] = i;
+            config.point[i]            = {.x = (uint8_t)(col * 224 / (MATRIX_COLS - 1)), .y = (uint8_t)(row * 64 / (MATRIX_ROWS - 1))};
+            config.flags[i]            = (col == 0 || col == MATRIX_COLS - 1) ? LED_FLAG_MODIFIER : LED_FLAG_KEYLIGHT;
+        }
+    }
+    return config;
+}();
+}
+
+class RgbMatrix : public testing::Test {
+   protected:
+    static void SetUpTestSuite() {
+        eeconfig_init();
+        rgb_matrix_init();
+    }
+
+    void SetUp() override {
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(HSV_RED);
+        rgb_matrix_set_speed_noeeprom(UINT8_MAX / 2);
+    }
+
+    // Runs the task until the next frame has been flushed
+    void render_frame() {
+        uint32_t start = frames;
+        advance_time(1);
+        while (frames == start) {
+            rgb_matrix_task();
+        }
+    }
+};
+
+TEST_F(RgbMatrix, BatchConversionMatchesHsvToRgb) {
+    HSV hsv[256];
+    RGB batch[256];
+    for (uint16_t h = 0; h < 256; h++) {
+        for (uint16_t s = 0; s < 256; s++) {
+            for (uint16_t v = 0; v < 256; v++) {
+                hsv[v] = {.h = (uint8_t)h, .s = (uint8_t)s, .v = (uint8_t)v};
+            }
+            // An odd count, so the batch isn't always a nice round size
+            hsv_to_rgb_batch(hsv, batch, 255);
+            hsv_to_rgb_batch(&hsv[255], &batch[255], 1);
+            for (uint16_t v = 0; v < 256; v++) {
+                RGB expected = hsv_to_rgb(hsv[v]);
+                ASSERT_EQ(batch[v].r, expected.r) << "h=" << h << " s=" << s << " v=" << v;
+                ASSERT_EQ(batch[v].g, expected.g) << "h=" << h << " s=" << s << " v=" << v;
+                ASSERT_EQ(batch[v].b, expected.b) << "h=" << h << " s=" << s << " v=" << v;
+            }
+        }
+    }
+}
+
+TEST_F(RgbMatrix, BatchConversionThroughput) {
+    using clock = std::chrono::steady_clock;
+
+    HSV      hsv[RGB_MATRIX_BATCH_SIZE];
+    RGB      rgb[RGB_MATRIX_BATCH_SIZE];
+    uint32_t checksum = 0;
+
+    auto start = clock::now();
+    for (uint32_t n = 0; n < (1 << 24); n += RGB_MATRIX_BATCH_SIZE) {
+        for (uint8_t i = 0; i < RGB_MATRIX_BATCH_SIZE; i++) {
+            uint32_t x = n + i;
+            hsv[i]     = {.h = (uint8_t)(x >> 16), .s = (uint8_t)(x >> 8), .v = (uint8_t)x};
+            rgb[i]     = hsv_to_rgb(hsv[i]);
+        }
+        checksum += rgb[0].r + rgb[RGB_MATRIX_BATCH_SIZE - 1].b;
+    }
+    auto single = clock::now() - start;
+
+    start = clock::now();
+    for (uint32_t n = 0; n < (1 << 24); n += RGB_MATRIX_BATCH_SIZE) {
+        for (uint8_t i = 0; i < RGB_MATRIX_BATCH_SIZE; i++) {
+            uint32_t x = n + i;
+            hsv[i]     = {.h = (uint8_t)(x >> 16), .s = (uint8_t)(x >> 8), .v = (uint8_t)x};
+        }
+        hsv_to_rgb_batch(hsv, rgb, RGB_MATRIX_BATCH_SIZE);
+        checksum -= rgb[0].r + rgb[RGB_MATRIX_BATCH_SIZE - 1].b;
+    }
+    auto batched = clock::now() - start;
+
+    EXPECT_EQ(checksum, 0);
+    printf("hsv_to_rgb: %lld ms, hsv_to_rgb_batch: %lld ms, for every HSV value\n", (long long)std::chrono::duration_cast<std::chrono::milliseconds>(single).count(), (long long)std::chrono::duration_cast<std::chrono::milliseconds>(batched).count());
+}
+
+TEST_F(RgbMatrix, LedsRenderedPerMillisecond) {
+    using clock = std::chrono::steady_clock;
+
+    for (const effect_t &effect : effects) {
+        rgb_matrix_mode_noeeprom(effect.mode);
+        // Let any effect initialisation happen outside of the timing
+        render_frame();
+        render_frame();
+
+        uint32_t rendered = 0;
+        auto     start    = clock::now();
+        for (uint16_t frame = 0; frame < 2000; frame++) {
+            // Keep some keys lit up for the reactive effects
+            if (frame % 50 == 0) {
+                process_rgb_matrix(frame / 50 % MATRIX_ROWS, frame / 50 % MATRIX_COLS, true);
+            }
+            render_frame();
+            rendered += DRIVER_LED_TOTAL;
+        }
+        double elapsed_ms = std::chrono::duration<double, std::milli>(clock::now() - start).count();
+        printf("%-32s %10.0f LEDs/ms\n", effect.name, rendered / elapsed_ms);
+    }
+}
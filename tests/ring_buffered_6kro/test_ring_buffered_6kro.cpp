@@ -0,0 +1,78 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+class RingBuffered6KRO : public TestFixture {};
+
+TEST_F(RingBuffered6KRO, OldestKeyMakesWayAndStaysOut) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_a = KeymapKey(0, 0, 0, KC_A);
+    auto       key_b = KeymapKey(0, 1, 0, KC_B);
+    auto       key_c = KeymapKey(0, 2, 0, KC_C);
+    auto       key_d = KeymapKey(0, 3, 0, KC_D);
+    auto       key_e = KeymapKey(0, 4, 0, KC_E);
+    auto       key_f = KeymapKey(0, 5, 0, KC_F);
+    auto       key_g = KeymapKey(0, 6, 0, KC_G);
+    auto       key_h = KeymapKey(0, 7, 0, KC_H);
+
+    set_keymap({key_a, key_b, key_c, key_d, key_e, key_f, key_g, key_h});
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C, KC_D, KC_E, KC_F));
+    for (auto key : {key_a, key_b, key_c, key_d, key_e, key_f}) {
+        key.press();
+        run_one_scan_loop();
+    }
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // The seventh and eighth keys push out the oldest ones
+    EXPECT_REPORT(driver, (KC_B, KC_C, KC_D, KC_E, KC_F, KC_G));
+    key_g.press();
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_C, KC_D, KC_E, KC_F, KC_G, KC_H));
+    key_h.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Further sends while the keys are held don't bring the pushed-out keys back
+    EXPECT_NO_REPORT(driver);
+    for (int i = 0; i < 5; ++i) {
+        send_keyboard_report();
+        run_one_scan_loop();
+    }
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Nor does a free slot
+    EXPECT_REPORT(driver, (KC_D, KC_E, KC_F, KC_G, KC_H));
+    key_c.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    // Releasing a pushed-out key changes nothing, and once released, it can be pressed again
+    EXPECT_NO_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_D, KC_E, KC_F, KC_G, KC_H, KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    for (auto key : {key_a, key_b, key_d, key_e, key_f, key_g, key_h}) {
+        key.release();
+        run_one_scan_loop();
+    }
+    testing::Mock::VerifyAndClearExpectations(&driver);
+}
@@ -0,0 +1,160 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "send_string.h"
+#include "eeprom.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsync : public TestFixture {
+   public:
+    void SetUp() override {
+        send_string_async_clear();
+    }
+};
+
+TEST_F(SendStringAsync, OneReportPerScan) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(send_string_async("aB"));
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_LSFT, KC_B));
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_FALSE(send_string_async_busy());
+}
+
+TEST_F(SendStringAsync, KeysAreScannedBetweenCharacters) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_x = KeymapKey{0, 0, 0, KC_X};
+
+    set_keymap({key_x});
+
+    EXPECT_TRUE(send_string_async("ab"));
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+
+    /* The key press waits for the queued character to be released */
+    key_x.press();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+
+    /* Then it is processed before the next queued report */
+    EXPECT_REPORT(driver, (KC_X));
+    EXPECT_REPORT(driver, (KC_B, KC_X));
+    run_one_scan_loop();
+
+    /* Likewise for the release */
+    key_x.release();
+    EXPECT_REPORT(driver, (KC_X));
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    EXPECT_FALSE(send_string_async_busy());
+}
+
+TEST_F(SendStringAsync, QueuedShiftDoesNotApplyToKeys) {
+    TestDriver driver;
+    InSequence s;
+    auto       key_x = KeymapKey{0, 0, 0, KC_X};
+
+    set_keymap({key_x});
+
+    EXPECT_TRUE(send_string_async("A"));
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+
+    key_x.press();
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_LSFT));
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+
+    EXPECT_REPORT(driver, (KC_X));
+    run_one_scan_loop();
+
+    key_x.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+}
+
+TEST_F(SendStringAsync, DelayDoesNotBlock) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_TRUE(SEND_STRING_ASYNC(SS_TAP(X_LEFT) SS_DELAY(10) "c"));
+
+    EXPECT_REPORT(driver, (KC_LEFT));
+    run_one_scan_loop();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(9);
+    testing::Mock::VerifyAndClearExpectations(&driver);
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(3);
+    EXPECT_FALSE(send_string_async_busy());
+}
+
+TEST_F(SendStringAsync, QueueFull) {
+    TestDriver driver;
+
+    EXPECT_TRUE(send_string_async("abcdefghijklm"));
+    EXPECT_FALSE(send_string_async("n"));
+
+    EXPECT_ANY_REPORT(driver).Times(26);
+    idle_for(26);
+    EXPECT_FALSE(send_string_async_busy());
+}
+
+TEST_F(SendStringAsync, DynamicKeymapMacroEscapeCodes) {
+    TestDriver driver;
+    InSequence s;
+
+    const uint8_t macro[] = {'a', SS_TAP_CODE, KC_LEFT, SS_DOWN_CODE, KC_LSFT, 'b', SS_UP_CODE, KC_LSFT, 0};
+    uint8_t      *address = (uint8_t *)400;
+    for (uint8_t i = 0; i < sizeof(macro); i++) {
+        eeprom_update_byte(address + i, macro[i]);
+    }
+
+    EXPECT_TRUE(send_string_async_eeprom_macro(address, 0));
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    idle_for(8);
+    EXPECT_FALSE(send_string_async_busy());
+}
@@ -24,8 +24,6 @@ std::vector<uint8_t> get_keys(const report_keyboard_t& report) {
     std::vector<uint8_t> result;
 #if defined(NKRO_ENABLE)
 #    error NKRO support not implemented yet
-#elif defined(RING_BUFFERED_6KRO_REPORT_ENABLE)
-#    error 6KRO support not implemented yet
 #else
     for (size_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
         if (report.keys[i]) {
@@ -67,7 +65,17 @@ KeyboardReportMatcher::KeyboardReportMatcher(const std::vector<uint8_t>& keys) {
         if (IS_MOD(k)) {
             m_report.mods |= MOD_BIT(k);
         } else {
+#ifdef RING_BUFFERED_6KRO_REPORT_ENABLE
+            // The ring buffer keeps its position across reports, so the expected keys are filled in directly
+            for (size_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+                if (m_report.keys[i] == KC_NO) {
+                    m_report.keys[i] = k;
+                    break;
+                }
+            }
+#else
             add_key_to_report(&m_report, k);
+#endif
         }
     }
 }
@@ -62,9 +62,16 @@ void    send_system(uint16_t data);
 void    send_consumer(uint16_t data);
 void    send_programmable_button(uint32_t data);
 void    send_digitizer(report_digitizer_t *report);
+#if defined(NKRO_ENABLE) && defined(NKRO_SEGMENT_COUNT)
+void send_nkro_segment(report_keyboard_t *report, uint8_t segment);
+#endif
 
 /* host struct */
-host_driver_t chibios_driver = {keyboard_leds, send_keyboard, send_mouse, send_system, send_consumer, send_programmable_button};
+host_driver_t chibios_driver = {keyboard_leds, send_keyboard, send_mouse, send_system, send_consumer, send_programmable_button,
+#if defined(NKRO_ENABLE) && defined(NKRO_SEGMENT_COUNT)
+                                send_nkro_segment
+#endif
+};
 
 #ifdef VIRTSER_ENABLE
 void virtser_task(void);
@@ -886,6 +886,35 @@ unlock:
     osalSysUnlock();
 }
 
+#if defined(NKRO_ENABLE) && defined(NKRO_SEGMENT_COUNT)
+/* send one segment of an NKRO report, see NKRO_SEGMENT_COUNT
+ * not callable from ISR or locked state */
+void send_nkro_segment(report_keyboard_t *report, uint8_t segment) {
+    /* stays in use until the transfer completes, which is waited for before it's reused */
+    static uint8_t segment_buffer[NKRO_SEGMENT_MAX_SIZE];
+
+    osalSysLock();
+    if (usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
+        goto unlock;
+    }
+
+    if (usbGetTransmitStatusI(&USB_DRIVER, SHARED_IN_EPNUM)) {
+        osalThreadSuspendS(&(&USB_DRIVER)->epc[SHARED_IN_EPNUM]->in_state->thread);
+
+        /* after osalThreadSuspendS returns USB status might have changed */
+        if (usbGetDriverStateI(&USB_DRIVER) != USB_ACTIVE) {
+            goto unlock;
+        }
+    }
+    uint8_t size = nkro_segment_pack(report, segment, segment_buffer);
+    usbStartTransmitI(&USB_DRIVER, SHARED_IN_EPNUM, segment_buffer, size);
+    keyboard_report_sent = *report;
+
+unlock:
+    osalSysUnlock();
+}
+#endif
+
 /* ---------------------------------------------------------
  *                     Mouse functions
  * ---------------------------------------------------------
@@ -16,6 +16,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 */
 
 #include <stdint.h>
+#include <string.h>
 //#include <avr/interrupt.h>
 #include "keyboard.h"
 #include "keycode.h"
@@ -33,6 +34,15 @@ static host_driver_t *driver;
 static uint16_t       last_system_report              = 0;
 static uint16_t       last_consumer_report            = 0;
 static uint32_t       last_programmable_button_report = 0;
+static uint32_t       suppressed_report_count         = 0;
+#ifndef PROTOCOL_VUSB
+static report_keyboard_t last_keyboard_report;
+#endif
+#if defined(NKRO_ENABLE) && defined(NKRO_SEGMENT_COUNT)
+/* What the host last received in each segment, which is only meaningful while segments are being sent. */
+static report_keyboard_t last_nkro_report;
+static bool              nkro_segments_sent = false;
+#endif
 
 void host_set_driver(host_driver_t *d) {
     driver = d;
@@ -78,7 +88,31 @@ void host_keyboard_send(report_keyboard_t *report) {
         report->report_id = REPORT_ID_KEYBOARD;
 #endif
     }
+#ifndef PROTOCOL_VUSB
+    /* Only send the report if there are changes to propagate to the host. */
+    if (memcmp(report, &last_keyboard_report, sizeof(report_keyboard_t)) == 0) {
+        suppressed_report_count++;
+        return;
+    }
+    memcpy(&last_keyboard_report, report, sizeof(report_keyboard_t));
+#endif
+#if defined(NKRO_ENABLE) && defined(NKRO_SEGMENT_COUNT)
+    if (keyboard_protocol && keymap_config.nkro && driver->send_nkro_segment) {
+        uint8_t changed = nkro_segments_sent ? nkro_segments_changed(report, &last_nkro_report) : (1 << NKRO_SEGMENT_COUNT) - 1;
+        for (uint8_t segment = 0; segment < NKRO_SEGMENT_COUNT; segment++) {
+            if (changed & (1 << segment)) {
+                (*driver->send_nkro_segment)(report, segment);
+            }
+        }
+        memcpy(&last_nkro_report, report, sizeof(report_keyboard_t));
+        nkro_segments_sent = true;
+    } else {
+        nkro_segments_sent = false;
+        (*driver->send_keyboard)(report);
+    }
+#else
     (*driver->send_keyboard)(report);
+#endif
 
     if (debug_keyboard) {
         dprint("keyboard_report: ");
@@ -103,7 +137,10 @@ void host_mouse_send(report_mouse_t *report) {
 }
 
 void host_system_send(uint16_t report) {
-    if (report == last_system_report) return;
+    if (report == last_system_report) {
+        suppressed_report_count++;
+        return;
+    }
     last_system_report = report;
 
     if (!driver) return;
@@ -111,7 +148,10 @@ void host_system_send(uint16_t report) {
 }
 
 void host_consumer_send(uint16_t report) {
-    if (report == last_consumer_report) return;
+    if (report == last_consumer_report) {
+        suppressed_report_count++;
+        return;
+    }
     last_consumer_report = report;
 
     if (!driver) return;
@@ -137,7 +177,10 @@ void host_digitizer_send(digitizer_t *digitizer) {
 __attribute__((weak)) void send_digitizer(report_digitizer_t *report) {}
 
 void host_programmable_button_send(uint32_t report) {
-    if (report == last_programmable_button_report) return;
+    if (report == last_programmable_button_report) {
+        suppressed_report_count++;
+        return;
+    }
     last_programmable_button_report = report;
 
     if (!driver) return;
@@ -155,3 +198,7 @@ uint16_t host_last_consumer_report(void) {
 uint32_t host_last_programmable_button_report(void) {
     return last_programmable_button_report;
 }
+
+uint32_t host_suppressed_report_count(void) {
+    return suppressed_report_count;
+}
@@ -53,6 +53,9 @@ uint16_t host_last_system_report(void);
 uint16_t host_last_consumer_report(void);
 uint32_t host_last_programmable_button_report(void);
 
+/* number of keyboard, system, consumer and programmable button reports not sent because they were unchanged */
+uint32_t host_suppressed_report_count(void);
+
 #ifdef __cplusplus
 }
 #endif
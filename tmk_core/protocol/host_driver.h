@@ -30,6 +30,9 @@ typedef struct {
     void (*send_system)(uint16_t);
     void (*send_consumer)(uint16_t);
     void (*send_programmable_button)(uint32_t);
+#if defined(NKRO_ENABLE) && defined(NKRO_SEGMENT_COUNT)
+    void (*send_nkro_segment)(report_keyboard_t *, uint8_t);
+#endif
 } host_driver_t;
 
 void send_digitizer(report_digitizer_t *report);
\ No newline at end of file
@@ -104,7 +104,14 @@ static void    send_mouse(report_mouse_t *report);
 static void    send_system(uint16_t data);
 static void    send_consumer(uint16_t data);
 static void    send_programmable_button(uint32_t data);
-host_driver_t  lufa_driver = {keyboard_leds, send_keyboard, send_mouse, send_system, send_consumer, send_programmable_button};
+#if defined(NKRO_ENABLE) && defined(NKRO_SEGMENT_COUNT)
+static void send_nkro_segment(report_keyboard_t *report, uint8_t segment);
+#endif
+host_driver_t lufa_driver = {keyboard_leds, send_keyboard, send_mouse, send_system, send_consumer, send_programmable_button,
+#if defined(NKRO_ENABLE) && defined(NKRO_SEGMENT_COUNT)
+                             send_nkro_segment
+#endif
+};
 
 #ifdef VIRTSER_ENABLE
 // clang-format off
@@ -688,6 +695,29 @@ static void send_keyboard(report_keyboard_t *report) {
     keyboard_report_sent = *report;
 }
 
+#if defined(NKRO_ENABLE) && defined(NKRO_SEGMENT_COUNT)
+/** \brief Send NKRO Segment
+ *
+ * Sends one segment of an NKRO report, see NKRO_SEGMENT_COUNT.
+ */
+static void send_nkro_segment(report_keyboard_t *report, uint8_t segment) {
+    uint8_t timeout = 255;
+    uint8_t buffer[NKRO_SEGMENT_MAX_SIZE];
+    uint8_t size = nkro_segment_pack(report, segment, buffer);
+
+    Endpoint_SelectEndpoint(SHARED_IN_EPNUM);
+    /* Check if write ready for a polling interval around 10ms */
+    while (timeout-- && !Endpoint_IsReadWriteAllowed())
+        _delay_us(40);
+    if (!Endpoint_IsReadWriteAllowed()) return;
+
+    Endpoint_Write_Stream_LE(buffer, size, NULL);
+    Endpoint_ClearIN();
+
+    keyboard_report_sent = *report;
+}
+#endif
+
 /** \brief Send Mouse
  *
  * FIXME: Needs doc
@@ -236,6 +236,45 @@ void del_key_bit(report_keyboard_t* keyboard_report, uint8_t code) {
 }
 #endif
 
+#ifdef NKRO_SEGMENT_COUNT
+_Static_assert(NKRO_SEGMENT_COUNT >= 2 && NKRO_SEGMENT_COUNT <= 8, "NKRO_SEGMENT_COUNT must be between 2 and 8");
+_Static_assert((NKRO_SEGMENT_COUNT - 1) * NKRO_SEGMENT_BITS < KEYBOARD_REPORT_BITS, "NKRO_SEGMENT_COUNT leaves the last segment empty");
+
+/** \brief Returns a bitmask of the NKRO segments which differ between two reports
+ */
+uint8_t nkro_segments_changed(const report_keyboard_t* report, const report_keyboard_t* last_report) {
+    uint8_t changed = 0;
+    for (uint8_t segment = 0; segment < NKRO_SEGMENT_COUNT; segment++) {
+        uint8_t start = segment * NKRO_SEGMENT_BITS;
+        if (memcmp(&report->nkro.bits[start], &last_report->nkro.bits[start], NKRO_SEGMENT_END(segment) - start) != 0) {
+            changed |= 1 << segment;
+        }
+    }
+    if (report->nkro.mods != last_report->nkro.mods) {
+        changed |= 1;
+    }
+    return changed;
+}
+
+/** \brief Packs one NKRO segment, as it goes on the wire, into buffer
+ *
+ * The buffer needs to hold NKRO_SEGMENT_MAX_SIZE bytes. Returns the length of the packed segment.
+ */
+uint8_t nkro_segment_pack(const report_keyboard_t* report, uint8_t segment, uint8_t* buffer) {
+    uint8_t start  = segment * NKRO_SEGMENT_BITS;
+    uint8_t length = NKRO_SEGMENT_END(segment) - start;
+    if (segment == 0) {
+        buffer[0] = REPORT_ID_NKRO;
+        buffer[1] = report->nkro.mods;
+        memcpy(&buffer[2], &report->nkro.bits[start], length);
+        return 2 + length;
+    }
+    buffer[0] = REPORT_ID_NKRO_SEGMENT + segment - 1;
+    memcpy(&buffer[1], &report->nkro.bits[start], length);
+    return 1 + length;
+}
+#endif
+
 /** \brief add key to report
  *
  * FIXME: Needs doc
@@ -279,6 +318,126 @@ void clear_keys_from_report(report_keyboard_t* keyboard_report) {
     memset(keyboard_report->keys, 0, sizeof(keyboard_report->keys));
 }
 
+/** \brief Adds a key to the pressed-key bitmap
+ */
+void key_bitmap_add(report_key_bitmap_t* bitmap, uint8_t key) {
+    uint8_t mask = 1 << (key & 7);
+    if (key != KC_NO && !(bitmap->bits.bytes[key >> 3] & mask)) {
+        bitmap->bits.bytes[key >> 3] |= mask;
+        bitmap->count++;
+    }
+}
+
+/** \brief Removes a key from the pressed-key bitmap
+ */
+void key_bitmap_del(report_key_bitmap_t* bitmap, uint8_t key) {
+    uint8_t mask = 1 << (key & 7);
+    if (bitmap->bits.bytes[key >> 3] & mask) {
+        bitmap->bits.bytes[key >> 3] &= ~mask;
+        bitmap->count--;
+    }
+}
+
+/** \brief Checks whether a key is in the pressed-key bitmap
+ */
+bool key_bitmap_is_set(const report_key_bitmap_t* bitmap, uint8_t key) {
+    return bitmap->bits.bytes[key >> 3] & (1 << (key & 7));
+}
+
+/** \brief Removes every key from the pressed-key bitmap
+ */
+void key_bitmap_clear(report_key_bitmap_t* bitmap) {
+    memset(bitmap, 0, sizeof(report_key_bitmap_t));
+}
+
+/** \brief Returns the lowest keycode in the pressed-key bitmap, or KC_NO if it is empty
+ */
+uint8_t key_bitmap_first(const report_key_bitmap_t* bitmap) {
+    if (!bitmap->count) {
+        return KC_NO;
+    }
+    uint8_t i = 0;
+    while (!bitmap->bits.words[i]) {
+        i++;
+    }
+    // The words only speed up the search, bytes are used from here on so as not to depend on endianness
+    const uint8_t* p = &bitmap->bits.bytes[i * sizeof(uint32_t)];
+    for (i *= sizeof(uint32_t); !*p; i++, p++)
+        ;
+    return i << 3 | biton(*p);
+}
+
+/** \brief Fills in the keys of a keyboard report from the pressed-key bitmap
+ *
+ * In NKRO mode the bitmap is copied across as it is. In 6KRO mode, keys which are already in the report keep their
+ * place, and newly pressed keys are added in the free slots, lowest keycode first. Keys which don't fit are left out
+ * until a slot frees up, unless RING_BUFFERED_6KRO_REPORT_ENABLE is defined, in which case the keys which have been in
+ * the report the longest make way for them, and are left out until they are released.
+ */
+void key_bitmap_to_report(const report_key_bitmap_t* bitmap, report_keyboard_t* keyboard_report) {
+#ifdef NKRO_ENABLE
+    if (keyboard_protocol && keymap_config.nkro) {
+        memcpy(keyboard_report->nkro.bits, bitmap->bits.bytes, KEYBOARD_REPORT_BITS);
+        return;
+    }
+#endif
+    report_key_bitmap_t remaining;
+    memcpy(&remaining, bitmap, sizeof(remaining));
+
+#ifdef RING_BUFFERED_6KRO_REPORT_ENABLE
+    // Keys pushed out of the report stay out until they are released, rather than pushing out another key in turn
+    static report_key_bitmap_t dropped = {};
+    report_key_bitmap_t        still_dropped;
+    key_bitmap_clear(&still_dropped);
+    while (dropped.count) {
+        uint8_t key = key_bitmap_first(&dropped);
+        key_bitmap_del(&dropped, key);
+        if (key_bitmap_is_set(&remaining, key)) {
+            key_bitmap_del(&remaining, key);
+            key_bitmap_add(&still_dropped, key);
+        }
+    }
+    memcpy(&dropped, &still_dropped, sizeof(dropped));
+
+    // The report is kept in the order the keys were added, oldest first
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t key = keyboard_report->keys[i];
+        if (key != KC_NO && key_bitmap_is_set(&remaining, key)) {
+            keyboard_report->keys[count++] = key;
+            key_bitmap_del(&remaining, key);
+        }
+    }
+    while (remaining.count) {
+        uint8_t key = key_bitmap_first(&remaining);
+        key_bitmap_del(&remaining, key);
+        if (count == KEYBOARD_REPORT_KEYS) {
+            key_bitmap_add(&dropped, keyboard_report->keys[0]);
+            memmove(&keyboard_report->keys[0], &keyboard_report->keys[1], KEYBOARD_REPORT_KEYS - 1);
+            count--;
+        }
+        keyboard_report->keys[count++] = key;
+    }
+    memset(&keyboard_report->keys[count], 0, KEYBOARD_REPORT_KEYS - count);
+#else
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+        uint8_t key = keyboard_report->keys[i];
+        if (key != KC_NO && key_bitmap_is_set(&remaining, key)) {
+            key_bitmap_del(&remaining, key);
+        } else {
+            keyboard_report->keys[i] = KC_NO;
+        }
+    }
+    for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS && remaining.count; i++) {
+        if (keyboard_report->keys[i] == KC_NO) {
+            uint8_t key = key_bitmap_first(&remaining);
+            key_bitmap_del(&remaining, key);
+            keyboard_report->keys[i] = key;
+        }
+    }
+#endif
+}
+
 #ifdef MOUSE_ENABLE
 /**
  * @brief Compares 2 mouse reports for difference and returns result
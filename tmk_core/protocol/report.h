@@ -32,7 +32,8 @@ enum hid_report_ids {
     REPORT_ID_PROGRAMMABLE_BUTTON,
     REPORT_ID_NKRO,
     REPORT_ID_JOYSTICK,
-    REPORT_ID_DIGITIZER
+    REPORT_ID_DIGITIZER,
+    REPORT_ID_NKRO_SEGMENT // first of the IDs for the NKRO segments after the first, see NKRO_SEGMENT_COUNT
 };
 
 /* Mouse buttons */
@@ -138,6 +139,18 @@ enum desktop_usages {
 #    endif
 #endif
 
+/* NKRO bitfield split across several reports, so that only the part which changed needs to be sent.
+ * The first segment goes out under REPORT_ID_NKRO along with the mods, the others under consecutive IDs from
+ * REPORT_ID_NKRO_SEGMENT. NKRO_SEGMENT_BITS is the number of bytes of the bitfield in each, apart from the last. */
+#if defined(NKRO_ENABLE) && defined(NKRO_SEGMENT_COUNT)
+#    ifndef NKRO_SHARED_EP
+#        error "NKRO_SEGMENT_COUNT requires NKRO reports on the shared endpoint"
+#    endif
+#    define NKRO_SEGMENT_BITS ((KEYBOARD_REPORT_BITS + NKRO_SEGMENT_COUNT - 1) / NKRO_SEGMENT_COUNT)
+#    define NKRO_SEGMENT_END(segment) (((segment) + 1) * NKRO_SEGMENT_BITS < KEYBOARD_REPORT_BITS ? ((segment) + 1) * NKRO_SEGMENT_BITS : KEYBOARD_REPORT_BITS)
+#    define NKRO_SEGMENT_MAX_SIZE (2 + NKRO_SEGMENT_BITS)
+#endif
+
 #ifdef KEYBOARD_SHARED_EP
 #    define KEYBOARD_REPORT_SIZE 9
 #else
@@ -326,10 +339,36 @@ void add_key_bit(report_keyboard_t* keyboard_report, uint8_t code);
 void del_key_bit(report_keyboard_t* keyboard_report, uint8_t code);
 #endif
 
+#if defined(NKRO_ENABLE) && defined(NKRO_SEGMENT_COUNT)
+uint8_t nkro_segments_changed(const report_keyboard_t* report, const report_keyboard_t* last_report);
+uint8_t nkro_segment_pack(const report_keyboard_t* report, uint8_t segment, uint8_t* buffer);
+#endif
+
 void add_key_to_report(report_keyboard_t* keyboard_report, uint8_t key);
 void del_key_from_report(report_keyboard_t* keyboard_report, uint8_t key);
 void clear_keys_from_report(report_keyboard_t* keyboard_report);
 
+/*
+ * Bitmap of the keycodes currently pressed, one bit per keycode.
+ *
+ * This is the source of truth for the keys in the keyboard report: adding, removing and looking up a key is a single
+ * bit operation, and the 6KRO key array or NKRO bitfield is only filled in from it when the report is sent.
+ */
+typedef struct {
+    union {
+        uint8_t  bytes[32];
+        uint32_t words[8];
+    } bits;
+    uint8_t count;
+} report_key_bitmap_t;
+
+void    key_bitmap_add(report_key_bitmap_t* bitmap, uint8_t key);
+void    key_bitmap_del(report_key_bitmap_t* bitmap, uint8_t key);
+bool    key_bitmap_is_set(const report_key_bitmap_t* bitmap, uint8_t key);
+void    key_bitmap_clear(report_key_bitmap_t* bitmap);
+uint8_t key_bitmap_first(const report_key_bitmap_t* bitmap);
+void    key_bitmap_to_report(const report_key_bitmap_t* bitmap, report_keyboard_t* keyboard_report);
+
 #ifdef MOUSE_ENABLE
 bool has_mouse_report_changed(report_mouse_t* new_report, report_mouse_t* old_report);
 #endif
@@ -0,0 +1,238 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <set>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "host.h"
+#include "report.h"
+#include "keycode.h"
+#include "keycode_config.h"
+
+uint8_t         keyboard_protocol = 1;
+keymap_config_t keymap_config;
+}
+
+/* Host-side view of the report stream.
+ *
+ * Each report ID is parsed into its own part of the key state, as the host's HID parser would, so the keys it sees
+ * held are only correct if every segment which changed was sent. Bytes on the wire are counted including report IDs.
+ */
+namespace {
+struct HostParser {
+    uint8_t mods;
+    uint8_t bits[KEYBOARD_REPORT_BITS];
+
+    uint32_t full_reports;
+    uint32_t segments;
+    uint32_t bytes;
+
+    void reset() {
+        mods = 0;
+        memset(bits, 0, sizeof(bits));
+        full_reports = 0;
+        segments     = 0;
+        bytes        = 0;
+    }
+
+    void parse_full(const report_keyboard_t *report) {
+        ASSERT_EQ(report->nkro.report_id, REPORT_ID_NKRO);
+        mods = report->nkro.mods;
+        memcpy(bits, report->nkro.bits, sizeof(bits));
+        ++full_reports;
+        bytes += sizeof(report_keyboard_t::nkro);
+    }
+
+    void parse_segment(const uint8_t *data, uint8_t length) {
+        uint8_t segment = data[0] == REPORT_ID_NKRO ? 0 : data[0] - REPORT_ID_NKRO_SEGMENT + 1;
+        ASSERT_LT(segment, NKRO_SEGMENT_COUNT) << "Unexpected report ID " << (int)data[0];
+
+        uint8_t start = segment * NKRO_SEGMENT_BITS;
+        if (segment == 0) {
+            ASSERT_EQ(length, 2 + NKRO_SEGMENT_BITS);
+            mods = data[1];
+            memcpy(&bits[start], &data[2], length - 2);
+        } else {
+            ASSERT_EQ(length, 1 + NKRO_SEGMENT_END(segment) - start);
+            memcpy(&bits[start], &data[1], length - 1);
+        }
+        ++segments;
+        bytes += length;
+    }
+
+    std::set<uint8_t> keys() const {
+        std::set<uint8_t> held;
+        for (int i = 0; i < KEYBOARD_REPORT_BITS * 8; ++i) {
+            if (bits[i / 8] & (1 << (i % 8))) {
+                held.insert(i);
+            }
+        }
+        return held;
+    }
+} host;
+
+uint8_t keyboard_leds(void) {
+    return 0;
+}
+
+void send_keyboard(report_keyboard_t *report) {
+    // Only NKRO reports are of interest here
+    if (keymap_config.nkro) {
+        host.parse_full(report);
+    }
+}
+
+void send_nkro_segment(report_keyboard_t *report, uint8_t segment) {
+    uint8_t buffer[NKRO_SEGMENT_MAX_SIZE];
+    uint8_t length = nkro_segment_pack(report, segment, buffer);
+    host.parse_segment(buffer, length);
+}
+
+void send_mouse(report_mouse_t *report) {}
+void send_system(uint16_t data) {}
+void send_consumer(uint16_t data) {}
+void send_programmable_button(uint32_t data) {}
+
+host_driver_t segmented_driver = {keyboard_leds, send_keyboard, send_mouse, send_system, send_consumer, send_programmable_button, send_nkro_segment};
+host_driver_t full_driver      = {keyboard_leds, send_keyboard, send_mouse, send_system, send_consumer, send_programmable_button, NULL};
+} // namespace
+
+class NkroSegments : public testing::Test {
+   protected:
+    report_keyboard_t report;
+    uint8_t           mods;
+
+    void SetUp() override {
+        keyboard_protocol  = 1;
+        keymap_config.nkro = 1;
+        memset(&report, 0, sizeof(report));
+        mods = 0;
+        host.reset();
+        host_set_driver(&segmented_driver);
+    }
+
+    void TearDown() override {
+        // Leave the host layer with an empty last report, and no segments sent, for the next test
+        host_set_driver(&full_driver);
+        memset(&report, 0, sizeof(report));
+        mods = 1;
+        send();
+        mods = 0;
+        send();
+    }
+
+    // Without a keyboard report ID, report.mods shares its byte with the NKRO report ID, so it's set on every send
+    void send() {
+        report.mods = mods;
+        host_keyboard_send(&report);
+    }
+
+    void expect_host_sees_report() {
+        std::set<uint8_t> expected;
+        for (int i = 0; i < KEYBOARD_REPORT_BITS * 8; ++i) {
+            if (report.nkro.bits[i / 8] & (1 << (i % 8))) {
+                expected.insert(i);
+            }
+        }
+        EXPECT_EQ(host.keys(), expected);
+        EXPECT_EQ(host.mods, mods);
+    }
+};
+
+TEST_F(NkroSegments, OnlyTheChangedSegmentIsSent) {
+    static_assert(KC_A / 8 < NKRO_SEGMENT_BITS && KC_F13 / 8 >= NKRO_SEGMENT_BITS, "Keys are expected to be in different segments");
+
+    // The first report has to bring every segment up to date
+    add_key_to_report(&report, KC_A);
+    send();
+    EXPECT_EQ(host.segments, NKRO_SEGMENT_COUNT);
+    expect_host_sees_report();
+
+    host.segments = 0;
+    add_key_to_report(&report, KC_F13);
+    send();
+    EXPECT_EQ(host.segments, 1);
+    expect_host_sees_report();
+
+    // Mods go in the first segment
+    host.segments = 0;
+    mods          = MOD_BIT(KC_LEFT_SHIFT);
+    send();
+    EXPECT_EQ(host.segments, 1);
+    expect_host_sees_report();
+
+    host.segments = 0;
+    del_key_from_report(&report, KC_A);
+    del_key_from_report(&report, KC_F13);
+    send();
+    EXPECT_EQ(host.segments, 2);
+    expect_host_sees_report();
+    EXPECT_EQ(host.full_reports, 0);
+}
+
+TEST_F(NkroSegments, FullReportsAreSentWithoutSegmentSupport) {
+    host_set_driver(&full_driver);
+    add_key_to_report(&report, KC_A);
+    send();
+    EXPECT_EQ(host.full_reports, 1);
+    EXPECT_EQ(host.segments, 0);
+    expect_host_sees_report();
+}
+
+TEST_F(NkroSegments, AllSegmentsAreResentAfterLeavingNkro) {
+    add_key_to_report(&report, KC_A);
+    send();
+
+    // While NKRO is off the host doesn't see the segments at all, so they're stale by the time it comes back on
+    keymap_config.nkro = 0;
+    memset(&report, 0, sizeof(report));
+    add_key_to_report(&report, KC_B);
+    send();
+
+    keymap_config.nkro = 1;
+    memset(&report, 0, sizeof(report));
+    add_key_to_report(&report, KC_F13);
+    host.segments = 0;
+    send();
+    EXPECT_EQ(host.segments, NKRO_SEGMENT_COUNT);
+    expect_host_sees_report();
+}
+
+TEST_F(NkroSegments, RandomTypingIsReconstructed) {
+    uint32_t rng     = 1;
+    auto     random  = [&rng]() {
+        // xorshift32
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    };
+    uint32_t changes = 0;
+
+    for (int i = 0; i < 10000; ++i) {
+        uint32_t choice = random();
+        if (choice % 8 == 0) {
+            mods ^= 1 << (choice / 8 % 8);
+        } else {
+            uint8_t key = KC_A + choice / 8 % (KC_EXSEL - KC_A + 1);
+            if (report.nkro.bits[key / 8] & (1 << (key % 8))) {
+                del_key_from_report(&report, key);
+            } else {
+                add_key_to_report(&report, key);
+            }
+        }
+        send();
+        ++changes;
+        expect_host_sees_report();
+        if (HasFailure()) {
+            FAIL() << "Host lost track of the keys after " << i + 1 << " changes";
+        }
+    }
+
+    EXPECT_EQ(host.full_reports, 0);
+    EXPECT_EQ(host.segments, changes + NKRO_SEGMENT_COUNT - 1);
+    uint32_t full_bytes = changes * sizeof(report_keyboard_t::nkro);
+    printf("%u changes: %u bytes as %d segments, %u bytes as full reports\n", changes, host.bytes, NKRO_SEGMENT_COUNT, full_bytes);
+    EXPECT_LT(host.bytes * 2, full_bytes);
+}
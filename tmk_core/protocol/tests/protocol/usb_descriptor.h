@@ -0,0 +1,8 @@
+// Copyright 2022 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* Stands in for the USB descriptor header, which needs the LUFA headers, so that report.h can be built with the
+ * shared endpoint layout used by the USB protocols. */
+#define SHARED_EPSIZE 32
@@ -0,0 +1,10 @@
+nkro_segments_DEFS := -DNO_DEBUG -DMATRIX_ROWS=1 -DMATRIX_COLS=1 -DPROTOCOL_LUFA -DNKRO_ENABLE -DNKRO_SEGMENT_COUNT=3
+nkro_segments_INC := \
+	$(TMK_PATH)/protocol/tests \
+	$(TMK_PATH)/protocol
+
+nkro_segments_SRC := \
+	$(QUANTUM_PATH)/bitwise.c \
+	$(TMK_PATH)/protocol/host.c \
+	$(TMK_PATH)/protocol/report.c \
+	$(TMK_PATH)/protocol/tests/nkro_segments_tests.cpp
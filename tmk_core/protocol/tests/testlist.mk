@@ -0,0 +1 @@
+TEST_LIST += nkro_segments
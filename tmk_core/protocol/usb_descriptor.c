@@ -289,10 +289,18 @@ const USB_Descriptor_HIDReport_Datatype_t PROGMEM SharedReport[] = {
         // Keycodes
         HID_RI_USAGE_PAGE(8, 0x07),    // Keyboard/Keypad
         HID_RI_USAGE_MINIMUM(8, 0x00),
+#    ifdef NKRO_SEGMENT_COUNT
+        HID_RI_USAGE_MAXIMUM(8, NKRO_SEGMENT_BITS * 8 - 1),
+#    else
         HID_RI_USAGE_MAXIMUM(8, KEYBOARD_REPORT_BITS * 8 - 1),
+#    endif
         HID_RI_LOGICAL_MINIMUM(8, 0x00),
         HID_RI_LOGICAL_MAXIMUM(8, 0x01),
+#    ifdef NKRO_SEGMENT_COUNT
+        HID_RI_REPORT_COUNT(8, NKRO_SEGMENT_BITS * 8),
+#    else
         HID_RI_REPORT_COUNT(8, KEYBOARD_REPORT_BITS * 8),
+#    endif
         HID_RI_REPORT_SIZE(8, 0x01),
         HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE),
 
@@ -307,6 +315,38 @@ const USB_Descriptor_HIDReport_Datatype_t PROGMEM SharedReport[] = {
         HID_RI_REPORT_COUNT(8, 0x01),
         HID_RI_REPORT_SIZE(8, 0x03),
         HID_RI_OUTPUT(8, HID_IOF_CONSTANT),
+#    ifdef NKRO_SEGMENT_COUNT
+        // Keycodes in the remaining segments, one report ID each
+#        define NKRO_SEGMENT_REPORT(segment) \
+            HID_RI_REPORT_ID(8, REPORT_ID_NKRO_SEGMENT + (segment) - 1), \
+            HID_RI_USAGE_PAGE(8, 0x07), \
+            HID_RI_USAGE_MINIMUM(8, (segment) * NKRO_SEGMENT_BITS * 8), \
+            HID_RI_USAGE_MAXIMUM(8, NKRO_SEGMENT_END(segment) * 8 - 1), \
+            HID_RI_LOGICAL_MINIMUM(8, 0x00), \
+            HID_RI_LOGICAL_MAXIMUM(8, 0x01), \
+            HID_RI_REPORT_COUNT(8, (NKRO_SEGMENT_END(segment) - (segment) * NKRO_SEGMENT_BITS) * 8), \
+            HID_RI_REPORT_SIZE(8, 0x01), \
+            HID_RI_INPUT(8, HID_IOF_DATA | HID_IOF_VARIABLE | HID_IOF_ABSOLUTE)
+        NKRO_SEGMENT_REPORT(1),
+#        if NKRO_SEGMENT_COUNT > 2
+        NKRO_SEGMENT_REPORT(2),
+#        endif
+#        if NKRO_SEGMENT_COUNT > 3
+        NKRO_SEGMENT_REPORT(3),
+#        endif
+#        if NKRO_SEGMENT_COUNT > 4
+        NKRO_SEGMENT_REPORT(4),
+#        endif
+#        if NKRO_SEGMENT_COUNT > 5
+        NKRO_SEGMENT_REPORT(5),
+#        endif
+#        if NKRO_SEGMENT_COUNT > 6
+        NKRO_SEGMENT_REPORT(6),
+#        endif
+#        if NKRO_SEGMENT_COUNT > 7
+        NKRO_SEGMENT_REPORT(7),
+#        endif
+#    endif
     HID_RI_END_COLLECTION(0),
 #endif
 